@@ -143,6 +143,9 @@ namespace WPF_UI1.Models
         public double WearLeveling { get; set; }
         public ulong TotalBytesWritten { get; set; }
         public ulong TotalBytesRead { get; set; }
+        public double FailureRiskScore { get; set; } // 0-100
+        public double WearOutEtaDays { get; set; } = -1; // -1 ʾδ֪
+        public ulong DefectGrowth7d { get; set; }
         public List<char> LogicalDriveLetters { get; set; } = new();
         public List<SmartAttributeData> Attributes { get; set; } = new();
     }
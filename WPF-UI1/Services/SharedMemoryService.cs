@@ -149,6 +149,9 @@ namespace WPF_UI1.Services
             [MarshalAs(UnmanagedType.ByValArray, SizeConst = 8)] public byte[] logicalDriveLetters; // char[8]
             public int logicalDriveCount;
             public SYSTEMTIME lastScanTime;
+            public double failureRiskScore;
+            public double wearOutEtaDays;
+            public ulong defectGrowth7d;
         }
 
         [StructLayout(LayoutKind.Sequential)]
@@ -394,7 +397,10 @@ namespace WPF_UI1.Services
                             UncorrectableErrors = pd.uncorrectableErrors,
                             WearLeveling = pd.wearLeveling,
                             TotalBytesWritten = pd.totalBytesWritten,
-                            TotalBytesRead = pd.totalBytesRead
+                            TotalBytesRead = pd.totalBytesRead,
+                            FailureRiskScore = pd.failureRiskScore,
+                            WearOutEtaDays = pd.wearOutEtaDays,
+                            DefectGrowth7d = pd.defectGrowth7d
                         };
 
                         // ߼ĸ
@@ -54,6 +54,11 @@ struct PhysicalDiskSmartData {
     int logicalDriveCount;         // 关联驱动器数量
     
     SYSTEMTIME lastScanTime;       // 最后扫描时间
+
+    // SMART 趋势分析
+    double failureRiskScore;       // 故障风险评分（0-100，越高越危险）
+    double wearOutEtaDays;         // 按磨损速率预计寿命耗尽的剩余天数，-1 表示未知
+    uint64_t defectGrowth7d;       // 最近7天缺陷计数增量（重映射+待处理+不可纠正）
 };
 
 // GPU信息
@@ -65,6 +70,38 @@ struct GPUData {
     bool isVirtual;       // 新增：是否为虚拟显卡
 };
 
+// NVIDIA GPU 实时遥测（NVML）
+struct GpuTelemetryData {
+    wchar_t name[96];              // GPU名称
+    uint64_t memoryTotal;          // 显存总量（字节）
+    uint64_t memoryUsed;           // 已用显存（字节）
+    double powerWatts;             // 当前功耗（W）
+    double powerLimitWatts;        // 功耗上限（W），不支持为0
+    double pcieTxBytesPerSec;      // PCIe 发送吞吐（字节/秒）
+    double pcieRxBytesPerSec;      // PCIe 接收吞吐（字节/秒）
+    uint64_t throttleReasons;      // 降频原因位掩码：0x1 空闲 0x4 软件功耗墙 0x8 硬件降频 0x20 软件温度墙 0x40 硬件温度墙 0x80 电源制动
+    uint32_t gpuUtilization;       // GPU 利用率（%）
+    uint32_t memoryUtilization;    // 显存控制器利用率（%）
+    uint32_t graphicsClockMHz;     // 图形频率
+    uint32_t smClockMHz;           // SM 频率
+    uint32_t memoryClockMHz;       // 显存频率
+    uint32_t temperature;          // 温度（℃）
+    int32_t fanPercent;            // 风扇转速百分比，无风扇为 -1
+    bool valid;                    // 本周期查询成功
+};
+
+// GPU 进程占用（按显存、SM 利用率排序）
+struct GpuProcessData {
+    uint32_t pid;
+    uint32_t gpuIndex;             // 对应 gpuTelemetry 下标
+    uint64_t usedMemory;           // 已用显存（字节），WDDM 模式下驱动不提供，为0
+    uint32_t smUtilization;        // SM 利用率（%），下同为上次刷新以来的最高值
+    uint32_t memoryUtilization;    // 显存控制器利用率（%）
+    uint32_t encoderUtilization;   // 编码器利用率（%）
+    uint32_t decoderUtilization;   // 解码器利用率（%）
+    wchar_t name[64];              // 进程名
+};
+
 // 网络适配器信息
 struct NetworkAdapterData {
     wchar_t name[128];    // 适配器名称
@@ -74,6 +111,75 @@ struct NetworkAdapterData {
     uint64_t speed;       // 速度（bps）
 };
 
+// 网卡流量与错误计数（与 adapters 按下标一一对应）
+struct NetworkCounterData {
+    double rxBytesPerSec;          // 接收吞吐（字节/秒）
+    double txBytesPerSec;          // 发送吞吐（字节/秒）
+    double rxPacketsPerSec;        // 接收包速率
+    double txPacketsPerSec;        // 发送包速率
+    double rxErrorsPerSec;         // 接收错误速率
+    double txErrorsPerSec;         // 发送错误速率
+    double rxDropsPerSec;          // 接收丢弃速率
+    double txDropsPerSec;          // 发送丢弃速率
+    uint64_t rxBytesTotal;         // 累计接收字节
+    uint64_t txBytesTotal;         // 累计发送字节
+    uint64_t rxErrors;             // 累计接收错误
+    uint64_t txErrors;             // 累计发送错误
+    uint64_t rxDrops;              // 累计接收丢弃
+    uint64_t txDrops;              // 累计发送丢弃
+    double utilizationPercent;     // 链路利用率（%，按 speed 计算）
+    bool valid;                    // 找到对应接口的计数
+};
+
+// 网卡地址（单播地址/网关/DNS），多个网卡的条目共用一个地址池，按 adapterIndex 归属
+struct NetworkAddressData {
+    wchar_t address[48];           // 文本形式（IPv6 最长 45 字符）
+    uint8_t adapterIndex;          // 所属 adapters 下标
+    uint8_t kind;                  // 0=单播地址 1=网关 2=DNS服务器
+    uint8_t family;                // 4=IPv4 6=IPv6
+    uint8_t prefixLength;          // 前缀长度（仅单播地址）
+};
+
+// TCP/UDP 套接字与协议统计
+struct SocketStatsData {
+    uint32_t tcpStates[11];        // 依次为 ESTABLISHED SYN_SENT SYN_RECV FIN_WAIT1 FIN_WAIT2 TIME_WAIT CLOSE CLOSE_WAIT LAST_ACK LISTEN CLOSING
+    uint32_t tcpSockets;           // TCP 套接字总数
+    uint32_t udpSockets;           // UDP 套接字总数
+    uint32_t listenQueueFull;      // 接受队列已满的监听套接字数（仅 Linux）
+    double retransSegsPerSec;      // 重传段速率
+    double retransPercent;         // 重传段占发送段百分比
+    double listenOverflowsPerSec;  // 监听队列溢出速率（仅 Linux）
+    double listenDropsPerSec;      // 监听丢弃速率（仅 Linux）
+    double activeOpensPerSec;      // 主动建连速率
+    double passiveOpensPerSec;     // 被动建连速率
+    double attemptFailsPerSec;     // 建连失败速率
+    double estabResetsPerSec;      // 已建立连接被重置速率
+    double tcpInErrorsPerSec;      // TCP 接收错误速率
+    double tcpOutResetsPerSec;     // 发送 RST 速率
+    double udpInDatagramsPerSec;   // UDP 接收数据报速率
+    double udpOutDatagramsPerSec;  // UDP 发送数据报速率
+    double udpNoPortsPerSec;       // UDP 目标端口不可达速率
+    double udpInErrorsPerSec;      // UDP 接收错误速率
+    double udpReceiveBufferErrorsPerSec; // UDP 接收缓冲区溢出速率（仅 Linux）
+    bool socketsValid;             // 套接字计数有效
+    bool protocolValid;            // 协议速率有效
+};
+
+// 按连接数排序的进程
+struct SocketProcessData {
+    uint32_t pid;
+    uint32_t tcpConnections;       // 非监听 TCP 套接字数
+    uint32_t udpSockets;           // UDP 套接字数
+    wchar_t name[64];              // 进程名
+};
+
+// 卷空间用量预测
+struct DiskForecastData {
+    double fillRateBytesPerSec;    // 用量增长速率（字节/秒，负值表示在减少）
+    double secondsToFull;          // 按当前趋势预计填满的剩余秒数，-1 表示不在增长
+    bool valid;                    // 观测时长足够，预测可用
+};
+
 // 磁盘信息
 struct DiskData {
     char letter;          // 盘符（如'C'）
@@ -82,6 +188,7 @@ struct DiskData {
     uint64_t totalSize = 0; // 总容量（字节）
     uint64_t usedSpace = 0; // 已用空间（字节）
     uint64_t freeSpace = 0; // 可用空间（字节）
+    DiskForecastData forecast{}; // 新增：填满时间预测
 };
 
 // 温度传感器信息
@@ -90,6 +197,155 @@ struct TemperatureData {
     double temperature;     // 温度（摄氏度）
 };
 
+// 传感器描述（注册表），下标即传感器 ID，读数在 sensorValues 中按同一下标存放
+struct SensorInfoData {
+    uint8_t kind;           // 0 温度 1 风扇转速 2 电压 3 功耗 4 频率 5 负载 6 风扇占空比
+    uint8_t unit;           // 0 ℃ 1 RPM 2 V 3 W 4 MHz 5 %
+    uint8_t category;       // 所属硬件：0 CPU 1 GPU 2 存储 3 主板 4 其他
+    uint8_t primary;        // 所属类别的代表读数
+    wchar_t name[48];       // 传感器名称
+    wchar_t hardware[64];   // 所属硬件名称
+};
+
+// 降频事件（环形缓冲区槽位，第 n 个事件存放在 (n - 1) % 64）
+struct ThrottleEventData {
+    uint64_t sequence;             // 事件序号，从 1 开始递增，0 表示空槽
+    uint64_t timestampMs;          // Unix 时间（毫秒，UTC）
+    uint64_t durationMs;           // 结束事件为本次降频持续时间，开始事件为 0
+    uint32_t reasons;              // 0x1 温度墙 0x2 功耗墙 0x4 硬件降频信号 0x8 平台/固件限制
+    uint8_t source;                // 0 CPU 1 GPU
+    uint8_t type;                  // 0 开始 1 结束
+    uint16_t device;               // GPU 为 gpuTelemetry 下标，CPU 为 0
+    double temperature;            // ℃，以下不可用时为 NaN
+    double clockMHz;               // CPU 为各核心有效频率均值，GPU 为核心频率
+    double minClockMHz;            // CPU 为最低的核心有效频率
+    double powerWatts;
+    double powerLimitWatts;
+};
+
+// 每核心数据（使用率与中断分布共用同一区段）
+struct PerCoreData {
+    double usage;                  // 使用率（%）
+    double interruptsPerSec;       // 中断速率（次/秒）
+    double stealPercent;           // steal 时间占比（%）
+    double guestPercent;           // guest 时间占比（%）
+    double stealAdjustedUsage;     // 扣除 steal 后的使用率（%）
+};
+
+// 调度器与中断活动
+struct SchedulerData {
+    double contextSwitchesPerSec;  // 上下文切换（次/秒）
+    double interruptsPerSec;       // 中断（次/秒）
+    double processesCreatedPerSec; // 新建进程（个/秒）
+    uint32_t runnableTasks;        // 可运行任务数（运行队列长度）
+    uint32_t blockedTasks;         // 阻塞在I/O上的任务数
+    double loadAverage1;           // 1分钟负载均值
+    double loadAverage5;           // 5分钟负载均值
+    double loadAverage15;          // 15分钟负载均值
+    double stealPercent;           // 全部核心 steal 时间占比（%）
+    double guestPercent;           // 全部核心 guest 时间占比（%）
+    double stealAdjustedUsage;     // 全部核心扣除 steal 后的使用率（%）
+};
+
+// 虚拟化环境
+struct VirtualizationData {
+    bool hypervisorPresent;        // 是否作为虚拟机客户机运行
+    wchar_t hypervisorName[32];    // Hypervisor 名称（如 Hyper-V、KVM）
+};
+
+// 扩展内存指标（提交、缓存、交换、缺页）
+struct MemoryDetailData {
+    uint64_t commitCharge;         // 已提交（字节）
+    uint64_t commitLimit;          // 提交上限（字节）
+    uint64_t cached;               // 文件缓存（字节）
+    uint64_t standby;              // 备用/非活动文件页（字节）
+    uint64_t dirty;                // 脏页/已修改页（字节）
+    uint64_t writeback;            // 正在回写（字节）
+    uint64_t swapTotal;            // 交换区总量（字节）
+    uint64_t swapUsed;             // 交换区已用（字节）
+    double swapInPagesPerSec;      // 换入（页/秒）
+    double swapOutPagesPerSec;     // 换出（页/秒）
+    double minorFaultsPerSec;      // 次要缺页（次/秒）
+    double majorFaultsPerSec;      // 主要缺页（次/秒）
+    uint64_t hugePagesTotal;       // 大页总数
+    uint64_t hugePagesFree;        // 空闲大页数
+    uint64_t hugePageSize;         // 大页大小（字节）
+};
+
+// 单项资源的压力阻塞信息（PSI）
+struct PressureResourceData {
+    double someAvg10;              // 至少一个任务阻塞的时间占比（%），10秒均值
+    double someAvg60;              // 同上，60秒均值
+    double fullAvg10;              // 所有非空闲任务同时阻塞的时间占比（%），10秒均值
+    double fullAvg60;              // 同上，60秒均值
+    double someStallPercent;       // 本采样周期 some 阻塞占比（%）
+    double fullStallPercent;       // 本采样周期 full 阻塞占比（%）
+    uint64_t someTotalUs;          // 累计 some 阻塞时间（微秒），Windows 为0
+    uint64_t fullTotalUs;          // 累计 full 阻塞时间（微秒），Windows 为0
+};
+
+// 压力阻塞信息（CPU / 内存 / I/O）
+struct PressureData {
+    PressureResourceData cpu;
+    PressureResourceData memory;
+    PressureResourceData io;
+    uint32_t flags;                // 位标志，见 PRESSURE_FLAG_*
+};
+
+#define PRESSURE_FLAG_CPU       0x01u  // cpu 有数据
+#define PRESSURE_FLAG_MEMORY    0x02u  // memory 有数据
+#define PRESSURE_FLAG_IO        0x04u  // io 有数据
+#define PRESSURE_FLAG_ESTIMATED 0x08u  // 由 Windows 性能计数器近似得出
+#define PRESSURE_FLAG_MEMORY_WARNING 0x10u // 内存压力预警
+
+// NUMA 节点数据
+struct NumaNodeData {
+    uint32_t nodeId;               // 节点编号
+    uint32_t cpuCount;             // 节点内逻辑核心数
+    uint64_t totalMemory;          // 节点内存总量（字节）
+    uint64_t freeMemory;           // 节点空闲内存（字节）
+    uint64_t usedMemory;           // 节点已用内存（字节）
+    uint64_t numaHit;              // 累计命中本节点的分配页数（Windows 为0）
+    uint64_t numaMiss;             // 累计本应在其他节点却分配到本节点的页数
+    uint64_t numaForeign;          // 累计本应在本节点却分配到其他节点的页数
+    double numaHitPerSec;          // 命中速率（页/秒）
+    double numaMissPerSec;         // 未命中速率（页/秒）
+    double numaForeignPerSec;      // 外借速率（页/秒）
+    double otherNodePerSec;        // 跨节点分配速率（页/秒）
+    double cpuUsage;               // 节点 CPU 平均使用率（%）
+};
+
+// 块设备 I/O 速率
+struct DiskIoData {
+    wchar_t name[32];              // 设备名（sda / nvme0n1 / PhysicalDrive0）
+    double readBytesPerSec;        // 读吞吐（字节/秒）
+    double writeBytesPerSec;       // 写吞吐（字节/秒）
+    double readIops;               // 读 IOPS
+    double writeIops;              // 写 IOPS
+    double avgReadAwaitMs;         // 读平均耗时（毫秒）
+    double avgWriteAwaitMs;        // 写平均耗时（毫秒）
+    double avgAwaitMs;             // 读写平均耗时（毫秒）
+    double utilizationPercent;     // 设备忙碌时间占比（%）
+    double avgQueueLength;         // 平均队列长度
+    uint32_t queueDepth;           // 采样时刻在途请求数
+};
+
+// 已挂载文件系统（含无盘符卷、挂载文件夹）
+struct VolumeData {
+    wchar_t mountPoint[128];       // 挂载点（C:\ / D:\Mount\Data\ / /home）
+    wchar_t device[64];            // 卷 GUID 路径或块设备（/dev/sda1）
+    wchar_t fileSystem[16];        // 文件系统
+    wchar_t label[64];             // 卷标（仅 Windows）
+    uint64_t totalBytes;           // 总容量（字节）
+    uint64_t usedBytes;            // 已用空间（字节）
+    uint64_t freeBytes;            // 当前用户可用空间（字节）
+    uint64_t totalInodes;          // inode 总数（NTFS 为0）
+    uint64_t usedInodes;           // 已用 inode
+    uint64_t freeInodes;           // 可用 inode
+    bool readOnly;                 // 只读挂载
+    DiskForecastData forecast;     // 填满时间预测
+};
+
 // SystemInfo结构
 struct SystemInfo {
     std::string cpuName;
@@ -106,10 +362,26 @@ struct SystemInfo {
     uint64_t usedMemory;
     uint64_t availableMemory;
     std::vector<GPUData> gpus;
+    std::vector<GpuTelemetryData> gpuTelemetry; // 新增：全部 NVIDIA GPU 的实时遥测
+    std::vector<GpuProcessData> gpuProcesses; // 新增：占用显存最多的 GPU 进程
     std::vector<NetworkAdapterData> adapters;
+    std::vector<NetworkCounterData> adapterCounters; // 新增：与 adapters 一一对应的流量计数
+    const std::vector<NetworkAddressData>* networkAddresses = nullptr; // 新增：全部网卡地址、网关与DNS（指向主循环常驻的地址池，不逐周期复制）
+    uint64_t networkAddressGeneration = 0; // 新增：地址清单版本，变化时才重写共享内存地址池
+    SocketStatsData sockets{};       // 新增：套接字与协议统计
+    std::vector<SocketProcessData> socketProcesses; // 新增：连接数最多的进程
     std::vector<DiskData> disks;
     std::vector<PhysicalDiskSmartData> physicalDisks; // 新增：物理磁盘SMART数据
-    std::vector<std::pair<std::string, double>> temperatures;
+    std::vector<DiskIoData> diskIo;  // 新增：块设备 I/O 速率
+    std::vector<VolumeData> volumes; // 新增：全部已挂载文件系统
+    std::vector<TemperatureData> temperatures; // 名称在注册表变化时转换好，每个周期只填读数
+    const std::vector<SensorInfoData>* sensors = nullptr; // 新增：传感器注册表描述（指向主循环常驻的描述表）
+    std::vector<double> sensorValues; // 新增：与 sensors 一一对应的读数，NaN 表示不可用
+    uint64_t sensorGeneration = 0; // 新增：注册表版本，变化时才重写共享内存中的描述
+    uint64_t sensorValueGeneration = 0; // 新增：读数版本，有读数越过死区时才重写共享内存中的读数
+    const std::vector<ThrottleEventData>* throttleEvents = nullptr; // 新增：降频事件环形缓冲区（按槽位排列，指向主循环常驻副本）
+    uint64_t throttleEventSequence = 0; // 新增：最近一个降频事件的序号，变化时才重写事件区
+    uint32_t cpuThrottleReasons = 0; // 新增：CPU 当前降频原因
     std::string osVersion;
     std::string gpuName;            // Added
     std::string gpuBrand;           // Added
@@ -124,6 +396,13 @@ struct SystemInfo {
     double cpuTemperature; // 新增：CPU温度
     double gpuTemperature; // 新增：GPU温度
     double cpuUsageSampleIntervalMs = 0.0; // 新增：CPU使用率采样间隔（毫秒）
+    SchedulerData scheduler{};      // 新增：调度器与中断活动
+    bool hypervisorPresent = false; // 新增：是否运行在虚拟机中
+    std::string hypervisorName;     // 新增：Hypervisor 名称
+    std::vector<PerCoreData> cores; // 新增：每核心使用率与中断分布
+    MemoryDetailData memoryDetail{}; // 新增：扩展内存指标
+    PressureData pressure{};         // 新增：压力阻塞信息
+    std::vector<NumaNodeData> numaNodes; // 新增：NUMA 节点统计
     SYSTEMTIME lastUpdate;
 };
 
@@ -175,5 +454,73 @@ struct SharedMemoryBlock {
     int physicalDiskCount;       // 新增：物理磁盘数量
     SYSTEMTIME lastUpdate;
     CRITICAL_SECTION lock;
+
+    // ---- 以下区段追加在末尾，保持旧读取端（WPF）已有字段的偏移不变 ----
+
+    // 调度器与中断活动
+    SchedulerData scheduler;
+
+    // 每核心数据（支持最多256个逻辑核心）
+    int coreCount;
+    PerCoreData cores[256];
+
+    // 扩展内存指标
+    MemoryDetailData memoryDetail;
+
+    // 压力阻塞信息
+    PressureData pressure;
+
+    // NUMA 节点统计（支持最多8个节点）
+    int numaNodeCount;
+    NumaNodeData numaNodes[8];
+
+    // 虚拟化环境
+    VirtualizationData virtualizationInfo;
+
+    // 块设备 I/O 速率（支持最多64个设备）
+    int diskIoCount;
+    DiskIoData diskIo[64];
+
+    // 已挂载文件系统（支持最多32个卷）
+    int volumeCount;
+    VolumeData volumes[32];
+
+    // 逻辑磁盘填满时间预测（与 disks[8] 按下标一一对应）
+    DiskForecastData diskForecasts[8];
+
+    // 网卡流量与错误计数（与 adapters[4] 按下标一一对应）
+    NetworkCounterData adapterCounters[4];
+
+    // 网卡地址池（支持最多64条，仅在 networkAddressGeneration 变化时重写）
+    uint64_t networkAddressGeneration;
+    int networkAddressCount;
+    NetworkAddressData networkAddresses[64];
+
+    // 套接字与协议统计，连接数最多的进程（支持最多8个）
+    SocketStatsData sockets;
+    int socketProcessCount;
+    SocketProcessData socketProcesses[8];
+
+    // NVIDIA GPU 实时遥测（支持最多8个GPU）
+    int gpuTelemetryCount;
+    GpuTelemetryData gpuTelemetry[8];
+
+    // GPU 进程占用（最多16个）
+    int gpuProcessCount;
+    GpuProcessData gpuProcesses[16];
+
+    // 传感器注册表（最多128个）：描述只在 sensorGeneration 变化时重写
+    uint64_t sensorGeneration;
+    int sensorCount;
+    SensorInfoData sensors[128];
+    double sensorValues[128];
+
+    // 传感器读数版本：读数只在越过死区或强制刷新时变化，读取端可比较此值跳过未变化的周期
+    uint64_t sensorValueGeneration;
+
+    // 降频事件环形缓冲区（64个槽位）：读取端记下已处理的序号，取 sequence 更大的槽位；只在序号变化时重写
+    uint64_t throttleEventSequence;
+    uint32_t cpuThrottleReasons;
+    ThrottleEventData throttleEvents[64];
 };
 #pragma pack(pop)
\ No newline at end of file
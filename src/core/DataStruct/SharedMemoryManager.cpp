@@ -56,6 +56,7 @@ inline std::string FallbackFormatWindowsErrorMessage(DWORD errorCode) {
 HANDLE SharedMemoryManager::hMapFile = NULL;
 SharedMemoryBlock* SharedMemoryManager::pBuffer = nullptr;
 std::string SharedMemoryManager::lastError = "";
+bool SharedMemoryManager::fullWritePending = true;
 // 跨进程互斥体用于同步共享内存
 static HANDLE g_hMutex = NULL;
 
@@ -218,6 +219,7 @@ bool SharedMemoryManager::InitSharedMemory() {
     if (errorCode != ERROR_ALREADY_EXISTS) {
         memset(pBuffer, 0, sizeof(SharedMemoryBlock));
     }
+    fullWritePending = true;
 
     Logger::Info("共享内存成功初始化.");
     return true;
@@ -293,6 +295,8 @@ void SharedMemoryManager::WriteToSharedMemory(const SystemInfo& systemInfo) {
         pBuffer->totalMemory = systemInfo.totalMemory;
         pBuffer->usedMemory = systemInfo.usedMemory;
         pBuffer->availableMemory = systemInfo.availableMemory;
+        pBuffer->memoryDetail = systemInfo.memoryDetail;
+        pBuffer->pressure = systemInfo.pressure;
 
         // GPU（兼容旧字段）
         pBuffer->gpuCount = 0;
@@ -373,6 +377,9 @@ void SharedMemoryManager::WriteToSharedMemory(const SystemInfo& systemInfo) {
             pBuffer->physicalDisks[i].wearLeveling = src.wearLeveling;
             pBuffer->physicalDisks[i].totalBytesWritten = src.totalBytesWritten;
             pBuffer->physicalDisks[i].totalBytesRead = src.totalBytesRead;
+            pBuffer->physicalDisks[i].failureRiskScore = src.failureRiskScore;
+            pBuffer->physicalDisks[i].wearOutEtaDays = src.wearOutEtaDays;
+            pBuffer->physicalDisks[i].defectGrowth7d = src.defectGrowth7d;
             int ldCount = 0;
             for (char l : src.logicalDriveLetters) {
                 if (ldCount >= 8 || l == 0) break;
@@ -399,12 +406,10 @@ void SharedMemoryManager::WriteToSharedMemory(const SystemInfo& systemInfo) {
             }
         }
 
-        // 温度数组（传感器名字在 vector<pair<string,double>> 中）
+        // 温度数组（名称已是宽字符）
         pBuffer->tempCount = static_cast<int>(std::min(systemInfo.temperatures.size(), static_cast<size_t>(10)));
         for (int i = 0; i < pBuffer->tempCount; ++i) {
-            const auto& temp = systemInfo.temperatures[i];
-            SafeCopyWideString(pBuffer->temperatures[i].sensorName, 64, WinUtils::StringToWstring(temp.first));
-            pBuffer->temperatures[i].temperature = temp.second;
+            pBuffer->temperatures[i] = systemInfo.temperatures[i];
         }
 
         // 独立 CPU / GPU 温度
@@ -412,7 +417,115 @@ void SharedMemoryManager::WriteToSharedMemory(const SystemInfo& systemInfo) {
         pBuffer->gpuTemperature = systemInfo.gpuTemperature;
         pBuffer->cpuUsageSampleIntervalMs = systemInfo.cpuUsageSampleIntervalMs;
 
+        // 调度器与中断活动 + 每核心数据
+        pBuffer->scheduler = systemInfo.scheduler;
+        pBuffer->coreCount = static_cast<int>(std::min(systemInfo.cores.size(), static_cast<size_t>(256)));
+        memset(pBuffer->cores, 0, sizeof(pBuffer->cores));
+        for (int i = 0; i < pBuffer->coreCount; ++i) {
+            pBuffer->cores[i] = systemInfo.cores[i];
+        }
+
+        // 虚拟化环境
+        pBuffer->virtualizationInfo.hypervisorPresent = systemInfo.hypervisorPresent;
+        SafeCopyWideString(pBuffer->virtualizationInfo.hypervisorName, 32, WinUtils::StringToWstring(systemInfo.hypervisorName));
+
+        // 块设备 I/O 速率
+        pBuffer->diskIoCount = static_cast<int>(std::min(systemInfo.diskIo.size(), static_cast<size_t>(64)));
+        memset(pBuffer->diskIo, 0, sizeof(pBuffer->diskIo));
+        for (int i = 0; i < pBuffer->diskIoCount; ++i) {
+            pBuffer->diskIo[i] = systemInfo.diskIo[i];
+        }
+
+        // 已挂载文件系统
+        pBuffer->volumeCount = static_cast<int>(std::min(systemInfo.volumes.size(), static_cast<size_t>(32)));
+        memset(pBuffer->volumes, 0, sizeof(pBuffer->volumes));
+        for (int i = 0; i < pBuffer->volumeCount; ++i) {
+            pBuffer->volumes[i] = systemInfo.volumes[i];
+        }
+
+        // 逻辑磁盘填满时间预测
+        memset(pBuffer->diskForecasts, 0, sizeof(pBuffer->diskForecasts));
+        for (int i = 0; i < pBuffer->diskCount; ++i) {
+            pBuffer->diskForecasts[i] = systemInfo.disks[i].forecast;
+        }
+
+        // 网卡流量计数，按 adapters 的写入数量对齐
+        memset(pBuffer->adapterCounters, 0, sizeof(pBuffer->adapterCounters));
+        for (int i = 0; i < pBuffer->adapterCount && i < static_cast<int>(systemInfo.adapterCounters.size()); ++i) {
+            pBuffer->adapterCounters[i] = systemInfo.adapterCounters[i];
+        }
+
+        // 网卡地址池，地址清单未变化时保持原内容
+        if (fullWritePending || pBuffer->networkAddressGeneration != systemInfo.networkAddressGeneration) {
+            const size_t addressCount = systemInfo.networkAddresses ? systemInfo.networkAddresses->size() : 0;
+            pBuffer->networkAddressCount = static_cast<int>(std::min(addressCount, static_cast<size_t>(64)));
+            memset(pBuffer->networkAddresses, 0, sizeof(pBuffer->networkAddresses));
+            for (int i = 0; i < pBuffer->networkAddressCount; ++i) {
+                pBuffer->networkAddresses[i] = (*systemInfo.networkAddresses)[i];
+            }
+            pBuffer->networkAddressGeneration = systemInfo.networkAddressGeneration;
+        }
+
+        // 套接字统计
+        pBuffer->sockets = systemInfo.sockets;
+        pBuffer->socketProcessCount = static_cast<int>(std::min(systemInfo.socketProcesses.size(), static_cast<size_t>(8)));
+        memset(pBuffer->socketProcesses, 0, sizeof(pBuffer->socketProcesses));
+        for (int i = 0; i < pBuffer->socketProcessCount; ++i) {
+            pBuffer->socketProcesses[i] = systemInfo.socketProcesses[i];
+        }
+
+        // NVIDIA GPU 遥测
+        pBuffer->gpuTelemetryCount = static_cast<int>(std::min(systemInfo.gpuTelemetry.size(), static_cast<size_t>(8)));
+        memset(pBuffer->gpuTelemetry, 0, sizeof(pBuffer->gpuTelemetry));
+        for (int i = 0; i < pBuffer->gpuTelemetryCount; ++i) {
+            pBuffer->gpuTelemetry[i] = systemInfo.gpuTelemetry[i];
+        }
+        pBuffer->gpuProcessCount = static_cast<int>(std::min(systemInfo.gpuProcesses.size(), static_cast<size_t>(16)));
+        memset(pBuffer->gpuProcesses, 0, sizeof(pBuffer->gpuProcesses));
+        for (int i = 0; i < pBuffer->gpuProcessCount; ++i) {
+            pBuffer->gpuProcesses[i] = systemInfo.gpuProcesses[i];
+        }
+
+        // 传感器注册表，描述与读数未变化时保持原内容
+        bool sensorsChanged = fullWritePending || pBuffer->sensorGeneration != systemInfo.sensorGeneration;
+        if (sensorsChanged) {
+            const size_t sensorCount = systemInfo.sensors ? systemInfo.sensors->size() : 0;
+            pBuffer->sensorCount = static_cast<int>(std::min(sensorCount, static_cast<size_t>(128)));
+            memset(pBuffer->sensors, 0, sizeof(pBuffer->sensors));
+            for (int i = 0; i < pBuffer->sensorCount; ++i) {
+                pBuffer->sensors[i] = (*systemInfo.sensors)[i];
+            }
+            pBuffer->sensorGeneration = systemInfo.sensorGeneration;
+        }
+        if (sensorsChanged || pBuffer->sensorValueGeneration != systemInfo.sensorValueGeneration) {
+            size_t sensorValueCount = std::min(systemInfo.sensorValues.size(), static_cast<size_t>(pBuffer->sensorCount));
+            memset(pBuffer->sensorValues, 0, sizeof(pBuffer->sensorValues));
+            if (sensorValueCount > 0) {
+                memcpy(pBuffer->sensorValues, systemInfo.sensorValues.data(), sensorValueCount * sizeof(double));
+            }
+            pBuffer->sensorValueGeneration = systemInfo.sensorValueGeneration;
+        }
+
+        // 降频事件，没有新事件时保持原内容
+        pBuffer->cpuThrottleReasons = systemInfo.cpuThrottleReasons;
+        if (fullWritePending || pBuffer->throttleEventSequence != systemInfo.throttleEventSequence) {
+            size_t eventCount = systemInfo.throttleEvents ? std::min(systemInfo.throttleEvents->size(), static_cast<size_t>(64)) : 0;
+            memset(pBuffer->throttleEvents, 0, sizeof(pBuffer->throttleEvents));
+            for (size_t i = 0; i < eventCount; ++i) {
+                pBuffer->throttleEvents[i] = (*systemInfo.throttleEvents)[i];
+            }
+            pBuffer->throttleEventSequence = systemInfo.throttleEventSequence;
+        }
+
+        // NUMA 节点统计
+        pBuffer->numaNodeCount = static_cast<int>(std::min(systemInfo.numaNodes.size(), static_cast<size_t>(8)));
+        memset(pBuffer->numaNodes, 0, sizeof(pBuffer->numaNodes));
+        for (int i = 0; i < pBuffer->numaNodeCount; ++i) {
+            pBuffer->numaNodes[i] = systemInfo.numaNodes[i];
+        }
+
         GetSystemTime(&pBuffer->lastUpdate);
+        fullWritePending = false;
         Logger::Trace("成功写入系统/磁盘/SMART 信息到共享内存");
     } catch (const std::exception& e) {
         lastError = std::string("WriteToSharedMemory 中的异常: ") + e.what();
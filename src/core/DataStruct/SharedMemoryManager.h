@@ -9,6 +9,9 @@ private:
     static HANDLE hMapFile;
     static SharedMemoryBlock* pBuffer;
     static std::string lastError; // Store last error message
+    // 初始化后的首次写入忽略各区段的版本号判断：映射在客户端仍持有时不会清零，
+    // 重启后的版本号可能与上次进程留下的相同
+    static bool fullWritePending;
 
 public:
     // Initialize shared memory
@@ -0,0 +1,46 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdint>
+
+// 累计计数器差值与速率计算
+// 所有速率都基于单调时钟（steady_clock：Windows 上为 QPC，Linux 上为 CLOCK_MONOTONIC），
+// 系统时间被调整时不会产生负值或尖峰
+class CounterMath {
+public:
+    static uint64_t MonotonicNowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // 单调计数器差值
+    // 当前值小于上次值时：上次值在32位范围内按32位回绕处理（旧驱动/接口的32位计数器），
+    // 否则视为计数器被重置（设备重新加载），以当前值作为增量
+    static uint64_t Delta(uint64_t previous, uint64_t current) {
+        if (current >= previous) return current - previous;
+        if (previous <= 0xFFFFFFFFULL) return (0x100000000ULL - previous) + current;
+        return current;
+    }
+
+    // 原生64位计数器差值（MIB_IF_ROW2、64位内核的 /proc/net/dev 等）：实际不会回绕，
+    // 当前值小于上次值只可能是计数器被重置（接口重置、驱动重新加载），以当前值作为增量
+    static uint64_t Delta64(uint64_t previous, uint64_t current) {
+        return current >= previous ? current - previous : current;
+    }
+
+    // 已知回绕上限的计数器差值（如 RAPL energy_uj 的 max_energy_range_uj）
+    static uint64_t DeltaWithRange(uint64_t previous, uint64_t current, uint64_t range) {
+        if (current >= previous) return current - previous;
+        if (range > previous) return (range - previous) + current;
+        return current;
+    }
+
+    // 只增不减的量（如某些汇总值可能因设备消失而变小），变小时按0处理
+    static uint64_t SaturatingDelta(uint64_t previous, uint64_t current) {
+        return current >= previous ? current - previous : 0;
+    }
+
+    static double PerSecond(uint64_t delta, uint64_t elapsedNs) {
+        if (elapsedNs == 0) return 0.0;
+        return static_cast<double>(delta) * 1e9 / static_cast<double>(elapsedNs);
+    }
+};
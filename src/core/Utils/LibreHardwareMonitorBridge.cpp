@@ -1,7 +1,7 @@
 #include "LibreHardwareMonitorBridge.h"
 #include "Logger.h"
 #include <msclr/marshal_cppstd.h>
-#include <iostream>
+#include <limits>
 #include <windows.h>
 
 // 不需要重复#using，已在头文件中包含
@@ -14,15 +14,41 @@ using namespace msclr::interop;
 // 定义静态成员
 bool LibreHardwareMonitorBridge::initialized = false;
 gcroot<Computer^> LibreHardwareMonitorBridge::computer;
-gcroot<UpdateVisitor^> LibreHardwareMonitorBridge::visitor;
+gcroot<List<IHardware^>^> LibreHardwareMonitorBridge::nodes;
+
+namespace {
+    bool ToKind(SensorType type, LibreHardwareMonitorBridge::Kind& out) {
+        switch (type) {
+        case SensorType::Temperature: out = LibreHardwareMonitorBridge::Kind::Temperature; return true;
+        case SensorType::Fan: out = LibreHardwareMonitorBridge::Kind::Fan; return true;
+        case SensorType::Voltage: out = LibreHardwareMonitorBridge::Kind::Voltage; return true;
+        case SensorType::Power: out = LibreHardwareMonitorBridge::Kind::Power; return true;
+        case SensorType::Control: out = LibreHardwareMonitorBridge::Kind::Control; return true;
+        default: return false;
+        }
+    }
+
+    bool ToDevice(HardwareType type, LibreHardwareMonitorBridge::Device& out) {
+        switch (type) {
+        case HardwareType::Cpu: out = LibreHardwareMonitorBridge::Device::Cpu; return true;
+        case HardwareType::GpuNvidia:
+        case HardwareType::GpuAmd:
+        case HardwareType::GpuIntel: out = LibreHardwareMonitorBridge::Device::Gpu; return true;
+        case HardwareType::Motherboard:
+        case HardwareType::SuperIO: out = LibreHardwareMonitorBridge::Device::Motherboard; return true;
+        default: return false;
+        }
+    }
+}
 
 void LibreHardwareMonitorBridge::Initialize() {
     try {
         if (initialized) return;
         computer = gcnew Computer();
         computer->IsCpuEnabled = true;
+        // 风扇转速、占空比与主板电压来自 Super I/O 芯片
+        computer->IsMotherboardEnabled = true;
         computer->Open();
-        visitor = gcnew UpdateVisitor();
         initialized = true;
     }
     catch (System::IO::FileNotFoundException^ ex) {
@@ -40,27 +66,60 @@ void LibreHardwareMonitorBridge::Cleanup() {
     if (!initialized) return;
     computer->Close();
     computer = nullptr;
-    visitor = nullptr;
+    nodes = nullptr;
     initialized = false;
 }
 
-std::vector<std::pair<std::string, double>> LibreHardwareMonitorBridge::GetTemperatures() {
-    std::vector<std::pair<std::string, double>> temps;
-    if (!initialized) return temps;
+std::vector<LibreHardwareMonitorBridge::SensorEntry> LibreHardwareMonitorBridge::EnumerateSensors() {
+    std::vector<SensorEntry> entries;
+    if (!initialized) return entries;
 
-    computer->Accept(visitor);
+    nodes = gcnew List<IHardware^>();
     for each (IHardware ^ hardware in computer->Hardware) {
+        nodes->Add(hardware);
+        for each (IHardware ^ sub in hardware->SubHardware) {
+            nodes->Add(sub);
+        }
+    }
+    for (int i = 0; i < nodes->Count; ++i) {
+        IHardware^ hardware = nodes[i];
+        Device device;
+        if (!ToDevice(hardware->HardwareType, device)) continue;
+        // 传感器在首次 Update() 后才有值
         hardware->Update();
-        if (hardware->HardwareType == HardwareType::Cpu ||
-            hardware->HardwareType == HardwareType::GpuNvidia ||
-            hardware->HardwareType == HardwareType::GpuAmd) {
-            for each (ISensor ^ sensor in hardware->Sensors) {
-                if (sensor->SensorType == SensorType::Temperature && sensor->Value.HasValue) {
-                    std::string name = marshal_as<std::string>(sensor->Name);
-                    temps.push_back({ name, sensor->Value.Value });
-                }
-            }
+        array<ISensor^>^ sensors = hardware->Sensors;
+        for (int j = 0; j < sensors->Length; ++j) {
+            SensorEntry entry;
+            if (!ToKind(sensors[j]->SensorType, entry.kind)) continue;
+            entry.hardware = i;
+            entry.sensor = j;
+            entry.device = device;
+            entry.hardwareName = marshal_as<std::string>(hardware->Name);
+            entry.name = marshal_as<std::string>(sensors[j]->Name);
+            entries.push_back(entry);
         }
     }
-    return temps;
+    return entries;
+}
+
+bool LibreHardwareMonitorBridge::UpdateHardware(int hardware) {
+    if (!initialized || static_cast<List<IHardware^>^>(nodes) == nullptr) return false;
+    try {
+        if (hardware < 0 || hardware >= nodes->Count) return false;
+        nodes[hardware]->Update();
+        return true;
+    }
+    catch (System::Exception^ ex) {
+        Logger::Warn("LibreHardwareMonitor 刷新硬件失败: " + marshal_as<std::string>(ex->Message));
+        return false;
+    }
+}
+
+double LibreHardwareMonitorBridge::ReadSensor(int hardware, int sensor) {
+    const double unavailable = std::numeric_limits<double>::quiet_NaN();
+    if (!initialized || static_cast<List<IHardware^>^>(nodes) == nullptr) return unavailable;
+    if (hardware < 0 || hardware >= nodes->Count) return unavailable;
+    array<ISensor^>^ sensors = nodes[hardware]->Sensors;
+    if (sensor < 0 || sensor >= sensors->Length || !sensors[sensor]->Value.HasValue) return unavailable;
+    return sensors[sensor]->Value.Value;
 }
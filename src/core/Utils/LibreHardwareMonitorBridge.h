@@ -2,7 +2,6 @@
 
 #include <string>
 #include <vector>
-#include <utility>
 #include <vcclr.h> // 必须包含以使用 gcroot
 
 // 使用相对路径，并统一使用net472版本以匹配项目配置
@@ -15,29 +14,33 @@ namespace LibreHardwareMonitor {
     }
 }
 
-// 定义 UpdateVisitor 类
-ref class UpdateVisitor : public LibreHardwareMonitor::Hardware::IVisitor {
-public:
-    virtual void VisitComputer(LibreHardwareMonitor::Hardware::IComputer^ computer) {
-        computer->Traverse(this);
-    }
-    virtual void VisitHardware(LibreHardwareMonitor::Hardware::IHardware^ hardware) {
-        hardware->Update();
-        hardware->Traverse(this);
-    }
-    virtual void VisitSensor(LibreHardwareMonitor::Hardware::ISensor^ /*sensor*/) {}
-    virtual void VisitParameter(LibreHardwareMonitor::Hardware::IParameter^ /*parameter*/) {}
-};
-
+// 按下标访问 Libre 的硬件节点与传感器：登记时枚举一次，采样时只刷新需要的硬件节点（每个节点每周期一次 Update()）
+// 硬件节点包括顶层硬件与其子硬件（主板的 Super I/O 芯片挂在主板节点下），展开为一张列表
 class LibreHardwareMonitorBridge {
 public:
+    enum class Kind { Temperature, Fan, Voltage, Power, Control };
+    enum class Device { Cpu, Gpu, Motherboard };
+
+    struct SensorEntry {
+        int hardware = 0;           // 展开后的硬件节点下标
+        int sensor = 0;             // hardware->Sensors 下标
+        Kind kind = Kind::Temperature;
+        Device device = Device::Cpu;
+        std::string hardwareName;
+        std::string name;
+    };
+
     static void Initialize();
     static void Cleanup();
-    // 日志语义优化：温度传感器数量
-    static std::vector<std::pair<std::string, double>> GetTemperatures();
+    // 刷新一次全部硬件并列出温度、风扇、电压、功耗与风扇占空比传感器，按硬件节点下标排列；只在登记时调用
+    static std::vector<SensorEntry> EnumerateSensors();
+    // 只刷新一个硬件节点
+    static bool UpdateHardware(int hardware);
+    // 读取上次刷新得到的值，没有值时返回 NaN
+    static double ReadSensor(int hardware, int sensor);
 
 private:
     static bool initialized;
     static gcroot<LibreHardwareMonitor::Hardware::Computer^> computer; // 使用 gcroot 包装 Computer
-    static gcroot<UpdateVisitor^> visitor; // 使用 gcroot 包装 UpdateVisitor
+    static gcroot<System::Collections::Generic::List<LibreHardwareMonitor::Hardware::IHardware^>^> nodes;
 };
@@ -0,0 +1,99 @@
+﻿#include "ProcFile.h"
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+ProcFile::ProcFile(const std::string& filePath, size_t initialCapacity) {
+    Open(filePath, initialCapacity);
+}
+
+ProcFile::~ProcFile() {
+    Close();
+}
+
+ProcFile::ProcFile(ProcFile&& other) noexcept
+    : fd(other.fd), size(other.size), buffer(std::move(other.buffer)), path(std::move(other.path)) {
+    other.fd = -1;
+    other.size = 0;
+}
+
+ProcFile& ProcFile::operator=(ProcFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        fd = other.fd;
+        size = other.size;
+        buffer = std::move(other.buffer);
+        path = std::move(other.path);
+        other.fd = -1;
+        other.size = 0;
+    }
+    return *this;
+}
+
+#ifndef _WIN32
+
+bool ProcFile::Open(const std::string& filePath, size_t initialCapacity) {
+    Close();
+    path = filePath;
+    fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    if (buffer.size() < initialCapacity) buffer.resize(initialCapacity);
+    return true;
+}
+
+void ProcFile::Close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    size = 0;
+}
+
+bool ProcFile::Read() {
+    size = 0;
+    if (fd < 0) return false;
+    if (buffer.empty()) buffer.resize(4096);
+
+    for (;;) {
+        size_t total = 0;
+        for (;;) {
+            ssize_t n = ::pread(fd, buffer.data() + total, buffer.size() - total, static_cast<off_t>(total));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (n == 0) break;
+            total += static_cast<size_t>(n);
+            if (total == buffer.size()) break;
+        }
+        // 缓冲区被填满说明内容可能被截断：扩容后从头重读，保证得到一致的快照
+        if (total < buffer.size()) {
+            size = total;
+            return true;
+        }
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+#else
+
+bool ProcFile::Open(const std::string& filePath, size_t /*initialCapacity*/) {
+    path = filePath;
+    return false;
+}
+
+void ProcFile::Close() {
+    fd = -1;
+    size = 0;
+}
+
+bool ProcFile::Read() {
+    size = 0;
+    return false;
+}
+
+#endif
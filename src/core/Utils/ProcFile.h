@@ -0,0 +1,39 @@
+﻿#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 常驻打开的 /proc、sysfs 文件
+// 打开一次后每次采样用 pread 从偏移0重新读取，避免每个周期 open/close；
+// 缓冲区只在内容超过当前容量时扩容，稳定运行后不再分配内存
+// Windows 下没有对应文件，Open 始终返回 false
+class ProcFile {
+public:
+    ProcFile() = default;
+    explicit ProcFile(const std::string& filePath, size_t initialCapacity = 4096);
+    ~ProcFile();
+
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+    ProcFile(ProcFile&& other) noexcept;
+    ProcFile& operator=(ProcFile&& other) noexcept;
+
+    bool Open(const std::string& filePath, size_t initialCapacity = 4096);
+    void Close();
+    bool IsOpen() const { return fd >= 0; }
+
+    // 重新读取全部内容，成功后通过 Data()/End() 访问
+    bool Read();
+
+    const char* Data() const { return buffer.data(); }
+    const char* End() const { return buffer.data() + size; }
+    size_t Size() const { return size; }
+    const std::string& Path() const { return path; }
+    int Descriptor() const { return fd; }
+
+private:
+    int fd = -1;
+    size_t size = 0;
+    std::vector<char> buffer;
+    std::string path;
+};
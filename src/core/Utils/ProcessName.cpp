@@ -0,0 +1,40 @@
+﻿#include "ProcessName.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include "WinUtils.h"
+#else
+#include <cstdio>
+#include <cstring>
+#endif
+
+std::string ProcessName::Query(uint32_t pid) {
+#ifdef _WIN32
+    if (pid == 4) return "System";
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!process) return std::string();
+    std::string name;
+    wchar_t path[MAX_PATH];
+    DWORD length = MAX_PATH;
+    if (QueryFullProcessImageNameW(process, 0, path, &length)) {
+        std::wstring fullPath(path, length);
+        size_t slash = fullPath.find_last_of(L'\\');
+        name = WinUtils::WstringToUtf8(slash == std::wstring::npos ? fullPath : fullPath.substr(slash + 1));
+    }
+    CloseHandle(process);
+    return name;
+#else
+    std::string name;
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%u/comm", pid);
+    if (FILE* comm = fopen(path, "re")) {
+        char text[64] = {};
+        if (fgets(text, sizeof(text), comm)) {
+            text[strcspn(text, "\n")] = '\0';
+            name = text;
+        }
+        fclose(comm);
+    }
+    return name;
+#endif
+}
@@ -0,0 +1,12 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+
+// 按 PID 查询进程名（UTF-8）
+// Windows: QueryFullProcessImageNameW 取映像文件名；Linux: /proc/<pid>/comm
+// 每次调用都会打开进程句柄或文件，调用方应只对新出现的 PID 查询并自行保存结果
+class ProcessName {
+public:
+    // 进程已退出或无权限时返回空字符串
+    static std::string Query(uint32_t pid);
+};
@@ -0,0 +1,112 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTSCAN_HAS_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 面向 /proc、sysfs 等文本接口的无分配扫描工具
+// 所有函数只在 [p, end) 范围内工作，不依赖 '\0' 结尾，也不分配内存
+class TextScan {
+public:
+    // 跳过空格/制表符
+    // /proc/interrupts 这类宽表的计数列为右对齐，多核主机上每行大部分是空格，这里按16字节一组用 SSE2 比较
+    static const char* SkipSpaces(const char* p, const char* end) {
+        for (;;) {
+#ifdef TEXTSCAN_HAS_SSE2
+            const __m128i space = _mm_set1_epi8(' ');
+            while (end - p >= 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, space))) ^ 0xFFFFu;
+                if (mask != 0) { p += CountTrailingZeros(mask); break; }
+                p += 16;
+            }
+#endif
+            if (p < end && (*p == ' ' || *p == '\t')) { ++p; continue; }
+            return p;
+        }
+    }
+
+    // 跳过一个非空白记号
+    static const char* SkipToken(const char* p, const char* end) {
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\n') ++p;
+        return p;
+    }
+
+    // 返回下一行行首（memchr 在 CRT/glibc 中已向量化）
+    static const char* NextLine(const char* p, const char* end) {
+        if (p >= end) return end;
+        const void* nl = memchr(p, '\n', static_cast<size_t>(end - p));
+        return nl ? static_cast<const char*>(nl) + 1 : end;
+    }
+
+    static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // 判断 [p, end) 是否以字面量 lit 开头
+    static bool StartsWith(const char* p, const char* end, const char* lit, size_t litLen) {
+        return static_cast<size_t>(end - p) >= litLen && memcmp(p, lit, litLen) == 0;
+    }
+
+    // 解析无符号整数，成功时 p 移动到数字之后；不跳过前导空白
+    static bool ParseU64(const char*& p, const char* end, uint64_t& out) {
+        if (p >= end || !IsDigit(*p)) return false;
+        uint64_t value = 0;
+        while (p < end && IsDigit(*p)) {
+            value = value * 10 + static_cast<uint64_t>(*p - '0');
+            ++p;
+        }
+        out = value;
+        return true;
+    }
+
+    // 跳过空白后解析无符号整数
+    static bool NextU64(const char*& p, const char* end, uint64_t& out) {
+        p = SkipSpaces(p, end);
+        return ParseU64(p, end, out);
+    }
+
+    // 解析有符号整数（sysfs 温度等可能为负）
+    static bool ParseI64(const char*& p, const char* end, int64_t& out) {
+        bool negative = false;
+        if (p < end && *p == '-') { negative = true; ++p; }
+        uint64_t magnitude = 0;
+        if (!ParseU64(p, end, magnitude)) return false;
+        out = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+        return true;
+    }
+
+    // 解析定点小数（如 "12.34"，/proc/loadavg 与 PSI 的 avg 字段），不支持指数形式
+    static bool ParseFixed(const char*& p, const char* end, double& out) {
+        uint64_t integral = 0;
+        if (!ParseU64(p, end, integral)) return false;
+        double value = static_cast<double>(integral);
+        if (p < end && *p == '.') {
+            ++p;
+            double scale = 0.1;
+            while (p < end && IsDigit(*p)) {
+                value += (*p - '0') * scale;
+                scale *= 0.1;
+                ++p;
+            }
+        }
+        out = value;
+        return true;
+    }
+
+private:
+    static unsigned CountTrailingZeros(unsigned mask) {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+};
@@ -1,4 +1,5 @@
 ﻿#include "CpuInfo.h"
+#include "Hypervisor.h"
 #include "Logger.h"
 #include <intrin.h>
 #include <windows.h>
@@ -17,11 +18,16 @@
 #define PDH_CSTATUS_NEW_DATA 0x00000001L
 #endif
 
+#ifndef PF_VIRT_FIRMWARE_ENABLED
+#define PF_VIRT_FIRMWARE_ENABLED 21
+#endif
+
 CpuInfo::CpuInfo() :
     totalCores(0),
     largeCores(0),
     smallCores(0),
     cpuUsage(0.0),
+    virtualizationEnabled(false),
     counterInitialized(false),
     lastUpdateTime(0),
     lastSampleTick(0),
@@ -33,6 +39,15 @@ CpuInfo::CpuInfo() :
         cpuName = GetNameFromRegistry();
         InitializeCounter();
         UpdateCoreSpeeds();  // 初始化频率信息
+
+        // 虚拟化状态与 Hypervisor 只在启动时检测一次
+        virtualizationEnabled = IsProcessorFeaturePresent(PF_VIRT_FIRMWARE_ENABLED) != FALSE;
+        const auto& hypervisor = HypervisorInfo::Get();
+        if (hypervisor.present) {
+            Logger::Info("检测到运行在虚拟机中，Hypervisor: " + hypervisor.name);
+        } else if (hypervisor.rootPartition) {
+            Logger::Info("运行在 Hyper-V 根分区中（VBS/HVCI 已开启），按物理机处理");
+        }
     }
     catch (const std::exception& e) {
         Logger::Error("CPU信息初始化失败: " + std::string(e.what()));
@@ -273,21 +288,15 @@ bool CpuInfo::IsHyperThreadingEnabled() const {
     return (totalCores > (largeCores + smallCores));
 }
 
+// __readmsr 是特权指令，在用户态执行必然触发异常，因此改为由系统报告固件是否启用了 VT-x/AMD-V
 bool CpuInfo::IsVirtualizationEnabled() const {
-    int cpuInfo[4];
-    __cpuid(cpuInfo, 1);
-    bool hasVMX = (cpuInfo[2] & (1 << 5)) != 0;
-
-    if (!hasVMX) return false;
+    return virtualizationEnabled;
+}
 
-    bool isVMXEnabled = false;
-    __try {
-        unsigned __int64 msrValue = __readmsr(0x3A);
-        isVMXEnabled = (msrValue & 0x5) != 0;
-    }
-    __except (EXCEPTION_EXECUTE_HANDLER) {
-        isVMXEnabled = false;
-    }
+bool CpuInfo::IsHypervisorPresent() const {
+    return HypervisorInfo::Get().present;
+}
 
-    return isVMXEnabled;
+std::string CpuInfo::GetHypervisorName() const {
+    return HypervisorInfo::Get().name;
 }
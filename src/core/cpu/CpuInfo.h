@@ -20,6 +20,8 @@ public:
     DWORD GetCurrentSpeed() const;       // 保持兼容性
     bool IsHyperThreadingEnabled() const;
     bool IsVirtualizationEnabled() const;
+    bool IsHypervisorPresent() const;         // 新增：是否作为虚拟机客户机运行
+    std::string GetHypervisorName() const;    // 新增：Hypervisor 名称（启动时检测并缓存）
 
     // 新增：获取最近一次 CPU 使用率采样间隔（毫秒）
     double GetLastSampleIntervalMs() const { return lastSampleIntervalMs; }
@@ -38,6 +40,7 @@ private:
     int smallCores;
     int largeCores;
     double cpuUsage;
+    bool virtualizationEnabled;
 
     // 频率信息
     std::vector<DWORD> largeCoresSpeeds; // 性能核心频率
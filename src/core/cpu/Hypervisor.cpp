@@ -0,0 +1,95 @@
+﻿#include "Hypervisor.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HYPERVISOR_HAS_CPUID
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if !defined(_WIN32) && !defined(HYPERVISOR_HAS_CPUID)
+#include <fstream>
+#endif
+
+namespace {
+    struct KnownVendor {
+        const char* signature;
+        const char* name;
+    };
+
+    const KnownVendor kKnownVendors[] = {
+        { "Microsoft Hv", "Hyper-V" },
+        { "KVMKVMKVM",    "KVM" },
+        { "VMwareVMware", "VMware" },
+        { "XenVMMXenVMM", "Xen" },
+        { "VBoxVBoxVBox", "VirtualBox" },
+        { "TCGTCGTCGTCG", "QEMU" },
+        { " lrpepyh  vr", "Parallels" },
+        { "ACRNACRNACRN", "ACRN" },
+        { "bhyve bhyve ", "bhyve" },
+        { "QNXQVMBSQG",   "QNX" },
+    };
+
+#ifdef HYPERVISOR_HAS_CPUID
+    void Cpuid(unsigned leaf, unsigned regs[4]) {
+#ifdef _MSC_VER
+        int r[4];
+        __cpuid(r, static_cast<int>(leaf));
+        for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(r[i]);
+#else
+        // 不能用 __get_cpuid：它按基本叶的最大值检查，0x40000000 会被拒绝
+        __cpuid(leaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+#endif
+}
+
+const HypervisorInfo& HypervisorInfo::Get() {
+    static const HypervisorInfo info = Detect();
+    return info;
+}
+
+HypervisorInfo HypervisorInfo::Detect() {
+    HypervisorInfo info;
+#ifdef HYPERVISOR_HAS_CPUID
+    unsigned regs[4] = {};
+    Cpuid(1, regs);
+    info.present = (regs[2] & (1u << 31)) != 0;
+    if (!info.present) return info;
+
+    Cpuid(0x40000000, regs);
+    info.maxLeaf = regs[0];
+    char signature[13] = {};
+    memcpy(signature + 0, &regs[1], 4);
+    memcpy(signature + 4, &regs[2], 4);
+    memcpy(signature + 8, &regs[3], 4);
+    info.vendorId.assign(signature, strnlen(signature, 12));
+
+    // Hyper-V 特性叶：EBX 为分区权限，bit 0 CreatePartitions 只授予根分区
+    if (info.vendorId == "Microsoft Hv" && info.maxLeaf >= 0x40000003) {
+        Cpuid(0x40000003, regs);
+        if (regs[1] & 1u) {
+            info.rootPartition = true;
+            info.present = false;
+        }
+    }
+#elif !defined(_WIN32)
+    // 非 x86 平台（如 ARM 云主机）退回 sysfs
+    std::ifstream typeFile("/sys/hypervisor/type");
+    if (typeFile >> info.vendorId) info.present = true;
+#endif
+
+    // 根分区按物理机处理，不给出 Hypervisor 名称，避免与 present = false 矛盾
+    if (info.rootPartition) return info;
+    info.name = info.vendorId;
+    for (const auto& vendor : kKnownVendors) {
+        if (info.vendorId == vendor.signature) {
+            info.name = vendor.name;
+            break;
+        }
+    }
+    return info;
+}
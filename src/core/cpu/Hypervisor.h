@@ -0,0 +1,21 @@
+﻿#pragma once
+#include <string>
+
+// 虚拟机监控程序（Hypervisor）检测
+// CPUID leaf 1 ECX bit 31 表示运行在虚拟机中，leaf 0x40000000 的 EBX/ECX/EDX 为厂商签名；
+// 开启 Hyper-V / VBS / HVCI 的物理机本身运行在根分区中，同样置位 bit 31 且签名为 "Microsoft Hv"，
+// 以 leaf 0x40000003 EBX bit 0（CreatePartitions，只有根分区拥有）区分，根分区不算客户机；
+// 结果在首次调用时检测并缓存，之后不再执行 CPUID（在虚拟机中 CPUID 会触发 VM exit）
+struct HypervisorInfo {
+    bool present = false;       // 是否运行在虚拟机中（作为客户机）
+    bool rootPartition = false; // 是否为 Hyper-V 根分区（开启 VBS/HVCI 的物理机），此时 present 为 false
+    std::string vendorId;       // 12字节厂商签名，如 "Microsoft Hv"、"KVMKVMKVM"
+    std::string name;           // 可读名称，如 "Hyper-V"、"KVM"，未知厂商时与签名相同；根分区为空
+    unsigned maxLeaf = 0;       // Hypervisor CPUID 最大叶号
+
+    // 返回缓存的检测结果（线程安全）
+    static const HypervisorInfo& Get();
+
+private:
+    static HypervisorInfo Detect();
+};
@@ -0,0 +1,330 @@
+﻿#include "SchedulerStats.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <pdhmsg.h>
+#include <cwctype>
+#pragma comment(lib, "pdh.lib")
+#endif
+
+SchedulerStats::SchedulerStats() {
+#ifdef _WIN32
+    available = InitializeCounters();
+#else
+    // /proc/interrupts 在多核主机上可达数百KB，预留较大初始缓冲区
+    bool statOk = statFile.Open("/proc/stat", 16384);
+    loadAvgFile.Open("/proc/loadavg", 256);
+    interruptsFile.Open("/proc/interrupts", 65536);
+    available = statOk;
+#endif
+}
+
+SchedulerStats::~SchedulerStats() {
+#ifdef _WIN32
+    CleanupCounters();
+#endif
+}
+
+#ifdef _WIN32
+
+bool SchedulerStats::InitializeCounters() {
+    if (PdhOpenQuery(NULL, 0, &query) != ERROR_SUCCESS) {
+        Logger::Error("调度器统计: 无法打开性能计数器查询");
+        query = nullptr;
+        return false;
+    }
+
+    // 使用英文计数器名称以避免本地化问题
+    bool ok = PdhAddEnglishCounterW(query, L"\\System\\Context Switches/sec", 0, &contextSwitchCounter) == ERROR_SUCCESS;
+    ok = PdhAddEnglishCounterW(query, L"\\Processor(_Total)\\Interrupts/sec", 0, &interruptCounter) == ERROR_SUCCESS && ok;
+    ok = PdhAddEnglishCounterW(query, L"\\System\\Processor Queue Length", 0, &queueLengthCounter) == ERROR_SUCCESS && ok;
+    ok = PdhAddEnglishCounterW(query, L"\\Processor(*)\\% Processor Time", 0, &coreUsageCounter) == ERROR_SUCCESS && ok;
+    ok = PdhAddEnglishCounterW(query, L"\\Processor(*)\\Interrupts/sec", 0, &coreInterruptCounter) == ERROR_SUCCESS && ok;
+    if (!ok) {
+        Logger::Warn("调度器统计: 部分性能计数器添加失败，相关字段将保持为0");
+    }
+
+    // 速率型计数器需要两次采样，这里先采一次作为基线
+    if (PdhCollectQueryData(query) != ERROR_SUCCESS) {
+        Logger::Error("调度器统计: 无法收集性能计数器基线数据");
+        CleanupCounters();
+        return false;
+    }
+    lastSampleNs = CounterMath::MonotonicNowNs();
+    Logger::Debug("调度器统计性能计数器初始化完成");
+    return true;
+}
+
+void SchedulerStats::CleanupCounters() {
+    if (query) {
+        PdhCloseQuery(query);
+        query = nullptr;
+    }
+}
+
+bool SchedulerStats::ReadCounterArray(PDH_HCOUNTER counter, bool isUsage) {
+    if (!counter) return false;
+    DWORD bufferSize = static_cast<DWORD>(counterArrayBuffer.size());
+    DWORD itemCount = 0;
+    PDH_STATUS status = PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, &bufferSize, &itemCount,
+        counterArrayBuffer.empty() ? nullptr : reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data()));
+    if (status == PDH_MORE_DATA) {
+        counterArrayBuffer.resize(bufferSize);
+        status = PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, &bufferSize, &itemCount,
+            reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data()));
+    }
+    if (status != ERROR_SUCCESS) return false;
+
+    auto* items = reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data());
+    for (DWORD i = 0; i < itemCount; ++i) {
+        const wchar_t* name = items[i].szName;
+        if (!name || !iswdigit(name[0])) continue; // 跳过 _Total
+        size_t core = static_cast<size_t>(_wtoi(name));
+        if (core >= 4096) continue;
+        if (core >= snapshot.cores.size()) snapshot.cores.resize(core + 1);
+        double value = items[i].FmtValue.doubleValue;
+        if (items[i].FmtValue.CStatus != PDH_CSTATUS_VALID_DATA && items[i].FmtValue.CStatus != PDH_CSTATUS_NEW_DATA) continue;
+        if (isUsage) {
+            snapshot.cores[core].usage = (std::min)((std::max)(value, 0.0), 100.0);
+        } else {
+            snapshot.cores[core].interruptsPerSec = (std::max)(value, 0.0);
+        }
+    }
+    return true;
+}
+
+// Windows 没有负载均值，按 Linux 内核相同的指数衰减公式由“运行队列长度 + 正在运行的线程数”估算
+void SchedulerStats::UpdateLoadAverages(double runnable, double elapsedSeconds) {
+    auto decay = [elapsedSeconds](double period) { return std::exp(-elapsedSeconds / period); };
+    if (!hasBaseline) {
+        snapshot.loadAverage1 = snapshot.loadAverage5 = snapshot.loadAverage15 = runnable;
+        return;
+    }
+    double e1 = decay(60.0), e5 = decay(300.0), e15 = decay(900.0);
+    snapshot.loadAverage1 = snapshot.loadAverage1 * e1 + runnable * (1.0 - e1);
+    snapshot.loadAverage5 = snapshot.loadAverage5 * e5 + runnable * (1.0 - e5);
+    snapshot.loadAverage15 = snapshot.loadAverage15 * e15 + runnable * (1.0 - e15);
+}
+
+bool SchedulerStats::Update() {
+    if (!available || !query) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    PDH_STATUS status = PdhCollectQueryData(query);
+    if (status != ERROR_SUCCESS) {
+        Logger::Warn("调度器统计: 收集性能计数器数据失败，错误代码: " + std::to_string(status));
+        return false;
+    }
+    double elapsedSeconds = (now - lastSampleNs) / 1e9;
+    lastSampleNs = now;
+
+    auto readDouble = [](PDH_HCOUNTER counter, double& out) {
+        if (!counter) return false;
+        PDH_FMT_COUNTERVALUE value;
+        if (PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, NULL, &value) != ERROR_SUCCESS) return false;
+        if (value.CStatus != PDH_CSTATUS_VALID_DATA && value.CStatus != PDH_CSTATUS_NEW_DATA) return false;
+        out = value.doubleValue;
+        return true;
+    };
+
+    double value = 0.0;
+    if (readDouble(contextSwitchCounter, value)) snapshot.contextSwitchesPerSec = value;
+    if (readDouble(interruptCounter, value)) snapshot.interruptsPerSec = value;
+    double queueLength = 0.0;
+    if (readDouble(queueLengthCounter, queueLength)) snapshot.runnableTasks = static_cast<uint32_t>(queueLength);
+
+    ReadCounterArray(coreUsageCounter, true);
+    ReadCounterArray(coreInterruptCounter, false);
+
+    // Windows 客户机内没有 steal 计数器，扣除 steal 后的使用率即为原使用率
+    double runningThreads = 0.0;
+    for (auto& core : snapshot.cores) {
+        core.stealAdjustedUsage = core.usage;
+        runningThreads += core.usage / 100.0;
+    }
+    snapshot.stealAdjustedUsage = snapshot.cores.empty() ? 0.0 : runningThreads * 100.0 / snapshot.cores.size();
+    UpdateLoadAverages(queueLength + runningThreads, elapsedSeconds);
+
+    hasBaseline = true;
+    return true;
+}
+
+#else
+
+bool SchedulerStats::ParseProcStat(uint64_t& ctxt, uint64_t& intr, uint64_t& processes) {
+    if (!statFile.Read()) return false;
+    const char* p = statFile.Data();
+    const char* end = statFile.End();
+
+    for (auto& t : cpuTimes) t = CpuTimes{};
+    while (p < end) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+
+        if (TextScan::StartsWith(line, p, "cpu", 3)) {
+            const char* q = line + 3;
+            uint64_t cpuIndex = 0;
+            if (!TextScan::ParseU64(q, p, cpuIndex)) continue; // 汇总行 "cpu " 由每核心数据累加得到
+            if (cpuIndex >= 4096) continue;
+            // user nice system idle iowait irq softirq steal guest guest_nice
+            uint64_t fields[10] = {};
+            for (int i = 0; i < 10; ++i) {
+                if (!TextScan::NextU64(q, p, fields[i])) break;
+            }
+            // guest/guest_nice 已计入 user/nice，不重复累加
+            uint64_t total = fields[0] + fields[1] + fields[2] + fields[3] + fields[4] + fields[5] + fields[6] + fields[7];
+            uint64_t idle = fields[3] + fields[4];
+            if (cpuIndex >= cpuTimes.size()) cpuTimes.resize(cpuIndex + 1);
+            cpuTimes[cpuIndex].total = total;
+            cpuTimes[cpuIndex].busy = total - idle;
+            cpuTimes[cpuIndex].steal = fields[7];
+            cpuTimes[cpuIndex].guest = fields[8] + fields[9];
+        } else if (TextScan::StartsWith(line, p, "ctxt ", 5)) {
+            const char* q = line + 5;
+            TextScan::NextU64(q, p, ctxt);
+        } else if (TextScan::StartsWith(line, p, "intr ", 5)) {
+            // intr 行包含每个中断号的计数（可能上千列），只取第一个总数
+            const char* q = line + 5;
+            TextScan::NextU64(q, p, intr);
+        } else if (TextScan::StartsWith(line, p, "processes ", 10)) {
+            const char* q = line + 10;
+            TextScan::NextU64(q, p, processes);
+        } else if (TextScan::StartsWith(line, p, "procs_running ", 14)) {
+            const char* q = line + 14;
+            uint64_t v = 0;
+            if (TextScan::NextU64(q, p, v)) snapshot.runnableTasks = static_cast<uint32_t>(v);
+        } else if (TextScan::StartsWith(line, p, "procs_blocked ", 14)) {
+            const char* q = line + 14;
+            uint64_t v = 0;
+            if (TextScan::NextU64(q, p, v)) snapshot.blockedTasks = static_cast<uint32_t>(v);
+        }
+    }
+    return true;
+}
+
+bool SchedulerStats::ParseLoadAvg() {
+    if (!loadAvgFile.Read()) return false;
+    const char* p = loadAvgFile.Data();
+    const char* end = loadAvgFile.End();
+    double values[3] = {};
+    for (double& v : values) {
+        p = TextScan::SkipSpaces(p, end);
+        if (!TextScan::ParseFixed(p, end, v)) return false;
+    }
+    snapshot.loadAverage1 = values[0];
+    snapshot.loadAverage5 = values[1];
+    snapshot.loadAverage15 = values[2];
+    return true;
+}
+
+// /proc/interrupts 为“中断号 × CPU”矩阵，逐行把每列累加到对应核心
+// 全程只在预分配的数组上工作，不构造任何字符串
+bool SchedulerStats::ParseInterrupts() {
+    if (!interruptsFile.Read()) return false;
+    const char* p = interruptsFile.Data();
+    const char* end = interruptsFile.End();
+
+    // 表头 "CPU0 CPU1 ..."，离线核心不会出现，因此列号与核心编号需要单独映射
+    const char* header = p;
+    p = TextScan::NextLine(p, end);
+    interruptColumns.clear();
+    for (const char* q = TextScan::SkipSpaces(header, p); q < p && *q != '\n'; q = TextScan::SkipSpaces(q, p)) {
+        if (TextScan::StartsWith(q, p, "CPU", 3)) {
+            q += 3;
+            uint64_t cpuIndex = 0;
+            if (TextScan::ParseU64(q, p, cpuIndex) && cpuIndex < 4096) {
+                interruptColumns.push_back(static_cast<int>(cpuIndex));
+                continue;
+            }
+        }
+        q = TextScan::SkipToken(q, p);
+    }
+    if (interruptColumns.empty()) return false;
+
+    size_t maxCpu = static_cast<size_t>(*std::max_element(interruptColumns.begin(), interruptColumns.end())) + 1;
+    if (irqTotals.size() < maxCpu) irqTotals.resize(maxCpu);
+    std::fill(irqTotals.begin(), irqTotals.end(), 0);
+
+    const size_t columns = interruptColumns.size();
+    while (p < end) {
+        const char* lineEnd = TextScan::NextLine(p, end);
+        const void* colon = memchr(p, ':', static_cast<size_t>(lineEnd - p));
+        if (colon) {
+            const char* q = static_cast<const char*>(colon) + 1;
+            // ERR/MIS 等汇总行只有一列，遇到非数字即停止
+            for (size_t c = 0; c < columns; ++c) {
+                uint64_t count = 0;
+                if (!TextScan::NextU64(q, lineEnd, count)) break;
+                irqTotals[static_cast<size_t>(interruptColumns[c])] += count;
+            }
+        }
+        p = lineEnd;
+    }
+    return true;
+}
+
+bool SchedulerStats::Update() {
+    if (!available) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t ctxt = 0, intr = 0, processes = 0;
+    if (!ParseProcStat(ctxt, intr, processes)) return false;
+    ParseLoadAvg();
+    bool haveInterrupts = ParseInterrupts();
+
+    uint64_t elapsedNs = now - lastSampleNs;
+    size_t coreCount = (std::max)(cpuTimes.size(), irqTotals.size());
+    if (snapshot.cores.size() < coreCount) snapshot.cores.resize(coreCount);
+
+    if (hasBaseline && elapsedNs > 0) {
+        snapshot.contextSwitchesPerSec = CounterMath::PerSecond(CounterMath::Delta(prevContextSwitches, ctxt), elapsedNs);
+        snapshot.interruptsPerSec = CounterMath::PerSecond(CounterMath::Delta(prevInterrupts, intr), elapsedNs);
+        snapshot.processesCreatedPerSec = CounterMath::PerSecond(CounterMath::Delta(prevProcesses, processes), elapsedNs);
+
+        uint64_t sumTotal = 0, sumBusy = 0, sumSteal = 0, sumGuest = 0;
+        for (size_t i = 0; i < cpuTimes.size() && i < prevCpuTimes.size(); ++i) {
+            uint64_t dTotal = CounterMath::SaturatingDelta(prevCpuTimes[i].total, cpuTimes[i].total);
+            uint64_t dBusy = CounterMath::SaturatingDelta(prevCpuTimes[i].busy, cpuTimes[i].busy);
+            uint64_t dSteal = (std::min)(CounterMath::SaturatingDelta(prevCpuTimes[i].steal, cpuTimes[i].steal), dBusy);
+            uint64_t dGuest = CounterMath::SaturatingDelta(prevCpuTimes[i].guest, cpuTimes[i].guest);
+            auto& core = snapshot.cores[i];
+            core.usage = dTotal ? (std::min)(100.0 * dBusy / dTotal, 100.0) : 0.0;
+            core.stealPercent = dTotal ? (std::min)(100.0 * dSteal / dTotal, 100.0) : 0.0;
+            core.guestPercent = dTotal ? (std::min)(100.0 * dGuest / dTotal, 100.0) : 0.0;
+            core.stealAdjustedUsage = dTotal ? (std::min)(100.0 * (dBusy - dSteal) / dTotal, 100.0) : 0.0;
+            sumTotal += dTotal;
+            sumBusy += dBusy;
+            sumSteal += dSteal;
+            sumGuest += dGuest;
+        }
+        snapshot.stealPercent = sumTotal ? 100.0 * sumSteal / sumTotal : 0.0;
+        snapshot.guestPercent = sumTotal ? 100.0 * sumGuest / sumTotal : 0.0;
+        snapshot.stealAdjustedUsage = sumTotal ? 100.0 * (sumBusy - sumSteal) / sumTotal : 0.0;
+        if (haveInterrupts) {
+            // 设备移除时对应行消失，汇总值可能变小，按0处理
+            for (size_t i = 0; i < irqTotals.size() && i < prevIrqTotals.size(); ++i) {
+                snapshot.cores[i].interruptsPerSec =
+                    CounterMath::PerSecond(CounterMath::SaturatingDelta(prevIrqTotals[i], irqTotals[i]), elapsedNs);
+            }
+        }
+    }
+
+    prevContextSwitches = ctxt;
+    prevInterrupts = intr;
+    prevProcesses = processes;
+    prevCpuTimes.swap(cpuTimes);
+    cpuTimes.resize(prevCpuTimes.size());
+    if (haveInterrupts) {
+        prevIrqTotals.swap(irqTotals);
+        irqTotals.resize(prevIrqTotals.size());
+    }
+    lastSampleNs = now;
+    hasBaseline = true;
+    return true;
+}
+
+#endif
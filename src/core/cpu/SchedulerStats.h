@@ -0,0 +1,99 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <pdh.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// 调度器与中断活动统计
+// 使用率本身无法解释延迟问题，这里补充上下文切换/中断/进程创建速率、可运行与阻塞任务数、负载均值，
+// 并按逻辑核心输出使用率和中断分布（与 CPU 使用率共用每核心区段）
+// 作为虚拟机客户机运行时，另外给出被宿主机挪用的 steal 时间、运行嵌套客户机的 guest 时间以及扣除 steal 后的使用率
+// Linux: /proc/stat、/proc/loadavg、/proc/interrupts（常驻 fd + pread）
+// Windows: PDH 计数器（System / Processor 对象）
+class SchedulerStats {
+public:
+    struct CoreSample {
+        double usage = 0.0;              // 使用率（%）
+        double interruptsPerSec = 0.0;   // 中断速率（次/秒）
+        double stealPercent = 0.0;       // steal 时间占比（%），Windows 为0
+        double guestPercent = 0.0;       // guest 时间占比（%，已包含在 usage 中），Windows 为0
+        double stealAdjustedUsage = 0.0; // 扣除 steal 后本核心实际执行工作的时间占比（%）
+    };
+
+    struct Snapshot {
+        double contextSwitchesPerSec = 0.0;   // 上下文切换（次/秒）
+        double interruptsPerSec = 0.0;        // 中断（次/秒）
+        double processesCreatedPerSec = 0.0;  // 新建进程（个/秒），Windows 无对应计数器时为0
+        uint32_t runnableTasks = 0;           // 可运行任务数（运行队列长度）
+        uint32_t blockedTasks = 0;            // 阻塞在I/O上的任务数，Windows 不提供时为0
+        double loadAverage1 = 0.0;            // 1/5/15 分钟负载均值
+        double loadAverage5 = 0.0;
+        double loadAverage15 = 0.0;
+        double stealPercent = 0.0;            // 全部核心的 steal 时间占比（%）
+        double guestPercent = 0.0;            // 全部核心的 guest 时间占比（%）
+        double stealAdjustedUsage = 0.0;      // 全部核心扣除 steal 后的使用率（%）
+        std::vector<CoreSample> cores;        // 按逻辑核心编号索引
+    };
+
+    SchedulerStats();
+    ~SchedulerStats();
+
+    SchedulerStats(const SchedulerStats&) = delete;
+    SchedulerStats& operator=(const SchedulerStats&) = delete;
+
+    // 采样一次并基于与上次采样的差值计算速率；首次调用只建立基线
+    bool Update();
+    const Snapshot& GetSnapshot() const { return snapshot; }
+    bool IsAvailable() const { return available; }
+
+private:
+    Snapshot snapshot;
+    bool available = false;
+    bool hasBaseline = false;
+    uint64_t lastSampleNs = 0;
+
+#ifdef _WIN32
+    bool InitializeCounters();
+    void CleanupCounters();
+    bool ReadCounterArray(PDH_HCOUNTER counter, bool isUsage);
+    void UpdateLoadAverages(double runnable, double elapsedSeconds);
+
+    PDH_HQUERY query = nullptr;
+    PDH_HCOUNTER contextSwitchCounter = nullptr;
+    PDH_HCOUNTER interruptCounter = nullptr;
+    PDH_HCOUNTER queueLengthCounter = nullptr;
+    PDH_HCOUNTER coreUsageCounter = nullptr;
+    PDH_HCOUNTER coreInterruptCounter = nullptr;
+    std::vector<BYTE> counterArrayBuffer;   // PdhGetFormattedCounterArray 复用缓冲区
+#else
+    struct CpuTimes {
+        uint64_t busy = 0;     // 含 steal
+        uint64_t total = 0;
+        uint64_t steal = 0;
+        uint64_t guest = 0;    // guest + guest_nice
+    };
+
+    bool ParseProcStat(uint64_t& ctxt, uint64_t& intr, uint64_t& processes);
+    bool ParseLoadAvg();
+    bool ParseInterrupts();
+
+    ProcFile statFile;
+    ProcFile loadAvgFile;
+    ProcFile interruptsFile;
+
+    std::vector<CpuTimes> cpuTimes;          // 本次 /proc/stat 每核心累计时间
+    std::vector<CpuTimes> prevCpuTimes;
+    std::vector<uint64_t> irqTotals;         // 本次 /proc/interrupts 每核心中断累计
+    std::vector<uint64_t> prevIrqTotals;
+    std::vector<int> interruptColumns;       // /proc/interrupts 列号 -> 逻辑核心编号
+    uint64_t prevContextSwitches = 0;
+    uint64_t prevInterrupts = 0;
+    uint64_t prevProcesses = 0;
+#endif
+};
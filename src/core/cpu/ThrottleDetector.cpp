@@ -0,0 +1,303 @@
+﻿#include "ThrottleDetector.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <pdhmsg.h>
+#pragma comment(lib, "pdh.lib")
+#else
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <set>
+#include <utility>
+#endif
+
+namespace {
+    // 封装功耗达到 PL1 的该比例即视为处于功耗墙（RAPL 平均窗口内功耗会略低于上限）
+    constexpr double kPowerLimitRatio = 0.97;
+    // % Performance Limit 正常为 100，留出格式化误差
+    constexpr double kPerformanceLimitThreshold = 99.5;
+
+    // NVML nvmlClocksThrottleReason 位
+    constexpr uint64_t kNvmlSwPowerCap = 0x4;
+    constexpr uint64_t kNvmlHwSlowdown = 0x8;
+    constexpr uint64_t kNvmlSwThermalSlowdown = 0x20;
+    constexpr uint64_t kNvmlHwThermalSlowdown = 0x40;
+    constexpr uint64_t kNvmlHwPowerBrakeSlowdown = 0x80;
+
+    // 空闲、应用频率设置、同步加速、显示频率设置不算降频
+    uint32_t GpuReasons(uint64_t nvmlReasons) {
+        uint32_t reasons = 0;
+        if (nvmlReasons & (kNvmlSwThermalSlowdown | kNvmlHwThermalSlowdown)) reasons |= ThrottleDetector::kReasonThermal;
+        if (nvmlReasons & kNvmlSwPowerCap) reasons |= ThrottleDetector::kReasonPowerLimit;
+        if (nvmlReasons & (kNvmlHwSlowdown | kNvmlHwThermalSlowdown | kNvmlHwPowerBrakeSlowdown)) reasons |= ThrottleDetector::kReasonHardware;
+        return reasons;
+    }
+
+    uint64_t UnixNowMs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+#ifndef _WIN32
+    std::string ReadLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        while (!line.empty() && (line.back() == '\n' || line.back() == ' ')) line.pop_back();
+        return line;
+    }
+
+    bool ReadU64(const std::string& path, uint64_t& value) {
+        const std::string text = ReadLine(path);
+        const char* p = text.c_str();
+        return TextScan::ParseU64(p, p + text.size(), value);
+    }
+
+    // 目录中 prefix 后接纯数字的条目，按数字排序
+    std::vector<std::pair<unsigned long, std::string>> ListNumbered(const std::string& directory, const char* prefix) {
+        std::vector<std::pair<unsigned long, std::string>> entries;
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) return entries;
+        size_t prefixLength = strlen(prefix);
+        while (dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            if (strncmp(name, prefix, prefixLength) != 0 || name[prefixLength] == '\0') continue;
+            char* digitsEnd = nullptr;
+            unsigned long index = strtoul(name + prefixLength, &digitsEnd, 10);
+            if (*digitsEnd != '\0' || digitsEnd == name + prefixLength) continue;
+            entries.emplace_back(index, name);
+        }
+        closedir(dir);
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    // 优先打开累计时间（内核 5.19 起），旧内核只有累计次数
+    bool OpenThrottleCounter(ProcFile& file, const std::string& directory, const char* scope) {
+        const std::string base = directory + "/" + scope + "_throttle_";
+        return file.Open(base + "total_time_ms", 32) || file.Open(base + "count", 32);
+    }
+#endif
+}
+
+#ifdef _WIN32
+
+ThrottleDetector::ThrottleDetector(const std::string&) : cpuPowerLimitWatts(std::numeric_limits<double>::quiet_NaN()) {
+    if (PdhOpenQuery(NULL, 0, &query) != ERROR_SUCCESS) {
+        Logger::Warn("降频检测: 无法打开性能计数器查询，CPU 降频检测不可用");
+        query = nullptr;
+        return;
+    }
+    // 使用英文计数器名称以避免本地化问题；Processor Information 对象在 Windows 7 以下不存在
+    bool ok = PdhAddEnglishCounterW(query, L"\\Processor Information(_Total)\\% Performance Limit", 0, &performanceLimitCounter) == ERROR_SUCCESS;
+    PdhAddEnglishCounterW(query, L"\\Processor Information(_Total)\\Processor Frequency", 0, &frequencyCounter);
+    PdhAddEnglishCounterW(query, L"\\Processor Information(*)\\% Processor Performance", 0, &corePerformanceCounter);
+    if (!ok || PdhCollectQueryData(query) != ERROR_SUCCESS) {
+        Logger::Warn("降频检测: % Performance Limit 计数器不可用，CPU 降频检测不可用");
+        PdhCloseQuery(query);
+        query = nullptr;
+        return;
+    }
+    available = true;
+}
+
+ThrottleDetector::~ThrottleDetector() {
+    if (query) {
+        PdhCloseQuery(query);
+        query = nullptr;
+    }
+}
+
+uint32_t ThrottleDetector::ReadCpuReasons(const CpuReadings&) {
+    if (!query || PdhCollectQueryData(query) != ERROR_SUCCESS) return 0;
+    PDH_FMT_COUNTERVALUE value;
+    if (PdhGetFormattedCounterValue(performanceLimitCounter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, NULL, &value) != ERROR_SUCCESS) return 0;
+    if (value.CStatus != PDH_CSTATUS_VALID_DATA && value.CStatus != PDH_CSTATUS_NEW_DATA) return 0;
+    return value.doubleValue < kPerformanceLimitThreshold ? kReasonPlatform : 0;
+}
+
+// 有效频率 = 标称频率（Processor Frequency）× % Processor Performance / 100，后者已计入睿频与降频
+void ThrottleDetector::ReadCpuClocks(double& average, double& minimum) {
+    average = minimum = std::numeric_limits<double>::quiet_NaN();
+    if (!query || !frequencyCounter || !corePerformanceCounter) return;
+    PDH_FMT_COUNTERVALUE frequency;
+    if (PdhGetFormattedCounterValue(frequencyCounter, PDH_FMT_DOUBLE, NULL, &frequency) != ERROR_SUCCESS) return;
+
+    DWORD bufferSize = static_cast<DWORD>(counterArrayBuffer.size());
+    DWORD itemCount = 0;
+    PDH_STATUS status = PdhGetFormattedCounterArrayW(corePerformanceCounter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, &bufferSize, &itemCount,
+        counterArrayBuffer.empty() ? nullptr : reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data()));
+    if (status == PDH_MORE_DATA) {
+        counterArrayBuffer.resize(bufferSize);
+        status = PdhGetFormattedCounterArrayW(corePerformanceCounter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, &bufferSize, &itemCount,
+            reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data()));
+    }
+    if (status != ERROR_SUCCESS) return;
+
+    auto* items = reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data());
+    double sum = 0.0;
+    size_t count = 0;
+    for (DWORD i = 0; i < itemCount; ++i) {
+        // 实例名为 "组,核心"，跳过 "_Total" 与 "0,_Total"
+        if (!items[i].szName || wcsstr(items[i].szName, L"_Total")) continue;
+        if (items[i].FmtValue.CStatus != PDH_CSTATUS_VALID_DATA && items[i].FmtValue.CStatus != PDH_CSTATUS_NEW_DATA) continue;
+        double clock = frequency.doubleValue * items[i].FmtValue.doubleValue / 100.0;
+        sum += clock;
+        minimum = count == 0 ? clock : (std::min)(minimum, clock);
+        ++count;
+    }
+    if (count > 0) average = sum / count;
+}
+
+#else
+
+ThrottleDetector::ThrottleDetector(const std::string& sysfsRoot) : cpuPowerLimitWatts(std::numeric_limits<double>::quiet_NaN()) {
+    const std::string cpuDirectory = sysfsRoot + "/devices/system/cpu";
+    // thermal_throttle 下的 core_* 由同一物理核心的超线程共享，package_* 由同一封装的全部核心共享
+    std::set<std::pair<uint64_t, uint64_t>> seenCores;
+    std::set<uint64_t> seenPackages;
+    for (const auto& cpu : ListNumbered(cpuDirectory, "cpu")) {
+        const std::string base = cpuDirectory + "/" + cpu.second;
+        uint64_t package = 0;
+        uint64_t core = cpu.first;
+        ReadU64(base + "/topology/physical_package_id", package);
+        ReadU64(base + "/topology/core_id", core);
+        const std::string throttle = base + "/thermal_throttle";
+        ProcFile counter;
+        if (seenCores.insert({ package, core }).second && OpenThrottleCounter(counter, throttle, "core")) {
+            throttleCounters.push_back(std::move(counter));
+        }
+        if (seenPackages.insert(package).second && OpenThrottleCounter(counter, throttle, "package")) {
+            throttleCounters.push_back(std::move(counter));
+        }
+        ProcFile frequency;
+        if (frequency.Open(base + "/cpufreq/scaling_cur_freq", 32)) coreFrequencies.push_back(std::move(frequency));
+    }
+    lastThrottle.assign(throttleCounters.size(), 0);
+
+    // 第一个封装的 PL1（长时功耗上限），与传感器注册表中的 CPU 代表功耗读数对应
+    const std::string powercap = sysfsRoot + "/class/powercap";
+    for (const auto& zone : ListNumbered(powercap, "intel-rapl:")) {
+        const std::string base = powercap + "/" + zone.second;
+        if (ReadLine(base + "/name").compare(0, 7, "package") != 0) continue;
+        uint64_t limit = 0;
+        if (ReadU64(base + "/constraint_0_power_limit_uw", limit) && limit > 0) cpuPowerLimitWatts = limit / 1000000.0;
+        break;
+    }
+    available = !throttleCounters.empty() || !std::isnan(cpuPowerLimitWatts);
+}
+
+ThrottleDetector::~ThrottleDetector() = default;
+
+uint32_t ThrottleDetector::ReadCpuReasons(const CpuReadings& cpu) {
+    uint32_t reasons = 0;
+    bool increased = false;
+    for (size_t i = 0; i < throttleCounters.size(); ++i) {
+        ProcFile& counter = throttleCounters[i];
+        uint64_t value = 0;
+        const char* p = counter.Read() ? counter.Data() : nullptr;
+        if (!p || !TextScan::ParseU64(p, counter.End(), value)) continue;
+        if (hasBaseline && value > lastThrottle[i]) increased = true;
+        lastThrottle[i] = value;
+    }
+    hasBaseline = true;
+    if (increased) reasons |= kReasonThermal;
+    if (!std::isnan(cpuPowerLimitWatts) && !std::isnan(cpu.packagePowerWatts) &&
+        cpu.packagePowerWatts >= cpuPowerLimitWatts * kPowerLimitRatio) {
+        reasons |= kReasonPowerLimit;
+    }
+    return reasons;
+}
+
+void ThrottleDetector::ReadCpuClocks(double& average, double& minimum) {
+    average = minimum = std::numeric_limits<double>::quiet_NaN();
+    double sum = 0.0;
+    size_t count = 0;
+    for (ProcFile& file : coreFrequencies) {
+        uint64_t kHz = 0;
+        const char* p = file.Read() ? file.Data() : nullptr;
+        if (!p || !TextScan::ParseU64(p, file.End(), kHz)) continue;
+        double clock = kHz / 1000.0;
+        sum += clock;
+        minimum = count == 0 ? clock : (std::min)(minimum, clock);
+        ++count;
+    }
+    if (count > 0) average = sum / count;
+}
+
+#endif
+
+bool ThrottleDetector::Advance(State& state, uint32_t reasons, uint64_t nowNs, Event& event) {
+    state.currentReasons = reasons;
+    if (reasons != 0) {
+        state.quietTicks = 0;
+        if (state.active) {
+            state.accumulatedReasons |= reasons;
+            return false;
+        }
+        state.active = true;
+        state.startNs = nowNs;
+        state.accumulatedReasons = reasons;
+        event.type = EventType::Start;
+        event.reasons = reasons;
+        event.durationMs = 0;
+        return true;
+    }
+    if (!state.active) return false;
+    if (state.quietTicks == 0) state.clearNs = nowNs;
+    if (++state.quietTicks < kStopTicks) return false;
+    state.active = false;
+    event.type = EventType::Stop;
+    event.reasons = state.accumulatedReasons;
+    event.durationMs = (state.clearNs - state.startNs) / 1000000ULL;
+    return true;
+}
+
+void ThrottleDetector::Push(Event& event) {
+    event.sequence = ++sequence;
+    event.timestampMs = UnixNowMs();
+    ring[(event.sequence - 1) % kRingSize] = event;
+}
+
+void ThrottleDetector::Update(const CpuReadings& cpu, const std::vector<GpuTelemetry::Device>* gpus) {
+    const uint64_t now = CounterMath::MonotonicNowNs();
+    const double unavailable = std::numeric_limits<double>::quiet_NaN();
+
+    if (available) {
+        Event event;
+        if (Advance(cpuState, ReadCpuReasons(cpu), now, event)) {
+            event.source = Source::Cpu;
+            event.device = 0;
+            event.temperature = cpu.packageTemperature;
+            ReadCpuClocks(event.clockMHz, event.minClockMHz);
+            event.powerWatts = cpu.packagePowerWatts;
+            event.powerLimitWatts = cpuPowerLimitWatts;
+            Push(event);
+        }
+    }
+
+    if (!gpus) return;
+    if (gpuStates.size() != gpus->size()) gpuStates.resize(gpus->size());
+    for (size_t i = 0; i < gpus->size(); ++i) {
+        const GpuTelemetry::Device& device = (*gpus)[i];
+        // 掉线的 GPU 没有降频信号，正在进行的事件按信号消失处理
+        Event event;
+        if (!Advance(gpuStates[i], device.valid ? GpuReasons(device.throttleReasons) : 0, now, event)) continue;
+        event.source = Source::Gpu;
+        event.device = static_cast<uint16_t>(i);
+        event.temperature = device.valid ? static_cast<double>(device.temperature) : unavailable;
+        event.clockMHz = device.valid ? static_cast<double>(device.graphicsClockMHz) : unavailable;
+        event.minClockMHz = event.clockMHz;
+        event.powerWatts = device.valid ? device.powerWatts : unavailable;
+        event.powerLimitWatts = device.valid && device.powerLimitWatts > 0.0 ? device.powerLimitWatts : unavailable;
+        Push(event);
+    }
+}
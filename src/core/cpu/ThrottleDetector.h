@@ -0,0 +1,110 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../gpu/GpuTelemetry.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <pdh.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// 降频检测：把硬件给出的降频信号整理为离散的开始/结束事件，写入固定大小的环形缓冲区
+// CPU 信号：Linux 为 thermal_throttle 累计计数（优先 *_total_time_ms，按物理核心与封装去重）与 RAPL PL1 功耗上限，
+//          Windows 为 PDH Processor Information 的 % Performance Limit（固件因温度/功耗/电流限制频率时低于 100）
+// GPU 信号：NVML 降频原因位掩码（由 GpuTelemetry 提供，这里不再查询驱动）
+// 每个周期只读取上述计数；逐核心有效频率只在事件开始/结束时读取一次，用于记录当时的频率
+// 信号消失后连续 kStopTicks 个周期仍无信号才结束，避免在阈值附近反复开始/结束
+class ThrottleDetector {
+public:
+    enum Reason : uint32_t {
+        kReasonThermal = 0x1,       // 温度墙：CPU thermal_throttle 计数增加，GPU 软/硬件温度降频
+        kReasonPowerLimit = 0x2,    // 功耗墙：CPU 封装功耗达到 PL1，GPU 软件功耗墙
+        kReasonHardware = 0x4,      // 硬件降频信号：GPU HW Slowdown、电源制动
+        kReasonPlatform = 0x8,      // 平台/固件限制：Windows % Performance Limit 低于 100
+    };
+
+    enum class Source : uint8_t { Cpu, Gpu };
+    enum class EventType : uint8_t { Start, Stop };
+
+    struct Event {
+        uint64_t sequence = 0;          // 从 1 开始递增，0 表示空槽
+        uint64_t timestampMs = 0;       // Unix 时间（毫秒，UTC）
+        uint64_t durationMs = 0;        // 结束事件为本次降频持续时间，开始事件为 0
+        uint32_t reasons = 0;           // 开始事件为当时的原因，结束事件为期间出现过的全部原因
+        Source source = Source::Cpu;
+        EventType type = EventType::Start;
+        uint16_t device = 0;            // GPU 为 GpuTelemetry::GetDevices() 下标，CPU 为 0
+        double temperature = 0.0;       // ℃，不可用为 NaN
+        double clockMHz = 0.0;          // CPU 为逐核心有效频率均值，GPU 为核心频率；不可用为 NaN
+        double minClockMHz = 0.0;       // CPU 为最低的核心有效频率，GPU 同 clockMHz
+        double powerWatts = 0.0;        // 不可用为 NaN
+        double powerLimitWatts = 0.0;   // CPU 为 RAPL PL1，GPU 为强制功耗上限；不可用为 NaN
+    };
+
+    // 由调用方从传感器注册表取得的 CPU 读数，不可用时为 NaN
+    struct CpuReadings {
+        double packageTemperature;
+        double packagePowerWatts;
+    };
+
+    static constexpr size_t kRingSize = 64;
+    static constexpr uint32_t kStopTicks = 2;
+
+    // sysfsRoot 指向其他目录时可用模拟目录测试（Linux）
+    explicit ThrottleDetector(const std::string& sysfsRoot = "/sys");
+    ~ThrottleDetector();
+
+    ThrottleDetector(const ThrottleDetector&) = delete;
+    ThrottleDetector& operator=(const ThrottleDetector&) = delete;
+
+    // 每个周期调用一次；gpus 为 nullptr 时不检测 GPU
+    void Update(const CpuReadings& cpu, const std::vector<GpuTelemetry::Device>* gpus);
+
+    // 按 (sequence - 1) % kRingSize 存放
+    const std::array<Event, kRingSize>& GetRing() const { return ring; }
+    // 最近一个事件的序号，没有事件时为 0
+    uint64_t GetSequence() const { return sequence; }
+    // CPU 当前的降频原因，未降频为 0
+    uint32_t GetCpuReasons() const { return cpuState.currentReasons; }
+    bool IsAvailable() const { return available; }
+
+private:
+    struct State {
+        bool active = false;
+        uint32_t currentReasons = 0;
+        uint32_t accumulatedReasons = 0;
+        uint32_t quietTicks = 0;
+        uint64_t startNs = 0;
+        uint64_t clearNs = 0;           // 信号首次消失的时间，结束事件按此计算持续时间
+    };
+
+    // 更新状态机，需要产生事件时返回 true 并填好 type/reasons/durationMs
+    bool Advance(State& state, uint32_t reasons, uint64_t nowNs, Event& event);
+    void Push(Event& event);
+    uint32_t ReadCpuReasons(const CpuReadings& cpu);
+    void ReadCpuClocks(double& average, double& minimum);
+
+    std::array<Event, kRingSize> ring{};
+    uint64_t sequence = 0;
+    State cpuState;
+    std::vector<State> gpuStates;       // 与 GpuTelemetry::GetDevices() 一一对应
+    double cpuPowerLimitWatts;          // RAPL PL1，不可用为 NaN
+    bool available = false;
+
+#ifdef _WIN32
+    PDH_HQUERY query = nullptr;
+    PDH_HCOUNTER performanceLimitCounter = nullptr;
+    PDH_HCOUNTER frequencyCounter = nullptr;
+    PDH_HCOUNTER corePerformanceCounter = nullptr;
+    std::vector<BYTE> counterArrayBuffer;   // PdhGetFormattedCounterArray 复用缓冲区
+#else
+    std::vector<ProcFile> throttleCounters; // 每个物理核心与封装一个，内容为累计毫秒或累计次数
+    std::vector<uint64_t> lastThrottle;     // 与 throttleCounters 一一对应
+    std::vector<ProcFile> coreFrequencies;  // 每个逻辑核心的 scaling_cur_freq（kHz），只在事件时读取
+    bool hasBaseline = false;
+#endif
+};
@@ -0,0 +1,166 @@
+﻿#include "BlockDeviceMonitor.h"
+
+#ifdef _WIN32
+#include <dbt.h>
+#include "../Utils/Logger.h"
+#else
+#include <cerrno>
+#include <cstring>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+namespace {
+    const wchar_t* kWindowClassName = L"TCMTBlockDeviceMonitor";
+    // GUID_DEVINTERFACE_DISK / GUID_DEVINTERFACE_VOLUME，本地定义以免依赖 initguid.h 的包含顺序
+    const GUID kDiskInterfaceGuid = { 0x53f56307, 0xb6bf, 0x11d0, { 0x94, 0xf2, 0x00, 0xa0, 0xc9, 0x1e, 0xfb, 0x8b } };
+    const GUID kVolumeInterfaceGuid = { 0x53f5630d, 0xb6bf, 0x11d0, { 0x94, 0xf2, 0x00, 0xa0, 0xc9, 0x1e, 0xfb, 0x8b } };
+}
+
+BlockDeviceMonitor::BlockDeviceMonitor() {
+    HANDLE readyEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+    if (!readyEvent) {
+        Logger::Warn("块设备变更通知: 创建事件失败");
+        return;
+    }
+    thread = std::thread(&BlockDeviceMonitor::ThreadMain, this, readyEvent);
+    // 线程在所有路径上都会置位事件，之后不再访问它
+    WaitForSingleObject(readyEvent, INFINITE);
+    CloseHandle(readyEvent);
+    available = window.load() != nullptr;
+    if (!available) Logger::Warn("块设备变更通知不可用，磁盘拓扑将每5分钟重建一次");
+}
+
+BlockDeviceMonitor::~BlockDeviceMonitor() {
+    HWND hwnd = window.exchange(nullptr);
+    if (hwnd) PostMessageW(hwnd, WM_CLOSE, 0, 0);
+    if (thread.joinable()) thread.join();
+}
+
+void BlockDeviceMonitor::ThreadMain(HANDLE readyEvent) {
+    HINSTANCE instance = GetModuleHandleW(NULL);
+    WNDCLASSEXW wc{};
+    wc.cbSize = sizeof(wc);
+    wc.lpfnWndProc = &BlockDeviceMonitor::WindowProc;
+    wc.hInstance = instance;
+    wc.lpszClassName = kWindowClassName;
+    if (!RegisterClassExW(&wc) && GetLastError() != ERROR_CLASS_ALREADY_EXISTS) {
+        SetEvent(readyEvent);
+        return;
+    }
+    // 消息窗口不接收广播，只能收到 RegisterDeviceNotification 订阅的设备接口通知
+    HWND hwnd = CreateWindowExW(0, kWindowClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, instance, NULL);
+    if (!hwnd) {
+        SetEvent(readyEvent);
+        return;
+    }
+    SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+
+    HDEVNOTIFY notifications[2] = {};
+    const GUID* guids[2] = { &kDiskInterfaceGuid, &kVolumeInterfaceGuid };
+    for (int i = 0; i < 2; ++i) {
+        DEV_BROADCAST_DEVICEINTERFACE_W filter{};
+        filter.dbcc_size = sizeof(filter);
+        filter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+        filter.dbcc_classguid = *guids[i];
+        notifications[i] = RegisterDeviceNotificationW(hwnd, &filter, DEVICE_NOTIFY_WINDOW_HANDLE);
+    }
+    if (!notifications[0] && !notifications[1]) {
+        DestroyWindow(hwnd);
+        SetEvent(readyEvent);
+        return;
+    }
+
+    window = hwnd;
+    SetEvent(readyEvent);
+
+    MSG msg;
+    while (GetMessageW(&msg, NULL, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+    for (HDEVNOTIFY n : notifications) {
+        if (n) UnregisterDeviceNotification(n);
+    }
+}
+
+LRESULT CALLBACK BlockDeviceMonitor::WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    switch (msg) {
+    case WM_DEVICECHANGE:
+        if (wParam == DBT_DEVICEARRIVAL || wParam == DBT_DEVICEREMOVECOMPLETE) {
+            auto* self = reinterpret_cast<BlockDeviceMonitor*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+            if (self) self->changeCount.fetch_add(1, std::memory_order_release);
+        }
+        return TRUE;
+    case WM_CLOSE:
+        DestroyWindow(hwnd);
+        return 0;
+    case WM_DESTROY:
+        PostQuitMessage(0);
+        return 0;
+    default:
+        return DefWindowProcW(hwnd, msg, wParam, lParam);
+    }
+}
+
+#else
+
+BlockDeviceMonitor::BlockDeviceMonitor() {
+    socketFd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (socketFd < 0) return;
+    sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = 1;    // 内核 uevent 组（udev 重新广播的是组2）
+    if (bind(socketFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(socketFd);
+        socketFd = -1;
+        return;
+    }
+    available = true;
+}
+
+BlockDeviceMonitor::~BlockDeviceMonitor() {
+    if (socketFd >= 0) close(socketFd);
+}
+
+// 消息格式："add@/devices/...\0ACTION=add\0DEVPATH=...\0SUBSYSTEM=block\0..."
+void BlockDeviceMonitor::Drain() {
+    if (socketFd < 0) return;
+    char buffer[8192];
+    for (;;) {
+        ssize_t n = recv(socketFd, buffer, sizeof(buffer) - 1, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // 接收队列溢出说明丢了事件，按发生过变更处理
+            if (errno == ENOBUFS) {
+                changeCount.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            break;
+        }
+        if (n == 0) break;
+        buffer[n] = '\0';
+        bool isBlock = false;
+        bool isAddRemove = false;
+        for (const char* field = buffer; field < buffer + n; field += strlen(field) + 1) {
+            if (strcmp(field, "SUBSYSTEM=block") == 0) isBlock = true;
+            else if (strcmp(field, "ACTION=add") == 0 || strcmp(field, "ACTION=remove") == 0) isAddRemove = true;
+        }
+        if (isBlock && isAddRemove) changeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#endif
+
+bool BlockDeviceMonitor::ConsumeChanges() {
+#ifndef _WIN32
+    Drain();
+#endif
+    uint64_t count = changeCount.load(std::memory_order_acquire);
+    if (count == consumedCount) return false;
+    consumedCount = count;
+    return true;
+}
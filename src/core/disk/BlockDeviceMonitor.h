@@ -0,0 +1,43 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <thread>
+#endif
+
+// 块设备到达/移除通知
+// 只负责累计变更次数，不做任何枚举；使用方在 ConsumeChanges() 返回 true 时再重建自己的缓存
+// Windows: 后台线程持有一个消息窗口（HWND_MESSAGE），通过 RegisterDeviceNotification 订阅磁盘/卷设备接口的 WM_DEVICECHANGE
+// Linux: NETLINK_KOBJECT_UEVENT 非阻塞套接字，ConsumeChanges() 时读空队列并统计 SUBSYSTEM=block 的 add/remove 事件
+class BlockDeviceMonitor {
+public:
+    BlockDeviceMonitor();
+    ~BlockDeviceMonitor();
+
+    BlockDeviceMonitor(const BlockDeviceMonitor&) = delete;
+    BlockDeviceMonitor& operator=(const BlockDeviceMonitor&) = delete;
+
+    // 自上次调用以来是否发生过块设备变更
+    bool ConsumeChanges();
+    // 通知机制不可用时使用方应退回到定期重建
+    bool IsAvailable() const { return available; }
+
+private:
+    std::atomic<uint64_t> changeCount{ 0 };
+    uint64_t consumedCount = 0;
+    bool available = false;
+
+#ifdef _WIN32
+    static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+    void ThreadMain(HANDLE readyEvent);
+
+    std::thread thread;
+    std::atomic<HWND> window{ nullptr };
+#else
+    void Drain();
+
+    int socketFd = -1;
+#endif
+};
@@ -0,0 +1,183 @@
+﻿#include "DiskHealthTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    constexpr int64_t kSecondsPerDay = 86400;
+
+    // 计数按 log2 增长计分并封顶：首个坏扇区的信号最强，之后边际递减
+    double CountScore(uint64_t count, double weight, double cap) {
+        return (std::min)(cap, weight * std::log2(1.0 + static_cast<double>(count)));
+    }
+
+    // 部分固件在序列号前后补空格，同一块盘在不同接口下读到的填充不同
+    std::string TrimSerial(const std::string& serial) {
+        size_t begin = serial.find_first_not_of(" \t");
+        if (begin == std::string::npos) return std::string();
+        size_t end = serial.find_last_not_of(" \t");
+        return serial.substr(begin, end - begin + 1);
+    }
+
+    // FNV-1a 32位，区分净化后同名的序列号
+    uint32_t HashSerial(const std::string& serial) {
+        uint32_t hash = 2166136261u;
+        for (unsigned char c : serial) {
+            hash ^= c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+}
+
+DiskHealthTracker::DiskHealthTracker(std::string historyDirectory) : directory(std::move(historyDirectory)) {
+    if (directory.empty()) return;
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) directory.clear();
+}
+
+const DiskHealthTracker::Assessment& DiskHealthTracker::Record(const std::string& serial, const SmartParser::HealthSummary& summary,
+    uint64_t collectedNs, int64_t nowUnixSeconds) {
+    // 没有序列号的磁盘无法跨插拔/重启识别，不跟踪，避免多块盘共用一份历史
+    static const Assessment kUntracked;
+    const std::string key = TrimSerial(serial);
+    if (key.empty()) return kUntracked;
+    History& history = histories[key];
+    if (!history.loaded) {
+        Load(key, history);
+        history.loaded = true;
+    }
+    if (collectedNs != 0 && collectedNs == history.lastCollectedNs) return history.assessment;
+    history.lastCollectedNs = collectedNs;
+
+    Sample sample;
+    sample.time = nowUnixSeconds;
+    sample.reallocated = summary.reallocatedSectors;
+    sample.pending = summary.pendingSectors;
+    sample.uncorrectable = summary.uncorrectableErrors;
+    sample.lifeRemaining = summary.lifeRemainingPercent;
+    sample.failing = summary.failing;
+
+    const Sample& w = history.written;
+    bool changed = !history.hasLast || sample.reallocated != w.reallocated || sample.pending != w.pending ||
+        sample.uncorrectable != w.uncorrectable || sample.failing != w.failing ||
+        std::lround(sample.lifeRemaining * 100) != std::lround(w.lifeRemaining * 100) ||
+        sample.time - w.time >= kRecordIntervalSeconds;
+    Apply(history, sample);
+    if (changed) {
+        history.written = sample;
+        Append(key, sample);
+    }
+    history.assessment = Assess(history);
+    return history.assessment;
+}
+
+const DiskHealthTracker::Assessment* DiskHealthTracker::Find(const std::string& serial) const {
+    auto it = histories.find(TrimSerial(serial));
+    return it != histories.end() && it->second.assessment.valid ? &it->second.assessment : nullptr;
+}
+
+void DiskHealthTracker::Apply(History& history, const Sample& sample) {
+    history.last = sample;
+    history.hasLast = true;
+    if (sample.lifeRemaining >= 0.0 && !history.hasFirstWear) {
+        history.hasFirstWear = true;
+        history.firstWearTime = sample.time;
+        history.firstWearRemaining = sample.lifeRemaining;
+    }
+    int64_t day = sample.time / kSecondsPerDay;
+    int slot = static_cast<int>(day % kDayBuckets);
+    if (history.dayIndex[slot] != day) {
+        history.dayIndex[slot] = day;
+        history.dayDefects[slot] = sample.Defects();
+    }
+}
+
+DiskHealthTracker::Assessment DiskHealthTracker::Assess(const History& history) {
+    Assessment a;
+    if (!history.hasLast) return a;
+    const Sample& last = history.last;
+    a.valid = true;
+
+    int64_t today = last.time / kSecondsPerDay;
+    int64_t oldestDay = today + 1;
+    uint64_t baseline = last.Defects();
+    for (int i = 0; i < kDayBuckets; ++i) {
+        int64_t day = history.dayIndex[i];
+        if (day >= today - 7 && day <= today && day < oldestDay) {
+            oldestDay = day;
+            baseline = history.dayDefects[i];
+        }
+    }
+    a.defectGrowth7d = last.Defects() > baseline ? last.Defects() - baseline : 0;
+
+    // 权重参考公开的大规模磁盘故障统计：待处理扇区与不可纠正错误比已完成的重映射更危险，近期增长比存量更危险
+    double risk = CountScore(last.reallocated, 8.0, 35.0) +
+        CountScore(last.pending, 12.0, 30.0) +
+        CountScore(last.uncorrectable, 12.0, 30.0) +
+        CountScore(a.defectGrowth7d, 10.0, 30.0);
+    if (last.lifeRemaining >= 0.0 && last.lifeRemaining < 20.0) risk += (std::min)(30.0, (20.0 - last.lifeRemaining) * 1.5);
+    a.riskScore = last.failing ? 100.0 : (std::min)(risk, 100.0);
+
+    if (last.lifeRemaining == 0.0) {
+        a.wearOutEtaDays = 0.0;
+    } else if (history.hasFirstWear && last.lifeRemaining > 0.0) {
+        double days = static_cast<double>(last.time - history.firstWearTime) / kSecondsPerDay;
+        double consumed = history.firstWearRemaining - last.lifeRemaining;
+        if (days >= 1.0 && consumed > 0.0) a.wearOutEtaDays = last.lifeRemaining / (consumed / days);
+    }
+    return a;
+}
+
+// 文件名为净化后的序列号加原始序列号的哈希，如 "WD-WX12_3456_1a2b3c4d.log"
+std::string DiskHealthTracker::HistoryPath(const std::string& serial) const {
+    std::string name;
+    name.reserve(serial.size() + 9);
+    for (char c : serial) {
+        bool safe = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-' || c == '_';
+        name.push_back(safe ? c : '_');
+    }
+    char suffix[10];
+    snprintf(suffix, sizeof(suffix), "_%08x", HashSerial(serial));
+    name += suffix;
+    return (std::filesystem::path(directory) / (name + ".log")).string();
+}
+
+void DiskHealthTracker::Load(const std::string& serial, History& history) const {
+    if (directory.empty()) return;
+    const std::string path = HistoryPath(serial);
+    // 旧版本文件名不带哈希；序列号本身无需净化时文件名不会冲突，改名沿用
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        bool safe = std::all_of(serial.begin(), serial.end(), [](char c) {
+            return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-';
+        });
+        const std::filesystem::path legacy = std::filesystem::path(directory) / (serial + ".log");
+        if (safe && std::filesystem::exists(legacy, ec)) std::filesystem::rename(legacy, path, ec);
+    }
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        Sample sample;
+        long long lifeX100 = -100;
+        int failing = 0;
+        if (!(in >> sample.time >> sample.reallocated >> sample.pending >> sample.uncorrectable >> lifeX100 >> failing)) continue;
+        sample.lifeRemaining = lifeX100 < 0 ? -1.0 : lifeX100 / 100.0;
+        sample.failing = failing != 0;
+        Apply(history, sample);
+        history.written = sample;
+    }
+    if (history.hasLast) history.assessment = Assess(history);
+}
+
+void DiskHealthTracker::Append(const std::string& serial, const Sample& sample) const {
+    if (directory.empty()) return;
+    std::ofstream file(HistoryPath(serial), std::ios::app);
+    file << sample.time << ' ' << sample.reallocated << ' ' << sample.pending << ' ' << sample.uncorrectable << ' '
+        << (sample.lifeRemaining < 0.0 ? -1 : std::lround(sample.lifeRemaining * 100)) << ' ' << (sample.failing ? 1 : 0) << '\n';
+}
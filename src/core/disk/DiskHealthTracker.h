@@ -0,0 +1,70 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "SmartParser.h"
+
+// 基于 SMART 趋势的磁盘故障风险评分与磨损耗尽预测
+// 每块磁盘按序列号（去除首尾空白，为空时不跟踪）保存一份历史文件（每行: unix秒 重映射扇区 待处理扇区 不可纠正/介质错误 剩余寿命%*100 是否失败），
+// 只在数值变化或距上次记录满24小时时追加一行；启动后首次遇到该磁盘时回放文件重建状态，之后全部增量计算：
+// - 缺陷增长：按天保存最近8天每天第一条记录的缺陷总数，取7天内最早一天与当前值之差
+// - 磨损速率：首条带寿命信息的记录到当前的平均消耗速率
+class DiskHealthTracker {
+public:
+    struct Assessment {
+        bool valid = false;
+        double riskScore = 0.0;         // 0-100，越高越可能在近期故障
+        double wearOutEtaDays = -1.0;   // 按磨损速率预计寿命耗尽的剩余天数，-1 表示未知或未在消耗
+        uint64_t defectGrowth7d = 0;    // 最近7天缺陷计数增量
+    };
+
+    static constexpr int64_t kRecordIntervalSeconds = 86400;
+    static constexpr int kDayBuckets = 8;
+
+    // historyDirectory 为空时不落盘，只在内存中跟踪
+    explicit DiskHealthTracker(std::string historyDirectory);
+
+    DiskHealthTracker(const DiskHealthTracker&) = delete;
+    DiskHealthTracker& operator=(const DiskHealthTracker&) = delete;
+
+    // 记录一次 SMART 摘要；collectedNs 与上次相同（同一份采集结果）时直接返回缓存的评估；
+    // 序列号为空时返回无效评估
+    const Assessment& Record(const std::string& serial, const SmartParser::HealthSummary& summary,
+        uint64_t collectedNs, int64_t nowUnixSeconds);
+    const Assessment* Find(const std::string& serial) const;
+
+private:
+    struct Sample {
+        int64_t time = 0;
+        uint64_t reallocated = 0;
+        uint64_t pending = 0;
+        uint64_t uncorrectable = 0;
+        double lifeRemaining = -1.0;
+        bool failing = false;
+
+        uint64_t Defects() const { return reallocated + pending + uncorrectable; }
+    };
+
+    struct History {
+        bool loaded = false;
+        bool hasLast = false;
+        Sample last;
+        Sample written;                 // 最近一次写入文件的记录，用于判断是否需要追加
+        bool hasFirstWear = false;
+        int64_t firstWearTime = 0;
+        double firstWearRemaining = 0.0;
+        int64_t dayIndex[kDayBuckets] = {};
+        uint64_t dayDefects[kDayBuckets] = {};
+        uint64_t lastCollectedNs = 0;
+        Assessment assessment;
+    };
+
+    static void Apply(History& history, const Sample& sample);
+    static Assessment Assess(const History& history);
+    std::string HistoryPath(const std::string& serial) const;
+    void Load(const std::string& serial, History& history) const;
+    void Append(const std::string& serial, const Sample& sample) const;
+
+    std::string directory;
+    std::unordered_map<std::string, History> histories;
+};
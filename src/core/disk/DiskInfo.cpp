@@ -2,10 +2,10 @@
 #include "DiskInfo.h"
 #include "../Utils/WinUtils.h"
 #include "../Utils/Logger.h"
-#include "../Utils/WmiManager.h"
-#include <wbemidl.h>
-#include <comdef.h>
-#pragma comment(lib, "wbemuuid.lib")
+#include "DiskTopology.h"
+#include "SmartCollector.h"
+#include "DiskHealthTracker.h"
+#include <ctime>
 
 DiskInfo::DiskInfo() { QueryDrives(); }
 
@@ -51,30 +51,79 @@ std::vector<DiskData> DiskInfo::GetDisks() {
     return disks;
 }
 
-// ---------------- 物理磁盘 + 逻辑盘符映射实现合并 ----------------
-static bool ParseDiskPartition(const std::wstring& text, int& diskIndexOut) {
-    size_t posDisk = text.find(L"Disk #"); if (posDisk==std::wstring::npos) return false; posDisk += 6; if (posDisk>=text.size()) return false; int num=0; bool any=false; while (posDisk<text.size() && iswdigit(text[posDisk])) { any=true; num = num*10 + (text[posDisk]-L'0'); ++posDisk; } if(!any) return false; diskIndexOut = num; return true; }
+// ---------------- 物理磁盘 + 逻辑盘符映射 ----------------
+// 把 SmartCollector 的缓存结果填入共享结构（ATA 属性及其目录名称/解码值，NVMe 只有摘要字段）
+static void ApplySmartReport(const SmartCollector::Report& report, PhysicalDiskSmartData& pd) {
+    if (!report.supported) return;
+    const auto& s = report.summary;
+    pd.smartSupported = true;
+    pd.smartEnabled = true;
+    pd.healthPercentage = s.healthPercent;
+    pd.temperature = s.temperature;
+    pd.powerOnHours = s.powerOnHours;
+    pd.powerCycleCount = s.powerCycles;
+    pd.reallocatedSectorCount = s.reallocatedSectors;
+    pd.currentPendingSector = s.pendingSectors;
+    pd.uncorrectableErrors = s.uncorrectableErrors;
+    pd.wearLeveling = s.lifeRemainingPercent;
+    pd.totalBytesRead = s.bytesRead;
+    pd.totalBytesWritten = s.bytesWritten;
+    if (report.isNvme) wcsncpy_s(pd.diskType, L"SSD", _TRUNCATE);
 
-void DiskInfo::CollectPhysicalDisks(WmiManager& wmi, const std::vector<DiskData>& logicalDisks, SystemInfo& sysInfo) {
-    IWbemServices* svc = wmi.GetWmiService(); if (!svc) { Logger::Warn("WMI 服务无效，跳过物理磁盘枚举"); return; }
-    std::map<int,std::vector<char>> physicalIndexToLetters;
-    // 1. Win32_DiskDriveToDiskPartition
-    {
-        IEnumWbemClassObject* pEnum=nullptr; HRESULT hr=svc->ExecQuery(bstr_t(L"WQL"), bstr_t(L"SELECT * FROM Win32_DiskDriveToDiskPartition"), WBEM_FLAG_FORWARD_ONLY|WBEM_FLAG_RETURN_IMMEDIATELY,nullptr,&pEnum);
-        if (SUCCEEDED(hr)&&pEnum){ IWbemClassObject* obj=nullptr; ULONG ret=0; while(pEnum->Next(WBEM_INFINITE,1,&obj,&ret)==S_OK){ VARIANT ant; VARIANT dep; VariantInit(&ant); VariantInit(&dep); if (SUCCEEDED(obj->Get(L"Antecedent",0,&ant,0,0)) && ant.vt==VT_BSTR && SUCCEEDED(obj->Get(L"Dependent",0,&dep,0,0)) && dep.vt==VT_BSTR){ int diskIdx=-1; if (ParseDiskPartition(dep.bstrVal,diskIdx)){ /* mapping captured via next query */ } } VariantClear(&ant); VariantClear(&dep); obj->Release(); } pEnum->Release(); } else { Logger::Warn("查询 Win32_DiskDriveToDiskPartition 失败"); }
+    pd.attributeCount = 0;
+    for (int i = 0; i < report.ata.count && pd.attributeCount < 32; ++i) {
+        const auto& a = report.ata.attributes[i];
+        auto& dst = pd.attributes[pd.attributeCount++];
+        dst.id = a.id;
+        dst.flags = static_cast<uint8_t>(a.flags);
+        dst.current = a.current;
+        dst.worst = a.worst;
+        dst.threshold = a.threshold;
+        dst.rawValue = a.rawValue;
+        const SmartAttributeInfo* info = report.attributeInfo[i];
+        dst.physicalValue = report.decoded[i].value;
+        if (info) {
+            dst.isCritical = info->critical;
+            wcsncpy_s(dst.name, info->name, _TRUNCATE);
+            wcsncpy_s(dst.description, info->description, _TRUNCATE);
+            wcsncpy_s(dst.units, SmartAttributeCatalog::UnitText(info->unit), _TRUNCATE);
+        } else {
+            dst.isCritical = (a.flags & 0x01) != 0;
+            wcsncpy_s(dst.name, SmartAttributeCatalog::UnknownName(a.id), _TRUNCATE);
+            dst.description[0] = L'\0';
+            dst.units[0] = L'\0';
+        }
+    }
+    GetSystemTime(&pd.lastScanTime);
+}
+
+void DiskInfo::CollectPhysicalDisks(const DiskTopology& topology, SystemInfo& sysInfo, const SmartCollector* smart, DiskHealthTracker* health) {
+    sysInfo.physicalDisks.clear();
+    for (const auto& disk : topology.GetDisks()) {
+        if (sysInfo.physicalDisks.size() >= 8) break;
+        PhysicalDiskSmartData data{};
+        wcsncpy_s(data.model, disk.model.c_str(), _TRUNCATE);
+        wcsncpy_s(data.serialNumber, disk.serialNumber.c_str(), _TRUNCATE);
+        wcsncpy_s(data.interfaceType, disk.interfaceType.c_str(), _TRUNCATE);
+        wcsncpy_s(data.diskType, disk.mediaType.c_str(), _TRUNCATE);
+        data.capacity = disk.capacity;
+        int count = 0;
+        for (char letter : disk.driveLetters) {
+            if (count >= 8) break;
+            data.logicalDriveLetters[count++] = letter;
+        }
+        data.logicalDriveCount = count;
+        data.wearOutEtaDays = -1.0;
+        const SmartCollector::Report* report = smart ? smart->Find(disk.device) : nullptr;
+        if (report) ApplySmartReport(*report, data);
+        // 历史按序列号保存（磁盘编号会随插拔变化）；同一份采集结果只记录一次
+        if (health && report && report->supported && !disk.serialNumber.empty()) {
+            const auto& assessment = health->Record(WinUtils::WstringToUtf8(disk.serialNumber), report->summary,
+                report->collectedNs, static_cast<int64_t>(std::time(nullptr)));
+            data.failureRiskScore = assessment.riskScore;
+            data.wearOutEtaDays = assessment.wearOutEtaDays;
+            data.defectGrowth7d = assessment.defectGrowth7d;
+        }
+        sysInfo.physicalDisks.push_back(data);
     }
-    // 2. Win32_LogicalDiskToPartition 建立盘符 -> 物理索引
-    std::map<char,int> letterToDiskIndex; {
-        IEnumWbemClassObject* pEnum=nullptr; HRESULT hr=svc->ExecQuery(bstr_t(L"WQL"), bstr_t(L"SELECT * FROM Win32_LogicalDiskToPartition"), WBEM_FLAG_FORWARD_ONLY|WBEM_FLAG_RETURN_IMMEDIATELY,nullptr,&pEnum);
-        if (SUCCEEDED(hr)&&pEnum){ IWbemClassObject* obj=nullptr; ULONG ret=0; while(pEnum->Next(WBEM_INFINITE,1,&obj,&ret)==S_OK){ VARIANT ant; VARIANT dep; VariantInit(&ant); VariantInit(&dep); if (SUCCEEDED(obj->Get(L"Antecedent",0,&ant,0,0)) && ant.vt==VT_BSTR && SUCCEEDED(obj->Get(L"Dependent",0,&dep,0,0)) && dep.vt==VT_BSTR){ int diskIdx=-1; if (ParseDiskPartition(ant.bstrVal,diskIdx)){ std::wstring depStr = dep.bstrVal; size_t pos = depStr.find(L"DeviceID=\""); if (pos!=std::wstring::npos){ pos+=10; if (pos<depStr.size()){ wchar_t letterW = depStr[pos]; if(letterW && letterW!=L'"'){ letterToDiskIndex[ static_cast<char>(::toupper(letterW)) ] = diskIdx; } } } } } VariantClear(&ant); VariantClear(&dep); obj->Release(); } pEnum->Release(); } else { Logger::Warn("查询 Win32_LogicalDiskToPartition 失败"); } }
-    for (auto& kv: letterToDiskIndex) physicalIndexToLetters[kv.second].push_back(kv.first);
-    // 3. Win32_DiskDrive 基本信息
-    std::map<int,PhysicalDiskSmartData> tempDisks; {
-        IEnumWbemClassObject* pEnum=nullptr; HRESULT hr=svc->ExecQuery(bstr_t(L"WQL"), bstr_t(L"SELECT Index,Model,SerialNumber,InterfaceType,Size,MediaType FROM Win32_DiskDrive"), WBEM_FLAG_FORWARD_ONLY|WBEM_FLAG_RETURN_IMMEDIATELY,nullptr,&pEnum);
-        if (SUCCEEDED(hr)&&pEnum){ IWbemClassObject* obj=nullptr; ULONG ret=0; while(pEnum->Next(WBEM_INFINITE,1,&obj,&ret)==S_OK){ VARIANT vIndex,vModel,vSerial,vIface,vSize,vMedia; VariantInit(&vIndex);VariantInit(&vModel);VariantInit(&vSerial);VariantInit(&vIface);VariantInit(&vSize);VariantInit(&vMedia); if (SUCCEEDED(obj->Get(L"Index",0,&vIndex,0,0)) && (vIndex.vt==VT_I4||vIndex.vt==VT_UI4)){ int idx=(vIndex.vt==VT_I4)?vIndex.intVal:static_cast<int>(vIndex.uintVal); PhysicalDiskSmartData data{}; if (SUCCEEDED(obj->Get(L"Model",0,&vModel,0,0))&&vModel.vt==VT_BSTR) wcsncpy_s(data.model,vModel.bstrVal,_TRUNCATE); if (SUCCEEDED(obj->Get(L"SerialNumber",0,&vSerial,0,0))&&vSerial.vt==VT_BSTR) wcsncpy_s(data.serialNumber,vSerial.bstrVal,_TRUNCATE); if (SUCCEEDED(obj->Get(L"InterfaceType",0,&vIface,0,0))&&vIface.vt==VT_BSTR) wcsncpy_s(data.interfaceType,vIface.bstrVal,_TRUNCATE); if (SUCCEEDED(obj->Get(L"Size",0,&vSize,0,0))){ if (vSize.vt==VT_UI8) data.capacity=vSize.ullVal; else if (vSize.vt==VT_BSTR) data.capacity=_wcstoui64(vSize.bstrVal,nullptr,10);} if (SUCCEEDED(obj->Get(L"MediaType",0,&vMedia,0,0))&&vMedia.vt==VT_BSTR){ std::wstring media=vMedia.bstrVal; if (media.find(L"SSD")!=std::wstring::npos||media.find(L"Solid State")!=std::wstring::npos) wcsncpy_s(data.diskType,L"SSD",_TRUNCATE); else wcsncpy_s(data.diskType,L"HDD",_TRUNCATE);} else wcsncpy_s(data.diskType,L"未知",_TRUNCATE); data.smartSupported=false; data.smartEnabled=false; data.healthPercentage=0; data.temperature=0.0; data.logicalDriveCount=0; tempDisks[idx]=data; } VariantClear(&vIndex);VariantClear(&vModel);VariantClear(&vSerial);VariantClear(&vIface);VariantClear(&vSize);VariantClear(&vMedia); obj->Release(); } pEnum->Release(); } else { Logger::Warn("查询 Win32_DiskDrive 失败"); } }
-    // 4. 填充盘符
-    for (auto& kv: physicalIndexToLetters){ int diskIdx=kv.first; auto it=tempDisks.find(diskIdx); if(it==tempDisks.end()) continue; auto& pd=it->second; int count=0; for(char L: kv.second){ if(count>=8) break; pd.logicalDriveLetters[count++]=L; } pd.logicalDriveCount=count; }
-    // 5. 写入 SystemInfo
-    sysInfo.physicalDisks.clear(); for (auto& kv: tempDisks){ sysInfo.physicalDisks.push_back(kv.second); if (sysInfo.physicalDisks.size()>=8) break; }
-    Logger::Debug("物理磁盘枚举完成: " + std::to_string(sysInfo.physicalDisks.size()) + " 个");
-}
\ No newline at end of file
+}
@@ -6,7 +6,9 @@
 #include <map>
 #include "../DataStruct/DataStruct.h"
 
-class WmiManager; // 前向声明，避免头文件依赖膨胀
+class DiskTopology; // 前向声明，避免头文件依赖膨胀
+class SmartCollector;
+class DiskHealthTracker;
 
 struct DriveInfo {
     char letter;
@@ -24,8 +26,10 @@ public:
     void Refresh();
     std::vector<DiskData> GetDisks(); // 返回所有逻辑磁盘信息
 
-    // 新增：收集物理磁盘及逻辑盘符映射（不含真正SMART，仅基础+映射）
-    static void CollectPhysicalDisks(WmiManager& wmi, const std::vector<DiskData>& logicalDisks, SystemInfo& sysInfo);
+    // 新增：从拓扑缓存生成物理磁盘及逻辑盘符映射（不访问 WMI）；传入 smart 时附加其缓存的 SMART/NVMe 健康数据，
+    // 再传入 health 时按序列号记录趋势并填充故障风险评分
+    static void CollectPhysicalDisks(const DiskTopology& topology, SystemInfo& sysInfo, const SmartCollector* smart = nullptr,
+        DiskHealthTracker* health = nullptr);
 
 private:
     void QueryDrives();
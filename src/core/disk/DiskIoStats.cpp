@@ -0,0 +1,247 @@
+﻿#include "DiskIoStats.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <winioctl.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+    double SafeDiv(double numerator, double denominator) {
+        return denominator > 0.0 ? numerator / denominator : 0.0;
+    }
+}
+
+DiskIoStats::DiskIoStats() {
+#ifndef _WIN32
+    // 设备数上百时 /proc/diskstats 可达数十KB，ProcFile 会按需扩容
+    available = diskStatsFile.Open("/proc/diskstats", 16384);
+#endif
+    Rescan();
+}
+
+DiskIoStats::~DiskIoStats() {
+#ifdef _WIN32
+    CloseHandles();
+#endif
+}
+
+void DiskIoStats::RemoveUnseen() {
+    for (size_t i = devices.size(); i-- > 0;) {
+        if (devices[i].seen) continue;
+        devices.erase(devices.begin() + i);
+#ifdef _WIN32
+        if (handles[i] != INVALID_HANDLE_VALUE) CloseHandle(handles[i]);
+        handles.erase(handles.begin() + i);
+#endif
+    }
+}
+
+#ifdef _WIN32
+
+void DiskIoStats::CloseHandles() {
+    for (HANDLE h : handles) {
+        if (h != INVALID_HANDLE_VALUE) CloseHandle(h);
+    }
+    handles.clear();
+}
+
+void DiskIoStats::Rescan() {
+    CloseHandles();
+    devices.clear();
+    // 物理磁盘编号通常连续，但移除磁盘后可能出现空洞，这里扫描固定范围
+    for (DWORD n = 0; n < 64; ++n) {
+        std::wstring path = L"\\\\.\\PhysicalDrive" + std::to_wstring(n);
+        // IOCTL_DISK_PERFORMANCE 为 FILE_ANY_ACCESS，不需要读权限，普通用户也可打开
+        HANDLE h = CreateFileW(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+        if (h == INVALID_HANDLE_VALUE) continue;
+        Device device;
+        device.name = "PhysicalDrive" + std::to_string(n);
+        device.id = n;
+        devices.push_back(std::move(device));
+        handles.push_back(h);
+    }
+    available = !devices.empty();
+    lastSampleNs = 0;
+    Logger::Debug("磁盘I/O统计: 发现 " + std::to_string(devices.size()) + " 个物理磁盘");
+}
+
+bool DiskIoStats::Update() {
+    if (!available) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t elapsedNs = now - lastSampleNs;
+    double elapsedSec = elapsedNs / 1e9;
+    bool anyFailed = false;
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        Device& d = devices[i];
+        DISK_PERFORMANCE perf{};
+        DWORD returned = 0;
+        d.seen = DeviceIoControl(handles[i], IOCTL_DISK_PERFORMANCE, NULL, 0, &perf, sizeof(perf), &returned, NULL) != FALSE;
+        if (!d.seen) {
+            anyFailed = true;
+            continue;
+        }
+
+        uint64_t readBytes = static_cast<uint64_t>(perf.BytesRead.QuadPart);
+        uint64_t writeBytes = static_cast<uint64_t>(perf.BytesWritten.QuadPart);
+        uint64_t reads = perf.ReadCount;
+        uint64_t writes = perf.WriteCount;
+        uint64_t readTime = static_cast<uint64_t>(perf.ReadTime.QuadPart);     // 100ns
+        uint64_t writeTime = static_cast<uint64_t>(perf.WriteTime.QuadPart);   // 100ns
+        uint64_t idleTime = static_cast<uint64_t>(perf.IdleTime.QuadPart);     // 100ns
+
+        if (d.hasBaseline && elapsedNs > 0) {
+            uint64_t dReads = CounterMath::SaturatingDelta(d.reads, reads);
+            uint64_t dWrites = CounterMath::SaturatingDelta(d.writes, writes);
+            double dReadMs = CounterMath::SaturatingDelta(d.readTime, readTime) / 1e4;
+            double dWriteMs = CounterMath::SaturatingDelta(d.writeTime, writeTime) / 1e4;
+            double dIdleNs = CounterMath::SaturatingDelta(d.busyOrIdleTime, idleTime) * 100.0;
+
+            d.readBytesPerSec = CounterMath::PerSecond(CounterMath::SaturatingDelta(d.readBytes, readBytes), elapsedNs);
+            d.writeBytesPerSec = CounterMath::PerSecond(CounterMath::SaturatingDelta(d.writeBytes, writeBytes), elapsedNs);
+            d.readIops = CounterMath::PerSecond(dReads, elapsedNs);
+            d.writeIops = CounterMath::PerSecond(dWrites, elapsedNs);
+            d.avgReadAwaitMs = SafeDiv(dReadMs, static_cast<double>(dReads));
+            d.avgWriteAwaitMs = SafeDiv(dWriteMs, static_cast<double>(dWrites));
+            d.avgAwaitMs = SafeDiv(dReadMs + dWriteMs, static_cast<double>(dReads + dWrites));
+            d.utilizationPercent = (std::min)((std::max)(100.0 - dIdleNs * 100.0 / elapsedNs, 0.0), 100.0);
+            // 请求耗时总和 / 经过时间 = 平均同时在途的请求数
+            d.avgQueueLength = SafeDiv(dReadMs + dWriteMs, elapsedSec * 1000.0);
+        }
+        d.queueDepth = perf.QueueDepth;
+        d.readBytes = readBytes;
+        d.writeBytes = writeBytes;
+        d.reads = reads;
+        d.writes = writes;
+        d.readTime = readTime;
+        d.writeTime = writeTime;
+        d.busyOrIdleTime = idleTime;
+        d.hasBaseline = true;
+    }
+
+    // 磁盘被移除后句柄失效：丢弃该设备，下次 Rescan 再发现新设备
+    if (anyFailed) RemoveUnseen();
+    lastSampleNs = now;
+    return true;
+}
+
+#else
+
+void DiskIoStats::Rescan() {
+    devices.clear();
+    deviceIndex.clear();
+    lastSampleNs = 0;
+}
+
+// 只统计整盘：分区在 sysfs 中带 partition 属性；loop(7)、ram(1) 不是真实存储设备
+bool DiskIoStats::IsWholeDisk(uint64_t major, uint64_t minor) const {
+    if (major == 1 || major == 7) return false;
+    std::string path = "/sys/dev/block/" + std::to_string(major) + ":" + std::to_string(minor) + "/partition";
+    struct stat st;
+    return stat(path.c_str(), &st) != 0;
+}
+
+// 每行: major minor name 读完成 读合并 读扇区 读耗时ms 写完成 写合并 写扇区 写耗时ms 在途 io_ticks 加权ms [discard/flush...]
+// 扇区固定按 512 字节计算，与设备实际扇区大小无关
+bool DiskIoStats::Update() {
+    if (!available || !diskStatsFile.Read()) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t elapsedNs = now - lastSampleNs;
+    double elapsedMs = elapsedNs / 1e6;
+    bool removed = false;
+
+    for (auto& d : devices) d.seen = false;
+
+    const char* p = diskStatsFile.Data();
+    const char* end = diskStatsFile.End();
+    while (p < end) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+
+        const char* q = line;
+        uint64_t major = 0, minor = 0;
+        if (!TextScan::NextU64(q, p, major) || !TextScan::NextU64(q, p, minor)) continue;
+        const char* name = TextScan::SkipSpaces(q, p);
+        q = TextScan::SkipToken(name, p);
+        size_t nameLength = static_cast<size_t>(q - name);
+
+        uint64_t key = MakeKey(major, minor);
+        auto it = deviceIndex.find(key);
+        if (it == deviceIndex.end()) {
+            // 新设备只在首次出现时分配与访问 sysfs
+            int index = -1;
+            if (IsWholeDisk(major, minor)) {
+                Device device;
+                device.name.assign(name, nameLength);
+                device.id = static_cast<uint32_t>((major << 20) | (minor & 0xFFFFF));
+                index = static_cast<int>(devices.size());
+                devices.push_back(std::move(device));
+            }
+            it = deviceIndex.emplace(key, index).first;
+        }
+        if (it->second < 0) continue;
+
+        uint64_t f[11] = {};
+        int count = 0;
+        while (count < 11 && TextScan::NextU64(q, p, f[count])) ++count;
+        if (count < 11) continue;
+
+        Device& d = devices[static_cast<size_t>(it->second)];
+        d.seen = true;
+        uint64_t reads = f[0], readBytes = f[2] * 512, readTime = f[3];
+        uint64_t writes = f[4], writeBytes = f[6] * 512, writeTime = f[7];
+        uint64_t ioTicks = f[9], weightedTime = f[10];
+
+        if (d.hasBaseline && elapsedNs > 0) {
+            uint64_t dReads = CounterMath::Delta(d.reads, reads);
+            uint64_t dWrites = CounterMath::Delta(d.writes, writes);
+            double dReadMs = static_cast<double>(CounterMath::Delta(d.readTime, readTime));
+            double dWriteMs = static_cast<double>(CounterMath::Delta(d.writeTime, writeTime));
+
+            d.readBytesPerSec = CounterMath::PerSecond(CounterMath::SaturatingDelta(d.readBytes, readBytes), elapsedNs);
+            d.writeBytesPerSec = CounterMath::PerSecond(CounterMath::SaturatingDelta(d.writeBytes, writeBytes), elapsedNs);
+            d.readIops = CounterMath::PerSecond(dReads, elapsedNs);
+            d.writeIops = CounterMath::PerSecond(dWrites, elapsedNs);
+            d.avgReadAwaitMs = SafeDiv(dReadMs, static_cast<double>(dReads));
+            d.avgWriteAwaitMs = SafeDiv(dWriteMs, static_cast<double>(dWrites));
+            d.avgAwaitMs = SafeDiv(dReadMs + dWriteMs, static_cast<double>(dReads + dWrites));
+            d.utilizationPercent = (std::min)(SafeDiv(static_cast<double>(CounterMath::Delta(d.busyOrIdleTime, ioTicks)) * 100.0, elapsedMs), 100.0);
+            d.avgQueueLength = SafeDiv(static_cast<double>(CounterMath::Delta(d.weightedTime, weightedTime)), elapsedMs);
+        }
+        d.queueDepth = static_cast<uint32_t>(f[8]);
+        d.readBytes = readBytes;
+        d.writeBytes = writeBytes;
+        d.reads = reads;
+        d.writes = writes;
+        d.readTime = readTime;
+        d.writeTime = writeTime;
+        d.busyOrIdleTime = ioTicks;
+        d.weightedTime = weightedTime;
+        d.hasBaseline = true;
+    }
+
+    for (const auto& d : devices) {
+        if (!d.seen) { removed = true; break; }
+    }
+    if (removed) {
+        // 设备被移除：重建索引（罕见路径，允许分配）；同号设备再次出现时重新识别
+        RemoveUnseen();
+        deviceIndex.clear();
+        for (size_t i = 0; i < devices.size(); ++i) {
+            const uint64_t id = devices[i].id;
+            deviceIndex.emplace(MakeKey(id >> 20, id & 0xFFFFF), static_cast<int>(i));
+        }
+    }
+
+    lastSampleNs = now;
+    return true;
+}
+
+#endif
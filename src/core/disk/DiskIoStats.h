@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// 块设备 I/O 统计（吞吐、IOPS、平均等待、利用率、队列深度）
+// 所有速率均基于单调时钟的相邻两次采样差值
+// Linux: /proc/diskstats（常驻 fd + pread），按 (major, minor) 哈希定位设备，稳定运行时解析过程不分配内存；
+//        分区在首次出现时通过 /sys/dev/block/M:m/partition 识别并跳过，loop/ram 设备也跳过
+// Windows: 对每个 \\.\PhysicalDriveN 保持打开的句柄，调用 IOCTL_DISK_PERFORMANCE
+class DiskIoStats {
+public:
+    struct Device {
+        std::string name;                 // sda / nvme0n1 / dm-0 / PhysicalDrive0
+        uint32_t id = 0;                  // Linux: (major << 20) | minor；Windows: 物理磁盘编号
+        double readBytesPerSec = 0.0;
+        double writeBytesPerSec = 0.0;
+        double readIops = 0.0;
+        double writeIops = 0.0;
+        double avgReadAwaitMs = 0.0;      // 本周期完成的读请求平均耗时（毫秒）
+        double avgWriteAwaitMs = 0.0;     // 本周期完成的写请求平均耗时（毫秒）
+        double avgAwaitMs = 0.0;          // 读写合计平均耗时（毫秒）
+        double utilizationPercent = 0.0;  // 设备忙碌时间占比（%）
+        double avgQueueLength = 0.0;      // 本周期平均队列长度
+        uint32_t queueDepth = 0;          // 采样时刻正在处理的请求数
+
+        // 上次采样的累计值（Windows 时间单位为100ns，Linux 为毫秒）
+        uint64_t readBytes = 0;
+        uint64_t writeBytes = 0;
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        uint64_t readTime = 0;
+        uint64_t writeTime = 0;
+        uint64_t busyOrIdleTime = 0;      // Linux: io_ticks（忙碌毫秒）；Windows: IdleTime（空闲100ns）
+        uint64_t weightedTime = 0;        // Linux: 加权队列时间（毫秒）
+        bool hasBaseline = false;
+        bool seen = false;                // 本次采样是否出现，用于移除已拔出的设备
+    };
+
+    DiskIoStats();
+    ~DiskIoStats();
+
+    DiskIoStats(const DiskIoStats&) = delete;
+    DiskIoStats& operator=(const DiskIoStats&) = delete;
+
+    // 采样一次；新设备在首次出现的周期只建立基线
+    bool Update();
+    // 重新枚举设备（Windows 下用于热插拔后重新打开句柄）
+    void Rescan();
+
+    const std::vector<Device>& GetDevices() const { return devices; }
+    bool IsAvailable() const { return available; }
+
+private:
+    void RemoveUnseen();
+
+    std::vector<Device> devices;
+    bool available = false;
+    uint64_t lastSampleNs = 0;
+
+#ifdef _WIN32
+    std::vector<HANDLE> handles;      // 与 devices 一一对应
+    void CloseHandles();
+#else
+    static uint64_t MakeKey(uint64_t major, uint64_t minor) { return (major << 32) | minor; }
+    bool IsWholeDisk(uint64_t major, uint64_t minor) const;
+
+    ProcFile diskStatsFile;
+    // (major, minor) -> devices 下标；-1 表示已确认跳过（分区、loop 等）
+    std::unordered_map<uint64_t, int> deviceIndex;
+#endif
+};
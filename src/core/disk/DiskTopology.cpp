@@ -0,0 +1,189 @@
+﻿#include "DiskTopology.h"
+#include "../Utils/CounterMath.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include "../Utils/WmiManager.h"
+#include <comdef.h>
+#include <wbemidl.h>
+#include <winioctl.h>
+#pragma comment(lib, "wbemuuid.lib")
+#else
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+DiskTopology::DiskTopology(WmiManager& wmiManager) : wmi(wmiManager) {}
+#else
+DiskTopology::DiskTopology() = default;
+#endif
+
+bool DiskTopology::Refresh() {
+    uint64_t now = CounterMath::MonotonicNowNs();
+    if (monitor.ConsumeChanges()) dirty = true;
+    if (!monitor.IsAvailable() && now - lastBuildNs >= kFallbackRebuildSeconds * 1000000000ULL) dirty = true;
+    if (!dirty) return false;
+
+    std::vector<Disk> rebuilt;
+    // 重建失败（如 WMI 暂时不可用）时保留旧拓扑，下次调用再试
+    if (!Rebuild(rebuilt)) return false;
+    disks = std::move(rebuilt);
+    dirty = false;
+    lastBuildNs = now;
+    ++generation;
+    return true;
+}
+
+#ifdef _WIN32
+
+namespace {
+    std::wstring VariantText(IWbemClassObject* obj, const wchar_t* name) {
+        std::wstring text;
+        VARIANT v;
+        VariantInit(&v);
+        if (SUCCEEDED(obj->Get(name, 0, &v, 0, 0)) && v.vt == VT_BSTR && v.bstrVal) text = v.bstrVal;
+        VariantClear(&v);
+        // 部分驱动返回的序列号带前后空格
+        size_t first = text.find_first_not_of(L' ');
+        if (first == std::wstring::npos) return std::wstring();
+        return text.substr(first, text.find_last_not_of(L' ') - first + 1);
+    }
+
+    // 盘符所在卷 -> 物理磁盘编号；跨多块磁盘的动态卷会失败，此时不建立映射
+    bool QueryDiskNumber(wchar_t letter, DWORD& diskNumber) {
+        wchar_t path[] = L"\\\\.\\?:";
+        path[4] = letter;
+        // IOCTL_STORAGE_GET_DEVICE_NUMBER 为 FILE_ANY_ACCESS，不需要读权限
+        HANDLE h = CreateFileW(path, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+        if (h == INVALID_HANDLE_VALUE) return false;
+        STORAGE_DEVICE_NUMBER number{};
+        DWORD returned = 0;
+        BOOL ok = DeviceIoControl(h, IOCTL_STORAGE_GET_DEVICE_NUMBER, NULL, 0, &number, sizeof(number), &returned, NULL);
+        CloseHandle(h);
+        if (!ok || number.DeviceType != FILE_DEVICE_DISK) return false;
+        diskNumber = number.DeviceNumber;
+        return true;
+    }
+}
+
+bool DiskTopology::Rebuild(std::vector<Disk>& out) {
+    IWbemServices* svc = wmi.GetWmiService();
+    if (!svc) {
+        Logger::Warn("WMI 服务无效，无法建立磁盘拓扑");
+        return false;
+    }
+    IEnumWbemClassObject* pEnum = nullptr;
+    HRESULT hr = svc->ExecQuery(bstr_t(L"WQL"), bstr_t(L"SELECT Index,Model,SerialNumber,InterfaceType,Size,MediaType FROM Win32_DiskDrive"),
+        WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, nullptr, &pEnum);
+    if (FAILED(hr) || !pEnum) {
+        Logger::Warn("查询 Win32_DiskDrive 失败");
+        return false;
+    }
+    IWbemClassObject* obj = nullptr;
+    ULONG ret = 0;
+    while (pEnum->Next(WBEM_INFINITE, 1, &obj, &ret) == S_OK) {
+        VARIANT vIndex, vSize;
+        VariantInit(&vIndex);
+        VariantInit(&vSize);
+        if (SUCCEEDED(obj->Get(L"Index", 0, &vIndex, 0, 0)) && (vIndex.vt == VT_I4 || vIndex.vt == VT_UI4)) {
+            Disk disk;
+            disk.index = (vIndex.vt == VT_I4) ? vIndex.intVal : static_cast<int>(vIndex.uintVal);
+            disk.device = "PhysicalDrive" + std::to_string(disk.index);
+            disk.model = VariantText(obj, L"Model");
+            disk.serialNumber = VariantText(obj, L"SerialNumber");
+            disk.interfaceType = VariantText(obj, L"InterfaceType");
+            if (SUCCEEDED(obj->Get(L"Size", 0, &vSize, 0, 0))) {
+                if (vSize.vt == VT_UI8) disk.capacity = vSize.ullVal;
+                else if (vSize.vt == VT_BSTR) disk.capacity = _wcstoui64(vSize.bstrVal, nullptr, 10);
+            }
+            std::wstring media = VariantText(obj, L"MediaType");
+            if (media.empty()) disk.mediaType = L"未知";
+            else if (media.find(L"SSD") != std::wstring::npos || media.find(L"Solid State") != std::wstring::npos) disk.mediaType = L"SSD";
+            else disk.mediaType = L"HDD";
+            out.push_back(std::move(disk));
+        }
+        VariantClear(&vIndex);
+        VariantClear(&vSize);
+        obj->Release();
+    }
+    pEnum->Release();
+    std::sort(out.begin(), out.end(), [](const Disk& a, const Disk& b) { return a.index < b.index; });
+
+    DWORD driveMask = GetLogicalDrives();
+    for (int i = 2; i < 26; ++i) {  // 跳过 A/B 软驱
+        if ((driveMask & (1u << i)) == 0) continue;
+        wchar_t root[] = L"?:\\";
+        root[0] = static_cast<wchar_t>(L'A' + i);
+        UINT driveType = GetDriveTypeW(root);
+        if (driveType != DRIVE_FIXED && driveType != DRIVE_REMOVABLE) continue;
+        DWORD diskNumber = 0;
+        if (!QueryDiskNumber(root[0], diskNumber)) continue;
+        for (auto& disk : out) {
+            if (disk.index == static_cast<int>(diskNumber)) {
+                disk.driveLetters.push_back(static_cast<char>('A' + i));
+                break;
+            }
+        }
+    }
+    Logger::Info("磁盘拓扑已重建: " + std::to_string(out.size()) + " 个物理磁盘");
+    return true;
+}
+
+#else
+
+namespace {
+    std::string ReadSysfsLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        size_t first = line.find_first_not_of(' ');
+        if (first == std::string::npos) return std::string();
+        return line.substr(first, line.find_last_not_of(' ') - first + 1);
+    }
+
+    std::wstring Widen(const std::string& text) {
+        return std::wstring(text.begin(), text.end());
+    }
+}
+
+bool DiskTopology::Rebuild(std::vector<Disk>& out) {
+    DIR* dir = opendir("/sys/block");
+    if (!dir) return false;
+    std::vector<std::string> names;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        std::string name = entry->d_name;
+        // 只有真实设备才有 device 链接；nvme0c0n1 为多路径隐藏节点
+        struct stat st;
+        if (stat(("/sys/block/" + name + "/device").c_str(), &st) != 0) continue;
+        if (name.compare(0, 4, "nvme") == 0 && name.find('c', 4) != std::string::npos) continue;
+        names.push_back(std::move(name));
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+        const std::string base = "/sys/block/" + name;
+        Disk disk;
+        disk.index = static_cast<int>(out.size());
+        disk.device = name;
+        disk.model = Widen(ReadSysfsLine(base + "/device/model"));
+        disk.serialNumber = Widen(ReadSysfsLine(base + "/device/serial"));
+        if (name.compare(0, 4, "nvme") == 0) disk.interfaceType = L"NVMe";
+        else if (name.compare(0, 6, "mmcblk") == 0) disk.interfaceType = L"MMC";
+        else if (name.compare(0, 2, "vd") == 0) disk.interfaceType = L"VirtIO";
+        else disk.interfaceType = L"SCSI";
+        // size 固定以 512 字节扇区计
+        disk.capacity = std::strtoull(ReadSysfsLine(base + "/size").c_str(), nullptr, 10) * 512;
+        std::string rotational = ReadSysfsLine(base + "/queue/rotational");
+        disk.mediaType = rotational.empty() ? L"未知" : (rotational == "0" ? L"SSD" : L"HDD");
+        out.push_back(std::move(disk));
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BlockDeviceMonitor.h"
+
+#ifdef _WIN32
+class WmiManager;
+#endif
+
+// 物理磁盘拓扑缓存（型号、序列号、接口、容量、介质类型及其承载的盘符）
+// 拓扑只在启动和收到块设备到达/移除通知时重建，稳定运行时 Refresh() 只检查一次变更计数；
+// 通知机制不可用时退回到每5分钟重建一次
+// Windows: Win32_DiskDrive 一次查询取基本信息，盘符通过 IOCTL_STORAGE_GET_DEVICE_NUMBER 映射到磁盘编号
+// Linux: /sys/block 下带 device 链接的块设备（排除 loop/ram/dm 等虚拟设备），没有盘符
+class DiskTopology {
+public:
+    struct Disk {
+        int index = -1;                     // Windows: PhysicalDriveN 的 N；Linux: 按名称排序后的序号
+        std::string device;                 // PhysicalDrive0 / sda / nvme0n1，与 SmartCollector、DiskIoStats 的设备名一致
+        std::wstring model;
+        std::wstring serialNumber;
+        std::wstring interfaceType;
+        std::wstring mediaType;             // SSD / HDD / 未知
+        uint64_t capacity = 0;
+        std::vector<char> driveLetters;     // 仅 Windows，按字母排序
+    };
+
+    static constexpr uint64_t kFallbackRebuildSeconds = 300;
+
+#ifdef _WIN32
+    explicit DiskTopology(WmiManager& wmi);
+#else
+    DiskTopology();
+#endif
+
+    DiskTopology(const DiskTopology&) = delete;
+    DiskTopology& operator=(const DiskTopology&) = delete;
+
+    // 有变更通知（或首次调用、被 Invalidate）时重建；返回是否重建
+    bool Refresh();
+    void Invalidate() { dirty = true; }
+
+    const std::vector<Disk>& GetDisks() const { return disks; }
+    // 每次重建后递增，使用方据此判断是否需要重新枚举自己的设备句柄
+    uint64_t GetGeneration() const { return generation; }
+
+private:
+    bool Rebuild(std::vector<Disk>& out);
+
+    BlockDeviceMonitor monitor;
+    std::vector<Disk> disks;
+    uint64_t generation = 0;
+    uint64_t lastBuildNs = 0;
+    bool dirty = true;
+
+#ifdef _WIN32
+    WmiManager& wmi;
+#endif
+};
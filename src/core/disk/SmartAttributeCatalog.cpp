@@ -0,0 +1,261 @@
+﻿#include "SmartAttributeCatalog.h"
+#include <array>
+
+namespace {
+    using F = SmartRawFormat;
+    using U = SmartUnit;
+
+    // 通用定义（多数厂商一致的含义）
+    constexpr SmartAttributeInfo kGeneric[] = {
+        { 1,   L"Raw_Read_Error_Rate",     L"读取错误率",               U::Count,   false, F::Raw48 },
+        { 2,   L"Throughput_Performance",  L"吞吐性能",                 U::None,    false, F::Raw48 },
+        { 3,   L"Spin_Up_Time",            L"主轴起转时间",             U::None,    false, F::Raw16 },
+        { 4,   L"Start_Stop_Count",        L"启停次数",                 U::Count,   false, F::Raw32 },
+        { 5,   L"Reallocated_Sector_Ct",   L"重新分配扇区数",           U::Count,   true,  F::Raw32 },
+        { 7,   L"Seek_Error_Rate",         L"寻道错误率",               U::Count,   false, F::Raw48 },
+        { 8,   L"Seek_Time_Performance",   L"寻道性能",                 U::None,    false, F::Raw48 },
+        { 9,   L"Power_On_Hours",          L"通电时间",                 U::Hours,   false, F::Raw32 },
+        { 10,  L"Spin_Retry_Count",        L"主轴起转重试次数",         U::Count,   true,  F::Raw32 },
+        { 11,  L"Calibration_Retry_Count", L"校准重试次数",             U::Count,   false, F::Raw32 },
+        { 12,  L"Power_Cycle_Count",       L"通电周期数",               U::Count,   false, F::Raw32 },
+        { 170, L"Available_Reservd_Space", L"可用预留空间",             U::Percent, true,  F::NormalizedPercent },
+        { 171, L"Program_Fail_Count",      L"编程失败次数",             U::Count,   true,  F::Raw32 },
+        { 172, L"Erase_Fail_Count",        L"擦除失败次数",             U::Count,   true,  F::Raw32 },
+        { 173, L"Wear_Leveling_Count",     L"平均擦写次数",             U::Count,   false, F::Raw32 },
+        { 174, L"Unexpect_Power_Loss_Ct",  L"意外断电次数",             U::Count,   false, F::Raw32 },
+        { 177, L"Wear_Leveling_Count",     L"磨损均衡（剩余寿命）",     U::Percent, false, F::NormalizedPercent },
+        { 179, L"Used_Rsvd_Blk_Cnt_Tot",   L"已用预留块总数",           U::Count,   true,  F::Raw32 },
+        { 181, L"Program_Fail_Cnt_Total",  L"编程失败总数",             U::Count,   true,  F::Raw32 },
+        { 182, L"Erase_Fail_Count_Total",  L"擦除失败总数",             U::Count,   true,  F::Raw32 },
+        { 183, L"Runtime_Bad_Block",       L"运行时坏块数",             U::Count,   true,  F::Raw32 },
+        { 184, L"End-to-End_Error",        L"端到端校验错误",           U::Count,   true,  F::Raw32 },
+        { 187, L"Reported_Uncorrect",      L"报告的不可纠正错误",       U::Count,   true,  F::Raw32 },
+        { 188, L"Command_Timeout",         L"命令超时",                 U::Count,   true,  F::Raw16 },
+        { 189, L"High_Fly_Writes",         L"磁头飞行高度异常写入",     U::Count,   false, F::Raw32 },
+        { 190, L"Airflow_Temperature_Cel", L"气流温度",                 U::Celsius, false, F::TempMinMaxAirflow },
+        { 191, L"G-Sense_Error_Rate",      L"震动错误率",               U::Count,   false, F::Raw32 },
+        { 192, L"Power-Off_Retract_Count", L"断电磁头收回次数",         U::Count,   false, F::Raw32 },
+        { 193, L"Load_Cycle_Count",        L"磁头加载/卸载次数",        U::Count,   false, F::Raw32 },
+        { 194, L"Temperature_Celsius",     L"温度",                     U::Celsius, false, F::TempMinMax },
+        { 195, L"Hardware_ECC_Recovered",  L"硬件ECC纠正次数",          U::Count,   false, F::Raw32 },
+        { 196, L"Reallocated_Event_Count", L"重新分配事件数",           U::Count,   true,  F::Raw32 },
+        { 197, L"Current_Pending_Sector",  L"当前待映射扇区数",         U::Count,   true,  F::Raw32 },
+        { 198, L"Offline_Uncorrectable",   L"离线不可纠正扇区数",       U::Count,   true,  F::Raw32 },
+        { 199, L"UDMA_CRC_Error_Count",    L"接口CRC错误（线缆）",      U::Count,   false, F::Raw32 },
+        { 200, L"Multi_Zone_Error_Rate",   L"写入错误率",               U::Count,   false, F::Raw32 },
+        { 202, L"Percent_Lifetime_Remain", L"剩余寿命百分比",           U::Percent, false, F::NormalizedPercent },
+        { 220, L"Disk_Shift",              L"盘片偏移",                 U::Count,   false, F::Raw32 },
+        { 222, L"Loaded_Hours",            L"磁头加载时间",             U::Hours,   false, F::Raw32 },
+        { 225, L"Load_Cycle_Count",        L"磁头加载次数",             U::Count,   false, F::Raw32 },
+        { 231, L"SSD_Life_Left",           L"SSD剩余寿命",              U::Percent, false, F::NormalizedPercent },
+        { 232, L"Available_Reservd_Space", L"可用预留空间",             U::Percent, true,  F::NormalizedPercent },
+        { 233, L"Media_Wearout_Indicator", L"介质磨损指示",             U::Percent, false, F::NormalizedPercent },
+        { 240, L"Head_Flying_Hours",       L"磁头飞行时间",             U::Hours,   false, F::Raw32 },
+        { 241, L"Total_LBAs_Written",      L"累计写入量",               U::Bytes,   false, F::Lba512 },
+        { 242, L"Total_LBAs_Read",         L"累计读取量",               U::Bytes,   false, F::Lba512 },
+        { 246, L"Total_Host_Sector_Write", L"主机累计写入量",           U::Bytes,   false, F::Lba512 },
+    };
+
+    constexpr SmartAttributeInfo kIntelSsd[] = {
+        { 225, L"Host_Writes_32MiB",       L"主机写入量",               U::Bytes,   false, F::Units32MiB },
+        { 226, L"Workld_Media_Wear_Indic", L"负载介质磨损",             U::None,    false, F::Raw32 },
+        { 233, L"Media_Wearout_Indicator", L"介质磨损指示",             U::Percent, false, F::NormalizedPercent },
+        { 241, L"Host_Writes_32MiB",       L"主机写入量",               U::Bytes,   false, F::Units32MiB },
+        { 242, L"Host_Reads_32MiB",        L"主机读取量",               U::Bytes,   false, F::Units32MiB },
+    };
+
+    constexpr SmartAttributeInfo kSamsungSsd[] = {
+        { 177, L"Wear_Leveling_Count",     L"磨损均衡（剩余寿命）",     U::Percent, false, F::NormalizedPercent },
+        { 179, L"Used_Rsvd_Blk_Cnt_Tot",   L"已用预留块总数",           U::Count,   true,  F::Raw32 },
+        { 235, L"POR_Recovery_Count",      L"异常断电恢复次数",         U::Count,   false, F::Raw32 },
+    };
+
+    constexpr SmartAttributeInfo kCrucialMicronSsd[] = {
+        { 173, L"Ave_Block-Erase_Count",   L"平均块擦除次数",           U::Count,   false, F::Raw32 },
+        { 202, L"Percent_Lifetime_Remain", L"剩余寿命百分比",           U::Percent, false, F::NormalizedPercent },
+        { 246, L"Total_LBAs_Written",      L"主机累计写入量",           U::Bytes,   false, F::Lba512 },
+        { 247, L"Host_Program_Page_Count", L"主机编程页数",             U::Count,   false, F::Raw48 },
+        { 248, L"FTL_Program_Page_Count",  L"FTL编程页数",              U::Count,   false, F::Raw48 },
+    };
+
+    constexpr SmartAttributeInfo kSandForceSsd[] = {
+        { 230, L"Life_Curve_Status",       L"寿命曲线状态",             U::None,    false, F::Raw32 },
+        { 231, L"SSD_Life_Left",           L"SSD剩余寿命",              U::Percent, false, F::NormalizedPercent },
+        { 233, L"SandForce_Internal",      L"控制器内部写入量",         U::Bytes,   false, F::UnitsGiB },
+        { 241, L"Lifetime_Writes_GiB",     L"累计写入量",               U::Bytes,   false, F::UnitsGiB },
+        { 242, L"Lifetime_Reads_GiB",      L"累计读取量",               U::Bytes,   false, F::UnitsGiB },
+    };
+
+    constexpr SmartAttributeInfo kSeagateHdd[] = {
+        { 1,   L"Raw_Read_Error_Rate",     L"读取错误数",               U::Count,   false, F::SeagateErrorRate },
+        { 7,   L"Seek_Error_Rate",         L"寻道错误数",               U::Count,   false, F::SeagateErrorRate },
+        { 195, L"Hardware_ECC_Recovered",  L"硬件ECC纠正次数",          U::Count,   false, F::SeagateErrorRate },
+    };
+
+    template <size_t N>
+    constexpr std::array<uint8_t, 256> BuildIndex(const SmartAttributeInfo (&table)[N]) {
+        static_assert(N < 256, "通用表项数必须小于256");
+        std::array<uint8_t, 256> index{};
+        for (size_t i = 0; i < N; ++i) index[table[i].id] = static_cast<uint8_t>(i + 1);
+        return index;
+    }
+
+    // ID -> kGeneric 下标 + 1（0 表示未收录）
+    constexpr std::array<uint8_t, 256> kGenericIndex = BuildIndex(kGeneric);
+
+    // 未收录属性的名称 "Unknown_Attribute_<ID>"，编译期生成，发布时不再格式化
+    using UnknownNameText = std::array<wchar_t, 24>;
+
+    constexpr std::array<UnknownNameText, 256> BuildUnknownNames() {
+        constexpr wchar_t prefix[] = L"Unknown_Attribute_";
+        std::array<UnknownNameText, 256> names{};
+        for (size_t id = 0; id < 256; ++id) {
+            size_t length = 0;
+            for (; prefix[length]; ++length) names[id][length] = prefix[length];
+            if (id >= 100) names[id][length++] = static_cast<wchar_t>(L'0' + id / 100);
+            if (id >= 10) names[id][length++] = static_cast<wchar_t>(L'0' + id / 10 % 10);
+            names[id][length] = static_cast<wchar_t>(L'0' + id % 10);
+        }
+        return names;
+    }
+
+    constexpr std::array<UnknownNameText, 256> kUnknownNames = BuildUnknownNames();
+
+    struct FamilyTable {
+        const SmartAttributeInfo* entries;
+        size_t count;
+    };
+
+    template <size_t N>
+    constexpr FamilyTable MakeTable(const SmartAttributeInfo (&table)[N]) { return { table, N }; }
+
+    // 与 SmartDriveFamily 枚举顺序一致
+    constexpr FamilyTable kFamilyTables[] = {
+        { nullptr, 0 },
+        MakeTable(kIntelSsd),
+        MakeTable(kSamsungSsd),
+        MakeTable(kCrucialMicronSsd),
+        MakeTable(kSandForceSsd),
+        MakeTable(kSeagateHdd),
+    };
+
+    struct FamilyPattern {
+        std::string_view prefix;
+        SmartDriveFamily family;
+    };
+
+    constexpr FamilyPattern kFamilyPatterns[] = {
+        { "INTEL SSD",   SmartDriveFamily::IntelSsd },
+        { "Intel SSD",   SmartDriveFamily::IntelSsd },
+        { "Samsung SSD", SmartDriveFamily::SamsungSsd },
+        { "SAMSUNG MZ",  SmartDriveFamily::SamsungSsd },
+        { "Crucial",     SmartDriveFamily::CrucialMicronSsd },
+        { "CT",          SmartDriveFamily::CrucialMicronSsd },   // CT500MX500SSD1 等
+        { "Micron",      SmartDriveFamily::CrucialMicronSsd },
+        { "KINGSTON SV", SmartDriveFamily::SandForceSsd },
+        { "KINGSTON SH", SmartDriveFamily::SandForceSsd },
+        { "SandForce",   SmartDriveFamily::SandForceSsd },
+        { "ST",          SmartDriveFamily::SeagateHdd },         // ST4000DM004 等
+    };
+
+    double ScaleBytes(uint64_t units, double bytesPerUnit) {
+        return static_cast<double>(units) * bytesPerUnit;
+    }
+}
+
+SmartDriveFamily SmartAttributeCatalog::DetectFamily(std::string_view model) {
+    while (!model.empty() && model.front() == ' ') model.remove_prefix(1);
+    for (const auto& pattern : kFamilyPatterns) {
+        if (model.substr(0, pattern.prefix.size()) != pattern.prefix) continue;
+        // "CT"/"ST" 前缀过短，要求后面紧跟数字以免误判
+        if (pattern.prefix.size() == 2 &&
+            (model.size() <= 2 || model[2] < '0' || model[2] > '9')) continue;
+        return pattern.family;
+    }
+    return SmartDriveFamily::Generic;
+}
+
+const SmartAttributeInfo* SmartAttributeCatalog::Lookup(SmartDriveFamily family, uint8_t id) {
+    const FamilyTable& table = kFamilyTables[static_cast<size_t>(family)];
+    for (size_t i = 0; i < table.count; ++i) {
+        if (table.entries[i].id == id) return &table.entries[i];
+    }
+    uint8_t slot = kGenericIndex[id];
+    return slot ? &kGeneric[slot - 1] : nullptr;
+}
+
+SmartDecodedValue SmartAttributeCatalog::Decode(const SmartAttributeInfo* info, const SmartParser::AtaAttribute& a) {
+    SmartDecodedValue out;
+    if (!info) {
+        out.value = static_cast<double>(a.rawValue);
+        return out;
+    }
+    switch (info->format) {
+    case F::Raw48:
+        out.value = static_cast<double>(a.rawValue);
+        break;
+    case F::Raw32:
+        out.value = static_cast<double>(a.rawValue & 0xFFFFFFFFull);
+        break;
+    case F::Raw16:
+        out.value = static_cast<double>(a.rawValue & 0xFFFFull);
+        break;
+    case F::TempMinMax:
+        out.value = a.raw[0];
+        // 部分盘在字节2/4记录最低/最高温度，顺序不固定，按大小归位
+        if (a.raw[2] && a.raw[4]) {
+            out.minValue = (a.raw[2] < a.raw[4]) ? a.raw[2] : a.raw[4];
+            out.maxValue = (a.raw[2] < a.raw[4]) ? a.raw[4] : a.raw[2];
+        }
+        break;
+    case F::TempMinMaxAirflow:
+        out.value = a.raw[0];
+        if (a.raw[2] || a.raw[3]) {
+            out.minValue = a.raw[2];
+            out.maxValue = a.raw[3];
+        }
+        break;
+    case F::SeagateErrorRate:
+        out.value = static_cast<double>((a.rawValue >> 32) & 0xFFFFull);
+        break;
+    case F::Lba512:
+        out.value = ScaleBytes(a.rawValue, 512.0);
+        break;
+    case F::Units32MiB:
+        out.value = ScaleBytes(a.rawValue, 32.0 * 1024 * 1024);
+        break;
+    case F::UnitsGiB:
+        out.value = ScaleBytes(a.rawValue, 1024.0 * 1024 * 1024);
+        break;
+    case F::NormalizedPercent:
+        out.value = a.current > 100 ? 100.0 : a.current;
+        break;
+    }
+    return out;
+}
+
+const wchar_t* SmartAttributeCatalog::UnknownName(uint8_t id) {
+    return kUnknownNames[id].data();
+}
+
+const wchar_t* SmartAttributeCatalog::UnitText(SmartUnit unit) {
+    switch (unit) {
+    case U::Count:   return L"次";
+    case U::Hours:   return L"小时";
+    case U::Celsius: return L"°C";
+    case U::Bytes:   return L"字节";
+    case U::Percent: return L"%";
+    default:         return L"";
+    }
+}
+
+const wchar_t* SmartAttributeCatalog::FamilyName(SmartDriveFamily family) {
+    switch (family) {
+    case SmartDriveFamily::IntelSsd:         return L"Intel SSD";
+    case SmartDriveFamily::SamsungSsd:       return L"Samsung SSD";
+    case SmartDriveFamily::CrucialMicronSsd: return L"Crucial/Micron SSD";
+    case SmartDriveFamily::SandForceSsd:     return L"SandForce SSD";
+    case SmartDriveFamily::SeagateHdd:       return L"Seagate HDD";
+    default:                                 return L"通用";
+    }
+}
@@ -0,0 +1,62 @@
+﻿#pragma once
+#include <cstdint>
+#include <string_view>
+#include "SmartParser.h"
+
+// SMART 属性目录（编译期常量表）
+// 按属性ID给出名称、描述、单位、是否关键以及原始值解码方式；厂商对同一ID的含义/单位不同，按型号族覆盖通用定义
+// 所有字符串均为静态存储的字面量，快照中只保存指针，发布时才拷贝进共享内存
+enum class SmartRawFormat : uint8_t {
+    Raw48,              // 48位计数器
+    Raw32,              // 低32位计数器（高位为厂商附加信息）
+    Raw16,              // 低16位计数器
+    TempMinMax,         // 字节0 当前温度，字节2/4 为最低/最高（194）
+    TempMinMaxAirflow,  // 字节0 当前温度，字节2/3 为最低/最高（190）
+    SeagateErrorRate,   // 高16位为错误数，低32位为操作数（Seagate 1/7/195）
+    Lba512,             // LBA 计数，每个 512 字节
+    Units32MiB,         // 每单位 32MiB（Intel 225/241/242）
+    UnitsGiB,           // 每单位 1GiB（SandForce 241/242）
+    NormalizedPercent,  // 取归一化当前值作为百分比（剩余寿命类）
+};
+
+enum class SmartUnit : uint8_t { None, Count, Hours, Celsius, Bytes, Percent };
+
+enum class SmartDriveFamily : uint8_t {
+    Generic,
+    IntelSsd,
+    SamsungSsd,
+    CrucialMicronSsd,
+    SandForceSsd,
+    SeagateHdd,
+};
+
+struct SmartAttributeInfo {
+    uint8_t id;
+    const wchar_t* name;
+    const wchar_t* description;
+    SmartUnit unit;
+    bool critical;              // 关键属性：数值增长或越过阈值通常预示故障
+    SmartRawFormat format;
+};
+
+struct SmartDecodedValue {
+    double value = 0.0;         // 按单位换算后的物理值
+    double minValue = 0.0;      // 仅温度类：历史最低（无记录为0）
+    double maxValue = 0.0;      // 仅温度类：历史最高（无记录为0）
+};
+
+class SmartAttributeCatalog {
+public:
+    // 按型号字符串识别厂商族，未知型号返回 Generic
+    static SmartDriveFamily DetectFamily(std::string_view model);
+
+    // 查找属性定义：先查厂商覆盖表，再查通用表（256项编译期索引，O(1)）；未收录的ID返回 nullptr
+    static const SmartAttributeInfo* Lookup(SmartDriveFamily family, uint8_t id);
+
+    static SmartDecodedValue Decode(const SmartAttributeInfo* info, const SmartParser::AtaAttribute& attribute);
+
+    // 未收录属性的显示名称 "Unknown_Attribute_<ID>"（静态存储）
+    static const wchar_t* UnknownName(uint8_t id);
+    static const wchar_t* UnitText(SmartUnit unit);
+    static const wchar_t* FamilyName(SmartDriveFamily family);
+};
@@ -0,0 +1,290 @@
+﻿#include "SmartCollector.h"
+#include "../Utils/CounterMath.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <dirent.h>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <scsi/sg.h>
+#include <linux/nvme_ioctl.h>
+#endif
+
+SmartCollector::SmartCollector(uint64_t refreshSeconds)
+    : refreshIntervalNs(refreshSeconds * 1000000000ull) {
+}
+
+const SmartCollector::Report* SmartCollector::Find(const std::string& device) const {
+    for (const auto& report : reports) {
+        if (report.device == device) return &report;
+    }
+    return nullptr;
+}
+
+bool SmartCollector::Refresh(bool force) {
+    uint64_t now = CounterMath::MonotonicNowNs();
+    if (!force && hasRefreshed && now - lastRefreshNs < refreshIntervalNs) return false;
+    lastRefreshNs = now;
+    hasRefreshed = true;
+
+    // 按本次枚举结果重建列表，已有设备保留上次结果（待机跳过时仍可发布旧数据）
+    std::vector<Report> next;
+    for (const auto& name : EnumerateDevices()) {
+        const Report* previous = Find(name);
+        Report report = previous ? *previous : Report{};
+        report.device = name;
+        report.skippedStandby = false;
+        if (CollectDevice(report)) {
+            report.supported = true;
+            report.collectedNs = now;
+            report.family = SmartAttributeCatalog::DetectFamily(report.model);
+            DecodeAttributes(report);
+            report.summary = report.isNvme ? SmartParser::SummarizeNvme(report.nvme)
+                                           : SmartParser::SummarizeAta(report.ata, report.family);
+        }
+        next.push_back(std::move(report));
+    }
+    reports.swap(next);
+    ++generation;
+    return true;
+}
+
+void SmartCollector::DecodeAttributes(Report& report) {
+    for (int i = 0; i < report.ata.count; ++i) {
+        const auto& attribute = report.ata.attributes[i];
+        report.attributeInfo[i] = SmartAttributeCatalog::Lookup(report.family, attribute.id);
+        report.decoded[i] = SmartAttributeCatalog::Decode(report.attributeInfo[i], attribute);
+    }
+}
+
+#ifdef _WIN32
+
+namespace {
+    bool ReadAtaPage(HANDLE h, BYTE feature, uint8_t* page) {
+        SENDCMDINPARAMS in{};
+        in.cBufferSize = READ_ATTRIBUTE_BUFFER_SIZE;
+        in.irDriveRegs.bFeaturesReg = feature;
+        in.irDriveRegs.bSectorCountReg = 1;
+        in.irDriveRegs.bSectorNumberReg = 1;
+        in.irDriveRegs.bCylLowReg = SMART_CYL_LOW;
+        in.irDriveRegs.bCylHighReg = SMART_CYL_HI;
+        in.irDriveRegs.bDriveHeadReg = 0xA0;
+        in.irDriveRegs.bCommandReg = SMART_CMD;
+
+        BYTE out[sizeof(SENDCMDOUTPARAMS) + READ_ATTRIBUTE_BUFFER_SIZE] = {};
+        DWORD returned = 0;
+        if (!DeviceIoControl(h, SMART_RCV_DRIVE_DATA, &in, sizeof(in) - 1, out, sizeof(out), &returned, NULL)) return false;
+        memcpy(page, reinterpret_cast<SENDCMDOUTPARAMS*>(out)->bBuffer, SmartParser::kPageSize);
+        return true;
+    }
+
+    bool ReadNvmeHealthPage(HANDLE h, uint8_t* page) {
+        constexpr DWORD bufferSize = FIELD_OFFSET(STORAGE_PROPERTY_QUERY, AdditionalParameters)
+            + sizeof(STORAGE_PROTOCOL_SPECIFIC_DATA) + SmartParser::kPageSize;
+        BYTE buffer[bufferSize] = {};
+
+        auto* query = reinterpret_cast<PSTORAGE_PROPERTY_QUERY>(buffer);
+        auto* protocol = reinterpret_cast<PSTORAGE_PROTOCOL_SPECIFIC_DATA>(query->AdditionalParameters);
+        query->PropertyId = StorageDeviceProtocolSpecificProperty;
+        query->QueryType = PropertyStandardQuery;
+        protocol->ProtocolType = ProtocolTypeNvme;
+        protocol->DataType = NVMeDataTypeLogPage;
+        protocol->ProtocolDataRequestValue = 0x02;   // SMART / Health Information
+        protocol->ProtocolDataRequestSubValue = 0;
+        protocol->ProtocolDataOffset = sizeof(STORAGE_PROTOCOL_SPECIFIC_DATA);
+        protocol->ProtocolDataLength = SmartParser::kPageSize;
+
+        DWORD returned = 0;
+        if (!DeviceIoControl(h, IOCTL_STORAGE_QUERY_PROPERTY, buffer, bufferSize, buffer, bufferSize, &returned, NULL)) return false;
+
+        auto* descriptor = reinterpret_cast<PSTORAGE_PROTOCOL_DATA_DESCRIPTOR>(buffer);
+        protocol = &descriptor->ProtocolSpecificData;
+        if (protocol->ProtocolDataOffset < sizeof(STORAGE_PROTOCOL_SPECIFIC_DATA) ||
+            protocol->ProtocolDataLength < SmartParser::kPageSize) return false;
+        memcpy(page, reinterpret_cast<BYTE*>(protocol) + protocol->ProtocolDataOffset, SmartParser::kPageSize);
+        return true;
+    }
+
+    // 查询总线类型与型号（ProductId）
+    STORAGE_BUS_TYPE QueryDeviceDescriptor(HANDLE h, std::string& model) {
+        STORAGE_PROPERTY_QUERY query{};
+        query.PropertyId = StorageDeviceProperty;
+        query.QueryType = PropertyStandardQuery;
+        BYTE buffer[1024] = {};
+        DWORD returned = 0;
+        if (!DeviceIoControl(h, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query), buffer, sizeof(buffer), &returned, NULL)) {
+            return BusTypeUnknown;
+        }
+        auto* descriptor = reinterpret_cast<STORAGE_DEVICE_DESCRIPTOR*>(buffer);
+        if (descriptor->ProductIdOffset && descriptor->ProductIdOffset < returned) {
+            const char* text = reinterpret_cast<const char*>(buffer) + descriptor->ProductIdOffset;
+            model.assign(text, strnlen(text, returned - descriptor->ProductIdOffset));
+            while (!model.empty() && model.back() == ' ') model.pop_back();
+        }
+        return descriptor->BusType;
+    }
+}
+
+std::vector<std::string> SmartCollector::EnumerateDevices() const {
+    std::vector<std::string> names;
+    for (int n = 0; n < 64; ++n) {
+        std::wstring path = L"\\\\.\\PhysicalDrive" + std::to_wstring(n);
+        HANDLE h = CreateFileW(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+        if (h == INVALID_HANDLE_VALUE) continue;
+        CloseHandle(h);
+        names.push_back("PhysicalDrive" + std::to_string(n));
+    }
+    return names;
+}
+
+bool SmartCollector::CollectDevice(Report& report) {
+    std::wstring path = L"\\\\.\\" + std::wstring(report.device.begin(), report.device.end());
+    HANDLE h = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+    if (h == INVALID_HANDLE_VALUE) return false;
+
+    // 磁盘已停转时不发送 SMART 命令，避免把它唤醒
+    BOOL powered = TRUE;
+    if (GetDevicePowerState(h, &powered) && !powered) {
+        report.skippedStandby = true;
+        CloseHandle(h);
+        return false;
+    }
+
+    uint8_t page[SmartParser::kPageSize];
+    bool ok = false;
+    report.isNvme = QueryDeviceDescriptor(h, report.model) == BusTypeNvme;
+    if (report.isNvme) {
+        ok = ReadNvmeHealthPage(h, page) && SmartParser::ParseNvmeHealthLog(page, sizeof(page), report.nvme);
+    } else if (ReadAtaPage(h, READ_ATTRIBUTES, page) && SmartParser::ParseAtaSmartData(page, sizeof(page), report.ata)) {
+        ok = true;
+        if (ReadAtaPage(h, READ_THRESHOLDS, page)) SmartParser::ParseAtaThresholds(page, sizeof(page), report.ata);
+    }
+    CloseHandle(h);
+    if (!ok && !report.supported) Logger::Debug("SMART: " + report.device + " 不支持或读取失败");
+    return ok;
+}
+
+#else
+
+namespace {
+    constexpr unsigned kSgTimeoutMs = 5000;
+
+    // 从描述符格式 sense 中取 ATA Status Return 描述符（0x09）
+    const uint8_t* FindAtaReturnDescriptor(const uint8_t* sense, size_t length) {
+        if (length < 8 || (sense[0] & 0x7F) != 0x72) return nullptr;
+        size_t total = (std::min)(length, static_cast<size_t>(8 + sense[7]));
+        for (size_t i = 8; i + 1 < total; i += 2 + sense[i + 1]) {
+            if (sense[i] == 0x09 && i + 14 <= total) return sense + i;
+        }
+        return nullptr;
+    }
+
+    bool AtaPassThrough(int fd, uint8_t command, uint8_t feature, uint8_t* data, uint8_t* sense, size_t senseLength, bool checkCondition) {
+        uint8_t cdb[16] = {};
+        cdb[0] = 0x85;                                  // ATA PASS-THROUGH(16)
+        cdb[1] = data ? (4 << 1) : (3 << 1);            // PIO Data-In / Non-data
+        cdb[2] = data ? 0x0E : (checkCondition ? 0x20 : 0x00); // t_dir=读, byt_blok=1, t_length=sector count；或 ck_cond
+        cdb[4] = feature;
+        cdb[6] = data ? 1 : 0;
+        cdb[10] = 0x4F;                                 // SMART 签名
+        cdb[12] = 0xC2;
+        cdb[14] = command;
+
+        sg_io_hdr_t hdr{};
+        hdr.interface_id = 'S';
+        hdr.cmd_len = sizeof(cdb);
+        hdr.cmdp = cdb;
+        hdr.mx_sb_len = static_cast<unsigned char>(senseLength);
+        hdr.sbp = sense;
+        hdr.timeout = kSgTimeoutMs;
+        hdr.dxfer_direction = data ? SG_DXFER_FROM_DEV : SG_DXFER_NONE;
+        hdr.dxfer_len = data ? static_cast<unsigned>(SmartParser::kPageSize) : 0;
+        hdr.dxferp = data;
+        if (ioctl(fd, SG_IO, &hdr) != 0 || hdr.host_status != 0) return false;
+        if (hdr.status == 0) return true;
+        // CHECK CONDITION + RECOVERED ERROR 是 ATA 透传返回寄存器的正常方式
+        uint8_t senseKey = (sense[0] & 0x7F) >= 0x72 ? (sense[1] & 0x0F) : (sense[2] & 0x0F);
+        return hdr.status == 0x02 && senseKey == 0x01;
+    }
+
+    // CHECK POWER MODE：Sector Count 为 0x00 表示待机（已停转）
+    bool IsAtaStandby(int fd) {
+        uint8_t sense[32] = {};
+        if (!AtaPassThrough(fd, 0xE5, 0, nullptr, sense, sizeof(sense), true)) return false;
+        const uint8_t* ata = FindAtaReturnDescriptor(sense, sizeof(sense));
+        return ata && ata[5] == 0x00;
+    }
+
+    bool ReadAtaPage(int fd, uint8_t feature, uint8_t* page) {
+        uint8_t sense[32] = {};
+        return AtaPassThrough(fd, 0xB0, feature, page, sense, sizeof(sense), false);
+    }
+
+    bool ReadNvmeHealthPage(int fd, uint8_t* page) {
+        nvme_admin_cmd cmd{};
+        cmd.opcode = 0x02;                              // Get Log Page
+        cmd.nsid = 0xFFFFFFFF;                          // 控制器全局
+        cmd.addr = reinterpret_cast<uintptr_t>(page);
+        cmd.data_len = static_cast<uint32_t>(SmartParser::kPageSize);
+        cmd.cdw10 = ((SmartParser::kPageSize / 4 - 1) << 16) | 0x02;   // NUMDL | LID
+        cmd.timeout_ms = kSgTimeoutMs;
+        return ioctl(fd, NVME_IOCTL_ADMIN_CMD, &cmd) == 0;
+    }
+
+    // nvme0n1 -> nvme0（健康日志通过控制器字符设备读取）
+    std::string NvmeControllerOf(const std::string& name) {
+        size_t pos = name.find('n', 4);
+        return pos == std::string::npos ? name : name.substr(0, pos);
+    }
+}
+
+std::vector<std::string> SmartCollector::EnumerateDevices() const {
+    std::vector<std::string> names;
+    DIR* dir = opendir("/sys/block");
+    if (!dir) return names;
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        bool isSd = name.compare(0, 2, "sd") == 0;
+        // nvme0c0n1 为多路径隐藏节点，跳过
+        bool isNvme = name.compare(0, 4, "nvme") == 0 && name.find('c', 4) == std::string::npos;
+        if (isSd || isNvme) names.push_back(name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool SmartCollector::CollectDevice(Report& report) {
+    report.isNvme = report.device.compare(0, 4, "nvme") == 0;
+    if (report.model.empty()) {
+        std::ifstream modelFile("/sys/block/" + report.device + "/device/model");
+        std::getline(modelFile, report.model);
+        while (!report.model.empty() && report.model.back() == ' ') report.model.pop_back();
+    }
+    std::string path = "/dev/" + (report.isNvme ? NvmeControllerOf(report.device) : report.device);
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    alignas(8) uint8_t page[SmartParser::kPageSize] = {};
+    bool ok = false;
+    if (report.isNvme) {
+        ok = ReadNvmeHealthPage(fd, page) && SmartParser::ParseNvmeHealthLog(page, sizeof(page), report.nvme);
+    } else if (IsAtaStandby(fd)) {
+        // 磁盘已停转时不发送 SMART 命令，避免把它唤醒
+        report.skippedStandby = true;
+    } else if (ReadAtaPage(fd, 0xD0, page) && SmartParser::ParseAtaSmartData(page, sizeof(page), report.ata)) {
+        ok = true;
+        if (ReadAtaPage(fd, 0xD1, page)) SmartParser::ParseAtaThresholds(page, sizeof(page), report.ata);
+    }
+    close(fd);
+    return ok;
+}
+
+#endif
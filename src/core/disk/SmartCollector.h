@@ -0,0 +1,57 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SmartParser.h"
+#include "SmartAttributeCatalog.h"
+
+// SMART / NVMe 健康信息采集
+// 负责设备 I/O，数据页解码交给 SmartParser；结果缓存并按较长周期（默认10分钟）刷新，
+// 因为查询 SMART 会唤醒已休眠的机械盘。处于待机状态的磁盘本周期跳过，保留上次结果
+// Windows: SMART_RCV_DRIVE_DATA（ATA）、IOCTL_STORAGE_QUERY_PROPERTY 协议相关数据（NVMe），需要管理员权限
+// Linux: SG_IO ATA PASS-THROUGH(16)（ATA/SATA）、NVME_IOCTL_ADMIN_CMD（NVMe），需要 root 权限
+class SmartCollector {
+public:
+    struct Report {
+        std::string device;                 // PhysicalDrive0 / sda / nvme0n1
+        std::string model;                  // 型号，用于识别属性目录的厂商族
+        SmartDriveFamily family = SmartDriveFamily::Generic;
+        bool isNvme = false;
+        bool supported = false;             // 至少成功读取过一次
+        bool skippedStandby = false;        // 最近一次因磁盘待机而跳过
+        SmartParser::AtaSmartData ata;
+        // 与 ata.attributes 一一对应：目录项（未收录为 nullptr）与解码后的物理值，在采集时解码一次
+        const SmartAttributeInfo* attributeInfo[SmartParser::kMaxAtaAttributes] = {};
+        SmartDecodedValue decoded[SmartParser::kMaxAtaAttributes];
+        SmartParser::NvmeHealth nvme;
+        SmartParser::HealthSummary summary;
+        uint64_t collectedNs = 0;           // 最近一次成功采集的单调时间
+    };
+
+    static constexpr uint64_t kDefaultRefreshSeconds = 600;
+
+    explicit SmartCollector(uint64_t refreshSeconds = kDefaultRefreshSeconds);
+
+    SmartCollector(const SmartCollector&) = delete;
+    SmartCollector& operator=(const SmartCollector&) = delete;
+
+    // 刷新周期到期（或 force）时重新枚举并采集；未到期时只读一次时钟。返回是否进行了采集
+    bool Refresh(bool force = false);
+
+    const Report* Find(const std::string& device) const;
+    const std::vector<Report>& GetReports() const { return reports; }
+    // 每次采集到新数据时递增，供发布端判断是否需要重新拷贝
+    uint64_t GetGeneration() const { return generation; }
+
+private:
+    std::vector<std::string> EnumerateDevices() const;
+    static void DecodeAttributes(Report& report);
+    // 采集单个设备；返回 false 表示不支持、读取失败或待机跳过
+    bool CollectDevice(Report& report);
+
+    std::vector<Report> reports;
+    uint64_t refreshIntervalNs;
+    uint64_t lastRefreshNs = 0;
+    bool hasRefreshed = false;
+    uint64_t generation = 0;
+};
@@ -0,0 +1,177 @@
+﻿#include "SmartParser.h"
+#include "SmartAttributeCatalog.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // ATA SMART 数据页布局：偏移2起30个12字节属性槽
+    constexpr size_t kAtaTableOffset = 2;
+    constexpr size_t kAtaEntrySize = 12;
+    constexpr size_t kAtaOfflineStatusOffset = 362;
+    constexpr size_t kAtaSelfTestStatusOffset = 363;
+
+    double KelvinToCelsius(uint64_t kelvin) {
+        return kelvin ? static_cast<double>(kelvin) - 273.15 : 0.0;
+    }
+}
+
+uint64_t SmartParser::ReadLe(const uint8_t* p, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = bytes; i-- > 0;) value = (value << 8) | p[i];
+    return value;
+}
+
+uint64_t SmartParser::ReadLe128Saturated(const uint8_t* p) {
+    return ReadLe(p + 8, 8) ? UINT64_MAX : ReadLe(p, 8);
+}
+
+bool SmartParser::ParseAtaSmartData(const uint8_t* page, size_t length, AtaSmartData& out) {
+    out = AtaSmartData{};
+    if (!page || length < kPageSize) return false;
+
+    uint8_t sum = 0;
+    for (size_t i = 0; i < kPageSize; ++i) sum = static_cast<uint8_t>(sum + page[i]);
+    out.checksumValid = (sum == 0);
+
+    for (int slot = 0; slot < kMaxAtaAttributes; ++slot) {
+        const uint8_t* e = page + kAtaTableOffset + slot * kAtaEntrySize;
+        if (e[0] == 0) continue;   // 空槽
+        AtaAttribute& a = out.attributes[out.count++];
+        a.id = e[0];
+        a.flags = static_cast<uint16_t>(e[1] | (e[2] << 8));
+        a.current = e[3];
+        a.worst = e[4];
+        memcpy(a.raw, e + 5, 6);
+        a.rawValue = ReadLe(e + 5, 6);
+    }
+    out.offlineCollectionStatus = page[kAtaOfflineStatusOffset];
+    out.selfTestStatus = page[kAtaSelfTestStatusOffset];
+    return out.count > 0;
+}
+
+bool SmartParser::ParseAtaThresholds(const uint8_t* page, size_t length, AtaSmartData& inout) {
+    if (!page || length < kPageSize) return false;
+    bool any = false;
+    for (int slot = 0; slot < kMaxAtaAttributes; ++slot) {
+        const uint8_t* e = page + kAtaTableOffset + slot * kAtaEntrySize;
+        if (e[0] == 0) continue;
+        for (int i = 0; i < inout.count; ++i) {
+            if (inout.attributes[i].id == e[0]) {
+                inout.attributes[i].threshold = e[1];
+                any = true;
+                break;
+            }
+        }
+    }
+    return any;
+}
+
+// 布局见 NVMe Base Specification “SMART / Health Information (Log Identifier 02h)”
+bool SmartParser::ParseNvmeHealthLog(const uint8_t* page, size_t length, NvmeHealth& out) {
+    out = NvmeHealth{};
+    if (!page || length < kPageSize) return false;
+
+    out.criticalWarning = page[0];
+    out.temperature = KelvinToCelsius(ReadLe(page + 1, 2));
+    out.availableSpare = page[3];
+    out.availableSpareThreshold = page[4];
+    out.percentageUsed = page[5];
+    out.dataUnitsRead = ReadLe128Saturated(page + 32);
+    out.dataUnitsWritten = ReadLe128Saturated(page + 48);
+    out.hostReadCommands = ReadLe128Saturated(page + 64);
+    out.hostWriteCommands = ReadLe128Saturated(page + 80);
+    out.controllerBusyMinutes = ReadLe128Saturated(page + 96);
+    out.powerCycles = ReadLe128Saturated(page + 112);
+    out.powerOnHours = ReadLe128Saturated(page + 128);
+    out.unsafeShutdowns = ReadLe128Saturated(page + 144);
+    out.mediaErrors = ReadLe128Saturated(page + 160);
+    out.errorLogEntries = ReadLe128Saturated(page + 176);
+    out.warningTempMinutes = static_cast<uint32_t>(ReadLe(page + 192, 4));
+    out.criticalTempMinutes = static_cast<uint32_t>(ReadLe(page + 196, 4));
+    for (int i = 0; i < 8; ++i) {
+        out.sensorTemperatures[i] = KelvinToCelsius(ReadLe(page + 200 + i * 2, 2));
+    }
+    // 全零页通常表示设备未返回数据
+    return out.temperature != 0.0 || out.powerOnHours != 0 || out.powerCycles != 0;
+}
+
+const SmartParser::AtaAttribute* SmartParser::FindAttribute(const AtaSmartData& data, uint8_t id) {
+    for (int i = 0; i < data.count; ++i) {
+        if (data.attributes[i].id == id) return &data.attributes[i];
+    }
+    return nullptr;
+}
+
+// 摘要字段的来源：194/190 温度；9 通电时间；12 通电周期；5/197/198(187) 缺陷计数；
+// 241/242（Crucial 为 246）读写量；剩余寿命依次取 231/233/177/202
+SmartParser::HealthSummary SmartParser::SummarizeAta(const AtaSmartData& data, SmartDriveFamily family) {
+    HealthSummary s;
+    if (data.count == 0) return s;
+    s.valid = true;
+
+    // 返回是否找到该属性；解码值写入 out
+    auto decode = [&data, family](uint8_t id, double& out) {
+        const AtaAttribute* a = FindAttribute(data, id);
+        if (!a) return false;
+        out = SmartAttributeCatalog::Decode(SmartAttributeCatalog::Lookup(family, id), *a).value;
+        return true;
+    };
+    auto decodeCount = [&decode](uint8_t id, uint64_t& out) {
+        double value = 0.0;
+        if (!decode(id, value)) return false;
+        out = static_cast<uint64_t>(value);
+        return true;
+    };
+
+    if (!decode(194, s.temperature)) decode(190, s.temperature);
+    decodeCount(9, s.powerOnHours);
+    decodeCount(12, s.powerCycles);
+    decodeCount(5, s.reallocatedSectors);
+    decodeCount(197, s.pendingSectors);
+    if (!decodeCount(198, s.uncorrectableErrors)) decodeCount(187, s.uncorrectableErrors);
+    if (!decodeCount(241, s.bytesWritten)) decodeCount(246, s.bytesWritten);
+    decodeCount(242, s.bytesRead);
+    for (uint8_t id : { static_cast<uint8_t>(231), static_cast<uint8_t>(233), static_cast<uint8_t>(177), static_cast<uint8_t>(202) }) {
+        const AtaAttribute* a = FindAttribute(data, id);
+        const SmartAttributeInfo* info = SmartAttributeCatalog::Lookup(family, id);
+        // 同一ID在部分厂商族中不是寿命指标（如 SandForce 233），以目录定义为准
+        if (a && info && info->format == SmartRawFormat::NormalizedPercent) {
+            s.lifeRemainingPercent = (std::min)(static_cast<double>(a->current), 100.0);
+            break;
+        }
+    }
+
+    for (int i = 0; i < data.count; ++i) {
+        const auto& a = data.attributes[i];
+        if ((a.flags & 0x01) && a.threshold > 0 && a.current <= a.threshold) s.failing = true;
+    }
+
+    // 经验规则：以剩余寿命为基准，有坏扇区/待处理扇区时按数量扣减（最低20），预失效属性越过阈值时最高10
+    double health = s.lifeRemainingPercent >= 0.0 ? s.lifeRemainingPercent : 100.0;
+    uint64_t defects = s.reallocatedSectors + s.pendingSectors + s.uncorrectableErrors;
+    if (defects > 0) health = (std::min)(health, (std::max)(20.0, 100.0 - static_cast<double>(defects)));
+    if (s.failing) health = (std::min)(health, 10.0);
+    s.healthPercent = static_cast<uint8_t>((std::max)(health, 0.0));
+    return s;
+}
+
+SmartParser::HealthSummary SmartParser::SummarizeNvme(const NvmeHealth& health) {
+    HealthSummary s;
+    s.valid = true;
+    s.temperature = health.temperature;
+    s.powerOnHours = health.powerOnHours;
+    s.powerCycles = health.powerCycles;
+    s.uncorrectableErrors = health.mediaErrors;
+    s.lifeRemainingPercent = 100.0 - (std::min)(static_cast<double>(health.percentageUsed), 100.0);
+    // Data Units 以 1000 个 512 字节为单位
+    s.bytesRead = health.dataUnitsRead > UINT64_MAX / 512000 ? UINT64_MAX : health.dataUnitsRead * 512000;
+    s.bytesWritten = health.dataUnitsWritten > UINT64_MAX / 512000 ? UINT64_MAX : health.dataUnitsWritten * 512000;
+
+    // bit0 备用空间低于阈值，bit2 可靠性下降，bit3 进入只读
+    s.failing = (health.criticalWarning & 0x0D) != 0 ||
+        (health.availableSpareThreshold > 0 && health.availableSpare < health.availableSpareThreshold);
+    double percent = s.lifeRemainingPercent;
+    if (s.failing) percent = (std::min)(percent, 10.0);
+    s.healthPercent = static_cast<uint8_t>(percent);
+    return s;
+}
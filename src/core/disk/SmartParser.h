@@ -0,0 +1,87 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+
+enum class SmartDriveFamily : uint8_t;
+
+// SMART / NVMe 健康日志的二进制解码
+// 只处理内存中的数据页，不做任何设备 I/O，可直接对抓取的原始数据页离线验证
+// ATA: SMART READ DATA (0xD0) 与 READ THRESHOLDS (0xD1) 各512字节
+// NVMe: Get Log Page 0x02（SMART / Health Information）512字节
+class SmartParser {
+public:
+    static constexpr size_t kPageSize = 512;
+    static constexpr int kMaxAtaAttributes = 30;
+
+    struct AtaAttribute {
+        uint8_t id = 0;
+        uint16_t flags = 0;          // bit0: 预失效属性（prefail），bit1: 在线采集
+        uint8_t current = 0;         // 归一化当前值
+        uint8_t worst = 0;           // 归一化最差值
+        uint8_t threshold = 0;       // 归一化阈值（来自 READ THRESHOLDS）
+        uint8_t raw[6] = {};         // 原始值（小端），厂商相关
+        uint64_t rawValue = 0;       // raw 的48位整数形式
+    };
+
+    struct AtaSmartData {
+        AtaAttribute attributes[kMaxAtaAttributes];
+        int count = 0;
+        bool checksumValid = false;
+        uint8_t offlineCollectionStatus = 0;
+        uint8_t selfTestStatus = 0;   // 高4位为最近一次自检结果
+    };
+
+    struct NvmeHealth {
+        uint8_t criticalWarning = 0;       // 位标志：备用空间不足/温度/可靠性/只读/易失备份失败
+        double temperature = 0.0;          // 复合温度（摄氏度）
+        uint8_t availableSpare = 0;        // 剩余备用空间（%）
+        uint8_t availableSpareThreshold = 0;
+        uint8_t percentageUsed = 0;        // 厂商估计的寿命消耗（%，可超过100）
+        uint64_t dataUnitsRead = 0;        // 单位为 1000 × 512 字节
+        uint64_t dataUnitsWritten = 0;
+        uint64_t hostReadCommands = 0;
+        uint64_t hostWriteCommands = 0;
+        uint64_t controllerBusyMinutes = 0;
+        uint64_t powerCycles = 0;
+        uint64_t powerOnHours = 0;
+        uint64_t unsafeShutdowns = 0;
+        uint64_t mediaErrors = 0;
+        uint64_t errorLogEntries = 0;
+        uint32_t warningTempMinutes = 0;
+        uint32_t criticalTempMinutes = 0;
+        double sensorTemperatures[8] = {}; // 温度传感器1-8（摄氏度），未实现的传感器为0
+    };
+
+    // 供上层直接发布的健康摘要
+    struct HealthSummary {
+        bool valid = false;
+        bool failing = false;              // 有预失效属性低于阈值 / NVMe 严重警告
+        uint8_t healthPercent = 0;         // 0-100
+        double temperature = 0.0;          // 摄氏度
+        uint64_t powerOnHours = 0;
+        uint64_t powerCycles = 0;
+        uint64_t reallocatedSectors = 0;
+        uint64_t pendingSectors = 0;
+        uint64_t uncorrectableErrors = 0;
+        double lifeRemainingPercent = -1.0; // 剩余寿命（%），未知为 -1
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    // 解析 SMART READ DATA 页；校验和（全部512字节之和为0）失败时仍解析，但 checksumValid 为 false
+    static bool ParseAtaSmartData(const uint8_t* page, size_t length, AtaSmartData& out);
+    // 解析 SMART READ THRESHOLDS 页，按属性ID合并到已解析的数据中
+    static bool ParseAtaThresholds(const uint8_t* page, size_t length, AtaSmartData& inout);
+    static bool ParseNvmeHealthLog(const uint8_t* page, size_t length, NvmeHealth& out);
+
+    static const AtaAttribute* FindAttribute(const AtaSmartData& data, uint8_t id);
+
+    // 温度、通电时间、读写量、剩余寿命按型号族的属性目录解码（见 SmartAttributeCatalog）
+    static HealthSummary SummarizeAta(const AtaSmartData& data, SmartDriveFamily family);
+    static HealthSummary SummarizeNvme(const NvmeHealth& health);
+
+private:
+    static uint64_t ReadLe(const uint8_t* p, size_t bytes);
+    // NVMe 128位计数器：高64位非0时饱和为 UINT64_MAX
+    static uint64_t ReadLe128Saturated(const uint8_t* p);
+};
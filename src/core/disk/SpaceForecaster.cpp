@@ -0,0 +1,68 @@
+﻿#include "SpaceForecaster.h"
+#include <algorithm>
+#include <cmath>
+
+void SpaceForecaster::Observe(const std::string& key, uint64_t usedBytes, uint64_t freeBytes, uint64_t nowNs) {
+    auto [it, inserted] = states.try_emplace(key);
+    State& s = it->second;
+    double value = static_cast<double>(usedBytes);
+    if (inserted) {
+        s.level = value;
+        s.freeBytes = freeBytes;
+        s.firstNs = s.lastNs = nowNs;
+        return;
+    }
+    if (nowNs <= s.lastNs) return;
+    double dt = (nowNs - s.lastNs) / 1e9;
+    if (dt < 0.5) return;
+    s.lastNs = nowNs;
+    s.freeBytes = freeBytes;
+
+    double predicted = s.level + s.trend * dt;
+    double residual = value - predicted;
+    double bound = (std::max)(kClip * s.residualScale, kMinResidualBytes);
+    if (std::fabs(residual) > bound) {
+        int direction = residual > 0 ? 1 : -1;
+        s.outlierRun = (s.outlierRun * direction > 0) ? s.outlierRun + direction : direction;
+        if (std::abs(s.outlierRun) >= kShiftSamples) {
+            if (s.shiftPending && nowNs > s.shiftNs) s.trend = (value - s.shiftValue) / ((nowNs - s.shiftNs) / 1e9);
+            s.shiftPending = true;
+            s.shiftValue = value;
+            s.shiftNs = nowNs;
+            s.level = value;
+            s.outlierRun = 0;
+            return;
+        }
+        residual = direction * bound;
+    } else {
+        s.outlierRun = 0;
+        s.shiftPending = false;
+    }
+
+    double alpha = 1.0 - std::exp(-dt / kLevelTauSeconds);
+    double beta = 1.0 - std::exp(-dt / kTrendTauSeconds);
+    double level = predicted + alpha * residual;
+    s.trend += beta * ((level - s.level) / dt - s.trend);
+    s.level = level;
+    s.residualScale += alpha * (std::fabs(residual) - s.residualScale);
+}
+
+SpaceForecaster::Forecast SpaceForecaster::Get(const std::string& key) const {
+    Forecast f;
+    auto it = states.find(key);
+    if (it == states.end()) return f;
+    const State& s = it->second;
+    if ((s.lastNs - s.firstNs) / 1e9 < kWarmupSeconds) return f;
+    f.valid = true;
+    f.fillRateBytesPerSec = s.trend;
+    if (s.freeBytes == 0) f.secondsToFull = 0.0;
+    else if (s.trend > kMinFillRate) f.secondsToFull = static_cast<double>(s.freeBytes) / s.trend;
+    return f;
+}
+
+void SpaceForecaster::Sweep(uint64_t nowNs, double maxIdleSeconds) {
+    for (auto it = states.begin(); it != states.end();) {
+        if (nowNs > it->second.lastNs && (nowNs - it->second.lastNs) / 1e9 > maxIdleSeconds) it = states.erase(it);
+        else ++it;
+    }
+}
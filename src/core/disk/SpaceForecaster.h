@@ -0,0 +1,51 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// 卷空间用量预测（填满剩余时间与增长速率）
+// 每个卷只保存 Holt 双指数平滑的水平/趋势及残差尺度，每个样本 O(1) 更新，不保存历史序列
+// 采样间隔不固定，平滑系数按时间常数换算：alpha = 1 - exp(-dt / tau)
+// 鲁棒性：残差按其 EWMA 绝对值的 kClip 倍截断，单次清理/突发写入不会拉偏趋势；
+//         同方向连续 kShiftSamples 次越界视为用量阶跃（如删除大量文件），把水平重置到观测值并保留趋势；
+//         阶跃后仍持续越界说明写入速率本身变了（如开始大量拷贝），趋势改为两次阶跃间的斜率
+class SpaceForecaster {
+public:
+    struct Forecast {
+        bool valid = false;             // 观测时长足够（kWarmupSeconds）后才给出预测
+        double fillRateBytesPerSec = 0.0;   // 用量增长速率，负值表示在减少
+        double secondsToFull = -1.0;    // 按当前趋势到可用空间耗尽的秒数；不在增长时为 -1
+    };
+
+    static constexpr double kLevelTauSeconds = 120.0;
+    static constexpr double kTrendTauSeconds = 1800.0;
+    static constexpr double kWarmupSeconds = 600.0;
+    static constexpr double kClip = 4.0;
+    static constexpr int kShiftSamples = 3;
+    // 残差截断下限，避免用量长期不变时尺度趋近0、任何写入都被当作越界
+    static constexpr double kMinResidualBytes = 16.0 * 1024 * 1024;
+    // 增长速率低于该值（约 86MB/天）视为不在增长
+    static constexpr double kMinFillRate = 1024.0;
+
+    // 记录一次样本；同一 key 间隔不足 0.5 秒的样本被忽略
+    void Observe(const std::string& key, uint64_t usedBytes, uint64_t freeBytes, uint64_t nowNs);
+    Forecast Get(const std::string& key) const;
+    // 移除超过 maxIdleSeconds 没有样本的卷
+    void Sweep(uint64_t nowNs, double maxIdleSeconds = 3600.0);
+
+private:
+    struct State {
+        double level = 0.0;
+        double trend = 0.0;             // 字节/秒
+        double residualScale = 0.0;     // |残差| 的 EWMA
+        uint64_t freeBytes = 0;
+        uint64_t firstNs = 0;
+        uint64_t lastNs = 0;
+        int outlierRun = 0;             // 连续越界次数，带符号表示方向
+        bool shiftPending = false;      // 上次阶跃后尚未出现正常样本
+        double shiftValue = 0.0;        // 上次阶跃时的观测值与时间，连续阶跃时据此估计新速率
+        uint64_t shiftNs = 0;
+    };
+
+    std::unordered_map<std::string, State> states;
+};
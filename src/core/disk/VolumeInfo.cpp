@@ -0,0 +1,231 @@
+﻿#include "VolumeInfo.h"
+#include "../Utils/CounterMath.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include "../Utils/Logger.h"
+#include "../Utils/WinUtils.h"
+#else
+#include "../Utils/TextScan.h"
+#include <algorithm>
+#include <poll.h>
+#include <string_view>
+#include <sys/statvfs.h>
+#include <unordered_map>
+#endif
+
+VolumeInfo::VolumeInfo(bool includeRemoteFileSystems) : includeRemote(includeRemoteFileSystems) {
+#ifndef _WIN32
+    // 容器主机上 mountinfo 可达数百KB，ProcFile 会按需扩容
+    if (!mountInfoFile.Open("/proc/self/mountinfo", 65536)) return;
+#endif
+    Update();
+}
+
+bool VolumeInfo::Update() {
+    if (MountTableChanged()) dirty = true;
+    if (dirty) {
+        std::vector<Volume> fresh;
+        if (Enumerate(fresh)) {
+            volumes = std::move(fresh);
+            nextStatNs.assign(volumes.size(), 0);
+            dirty = false;
+            available = true;
+            lastEnumerateNs = CounterMath::MonotonicNowNs();
+            ++generation;
+        }
+    }
+    for (size_t i = 0; i < volumes.size(); ++i) {
+        uint64_t start = CounterMath::MonotonicNowNs();
+        if (start < nextStatNs[i]) continue;
+        StatVolume(i);
+        uint64_t end = CounterMath::MonotonicNowNs();
+        volumes[i].sampledNs = end;
+        bool slow = end - start > kSlowStatMs * 1000000ULL;
+        nextStatNs[i] = end + (slow ? kSlowStatIntervalSeconds : kStatIntervalSeconds) * 1000000000ULL;
+    }
+    return available;
+}
+
+#ifdef _WIN32
+
+bool VolumeInfo::MountTableChanged() {
+    return CounterMath::MonotonicNowNs() - lastEnumerateNs >= kWindowsRescanSeconds * 1000000000ULL;
+}
+
+bool VolumeInfo::Enumerate(std::vector<Volume>& out) {
+    wchar_t volumeName[MAX_PATH] = {};
+    HANDLE find = FindFirstVolumeW(volumeName, MAX_PATH);
+    if (find == INVALID_HANDLE_VALUE) {
+        Logger::Warn("FindFirstVolumeW 失败，无法枚举卷");
+        return false;
+    }
+    std::vector<std::wstring> paths;
+    std::vector<wchar_t> pathNames(MAX_PATH + 1);
+    do {
+        UINT driveType = GetDriveTypeW(volumeName);
+        if (driveType != DRIVE_FIXED && driveType != DRIVE_REMOVABLE) continue;
+        DWORD needed = 0;
+        if (!GetVolumePathNamesForVolumeNameW(volumeName, pathNames.data(), static_cast<DWORD>(pathNames.size()), &needed)) {
+            if (GetLastError() != ERROR_MORE_DATA) continue;
+            pathNames.resize(needed);
+            if (!GetVolumePathNamesForVolumeNameW(volumeName, pathNames.data(), static_cast<DWORD>(pathNames.size()), &needed)) continue;
+        }
+        wchar_t label[MAX_PATH + 1] = {};
+        wchar_t fileSystem[MAX_PATH + 1] = {};
+        DWORD serial = 0;
+        DWORD flags = 0;
+        // 无介质的读卡器、未格式化的分区在这里失败
+        if (!GetVolumeInformationW(volumeName, label, MAX_PATH + 1, &serial, nullptr, &flags, fileSystem, MAX_PATH + 1)) continue;
+
+        // 首选盘符根目录，其次第一个挂载文件夹，都没有时使用卷 GUID 路径
+        std::wstring mountPoint;
+        for (const wchar_t* p = pathNames.data(); *p; p += wcslen(p) + 1) {
+            if (wcslen(p) == 3) { mountPoint = p; break; }
+            if (mountPoint.empty()) mountPoint = p;
+        }
+        if (mountPoint.empty()) mountPoint = volumeName;
+
+        Volume volume;
+        volume.mountPoint = WinUtils::WstringToUtf8(mountPoint);
+        volume.device = WinUtils::WstringToUtf8(volumeName);
+        volume.fileSystem = WinUtils::WstringToUtf8(fileSystem);
+        volume.label = WinUtils::WstringToUtf8(label);
+        volume.deviceId = serial;
+        volume.readOnly = (flags & FILE_READ_ONLY_VOLUME) != 0;
+        out.push_back(std::move(volume));
+        paths.push_back(std::move(mountPoint));
+    } while (FindNextVolumeW(find, volumeName, MAX_PATH));
+    FindVolumeClose(find);
+    statPaths = std::move(paths);
+    Logger::Debug("卷枚举完成: " + std::to_string(out.size()) + " 个");
+    return true;
+}
+
+void VolumeInfo::StatVolume(size_t index) {
+    Volume& v = volumes[index];
+    ULARGE_INTEGER available{}, total{}, totalFree{};
+    v.valid = GetDiskFreeSpaceExW(statPaths[index].c_str(), &available, &total, &totalFree) != FALSE;
+    if (!v.valid) return;
+    v.totalBytes = total.QuadPart;
+    v.freeBytes = available.QuadPart;
+    v.usedBytes = total.QuadPart >= totalFree.QuadPart ? total.QuadPart - totalFree.QuadPart : 0;
+}
+
+#else
+
+namespace {
+    // 不占用块设备空间或用量由底层文件系统统计的类型
+    constexpr std::string_view kPseudoFileSystems[] = {
+        "autofs", "binfmt_misc", "bpf", "cgroup", "cgroup2", "configfs", "debugfs", "devpts", "devtmpfs",
+        "efivarfs", "fuse.gvfsd-fuse", "fuse.lxcfs", "fuse.portal", "fusectl", "hugetlbfs", "mqueue", "nsfs",
+        "overlay", "proc", "pstore", "ramfs", "rpc_pipefs", "securityfs", "selinuxfs", "squashfs", "sysfs",
+        "tmpfs", "tracefs",
+    };
+    constexpr std::string_view kRemoteFileSystems[] = {
+        "9p", "afs", "ceph", "cifs", "fuse.sshfs", "glusterfs", "nfs", "nfs4", "smb3", "smbfs",
+    };
+
+    template <size_t N>
+    bool Contains(const std::string_view (&list)[N], std::string_view value) {
+        return std::find(std::begin(list), std::end(list), value) != std::end(list);
+    }
+
+    // mountinfo 中空格、制表符、换行和反斜杠以 \ooo 八进制转义
+    std::string Unescape(std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\\' && i + 3 < text.size() && TextScan::IsDigit(text[i + 1])) {
+                out.push_back(static_cast<char>(((text[i + 1] - '0') << 6) | ((text[i + 2] - '0') << 3) | (text[i + 3] - '0')));
+                i += 3;
+            } else {
+                out.push_back(text[i]);
+            }
+        }
+        return out;
+    }
+}
+
+bool VolumeInfo::MountTableChanged() {
+    if (!mountInfoFile.IsOpen()) return false;
+    // 挂载表变化后 /proc/self/mountinfo 上报 POLLPRI|POLLERR，直到下次 poll
+    pollfd pfd{ mountInfoFile.Descriptor(), POLLPRI, 0 };
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLPRI | POLLERR)) != 0;
+}
+
+// 每行: id 父id major:minor 根 挂载点 挂载选项 [可选字段...] - 类型 来源 超级块选项
+bool VolumeInfo::Enumerate(std::vector<Volume>& out) {
+    if (!mountInfoFile.Read()) return false;
+    const char* p = mountInfoFile.Data();
+    const char* end = mountInfoFile.End();
+    // major:minor -> out 下标；bind 挂载共享同一超级块，只统计一次
+    std::unordered_map<uint64_t, size_t> byDevice;
+    std::vector<bool> rootIsSlash;
+
+    while (p < end) {
+        const char* lineEnd = TextScan::NextLine(p, end);
+        const char* fieldEnd = (lineEnd > p && lineEnd[-1] == '\n') ? lineEnd - 1 : lineEnd;
+        auto next = [&p, fieldEnd]() {
+            p = TextScan::SkipSpaces(p, fieldEnd);
+            const char* start = p;
+            p = TextScan::SkipToken(p, fieldEnd);
+            return std::string_view(start, static_cast<size_t>(p - start));
+        };
+
+        next();     // 挂载 id
+        next();     // 父 id
+        uint64_t major = 0, minor = 0;
+        p = TextScan::SkipSpaces(p, fieldEnd);
+        bool ok = TextScan::ParseU64(p, fieldEnd, major) && p < fieldEnd && *p++ == ':' && TextScan::ParseU64(p, fieldEnd, minor);
+        std::string_view root = next();
+        std::string_view mountPoint = next();
+        std::string_view options = next();
+        std::string_view field;
+        while (!(field = next()).empty() && field != "-") {}
+        std::string_view fileSystem = next();
+        std::string_view source = next();
+        p = lineEnd;
+
+        if (!ok || field != "-" || fileSystem.empty()) continue;
+        if (Contains(kPseudoFileSystems, fileSystem)) continue;
+        if (!includeRemote && Contains(kRemoteFileSystems, fileSystem)) continue;
+
+        uint64_t key = (major << 32) | minor;
+        bool isRootOfFs = root == "/";
+        auto it = byDevice.find(key);
+        if (it != byDevice.end()) {
+            // 优先保留挂载文件系统根目录的那一项，子目录 bind 挂载不替换
+            if (!isRootOfFs || rootIsSlash[it->second]) continue;
+            out[it->second].mountPoint = Unescape(mountPoint);
+            rootIsSlash[it->second] = true;
+            continue;
+        }
+        Volume volume;
+        volume.mountPoint = Unescape(mountPoint);
+        volume.device = Unescape(source);
+        volume.fileSystem.assign(fileSystem);
+        volume.deviceId = key;
+        volume.readOnly = options == "ro" || options.substr(0, 3) == "ro,";
+        byDevice.emplace(key, out.size());
+        rootIsSlash.push_back(isRootOfFs);
+        out.push_back(std::move(volume));
+    }
+    return true;
+}
+
+void VolumeInfo::StatVolume(size_t index) {
+    Volume& v = volumes[index];
+    struct statvfs st;
+    v.valid = statvfs(v.mountPoint.c_str(), &st) == 0;
+    if (!v.valid) return;
+    uint64_t unit = st.f_frsize ? st.f_frsize : st.f_bsize;
+    v.totalBytes = static_cast<uint64_t>(st.f_blocks) * unit;
+    v.freeBytes = static_cast<uint64_t>(st.f_bavail) * unit;
+    v.usedBytes = static_cast<uint64_t>(st.f_blocks - std::min(st.f_bfree, st.f_blocks)) * unit;
+    v.totalInodes = st.f_files;
+    v.freeInodes = st.f_favail;
+    v.usedInodes = st.f_files - std::min(st.f_ffree, st.f_files);
+}
+
+#endif
@@ -0,0 +1,75 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include "../Utils/ProcFile.h"
+#endif
+
+// 已挂载文件系统（卷）的容量与 inode 使用情况，覆盖无盘符卷、挂载文件夹以及 Linux 全部真实挂载点
+// 挂载表只在变更时重新解析；容量查询按卷限频：每 kStatIntervalSeconds 秒一次，
+// 单次查询超过 kSlowStatMs 的卷（休眠唤醒中的机械盘、慢速 U 盘）退避到 kSlowStatIntervalSeconds 秒一次，
+// 两次查询之间 Update() 返回上次的结果
+// Windows: FindFirstVolumeW/GetVolumePathNamesForVolumeNameW 枚举，GetDiskFreeSpaceExW 取容量；
+//          挂载变更没有可靠通知，由使用方在磁盘拓扑变化时 Invalidate()，另每60秒兜底重新枚举；NTFS 没有 inode 计数
+// Linux: /proc/self/mountinfo 常驻打开，poll(POLLPRI) 检测挂载表变化；过滤伪文件系统和 overlay，
+//        同一 major:minor 的 bind 挂载只保留一项；网络文件系统默认跳过（服务端不可达时 statvfs 会阻塞）
+class VolumeInfo {
+public:
+    struct Volume {
+        std::string mountPoint;         // C:\ / D:\Mount\Data\ / \\?\Volume{...}\ / /home（UTF-8）
+        std::string device;             // \\?\Volume{...}\ / /dev/sda1
+        std::string fileSystem;
+        std::string label;              // 仅 Windows
+        uint64_t deviceId = 0;          // Linux: (major << 32) | minor；Windows: 卷序列号
+        uint64_t totalBytes = 0;
+        uint64_t usedBytes = 0;
+        uint64_t freeBytes = 0;         // 当前用户可用（扣除 root 保留块/配额）
+        uint64_t totalInodes = 0;
+        uint64_t usedInodes = 0;
+        uint64_t freeInodes = 0;
+        bool readOnly = false;
+        bool valid = false;             // 最近一次容量查询是否成功
+        uint64_t sampledNs = 0;         // 最近一次容量查询的单调时钟时间，供使用方识别新样本
+    };
+
+    static constexpr uint64_t kWindowsRescanSeconds = 60;
+    static constexpr uint64_t kStatIntervalSeconds = 5;
+    static constexpr uint64_t kSlowStatMs = 100;
+    static constexpr uint64_t kSlowStatIntervalSeconds = 60;
+
+    explicit VolumeInfo(bool includeRemote = false);
+
+    VolumeInfo(const VolumeInfo&) = delete;
+    VolumeInfo& operator=(const VolumeInfo&) = delete;
+
+    // 挂载表有变化时重新枚举，然后刷新到期卷的容量
+    bool Update();
+    // 强制下次 Update() 重新枚举
+    void Invalidate() { dirty = true; }
+
+    const std::vector<Volume>& GetVolumes() const { return volumes; }
+    // 每次重新枚举后递增，使用方据此重新对齐按卷保存的状态
+    uint64_t GetGeneration() const { return generation; }
+    bool IsAvailable() const { return available; }
+
+private:
+    bool Enumerate(std::vector<Volume>& out);
+    bool MountTableChanged();
+    void StatVolume(size_t index);
+
+    std::vector<Volume> volumes;
+    std::vector<uint64_t> nextStatNs;   // 与 volumes 一一对应，下次容量查询的时间
+    uint64_t generation = 0;
+    uint64_t lastEnumerateNs = 0;
+    bool includeRemote;
+    bool dirty = true;
+    bool available = false;
+
+#ifdef _WIN32
+    std::vector<std::wstring> statPaths;    // 与 volumes 一一对应，GetDiskFreeSpaceExW 的宽字符路径
+#else
+    ProcFile mountInfoFile;
+#endif
+};
@@ -1,13 +1,55 @@
 ﻿#include "GpuInfo.h"
 #include "Logger.h"
 #include "WmiManager.h"
+#include "NvmlApi.h"
 #include <comutil.h>
-#include <C:\Program Files\NVIDIA GPU Computing Toolkit\CUDA\v12.8\include\nvml.h>
+#include <cfgmgr32.h>
 #include <algorithm>  // Add this header for std::transform
 #include <cctype>     // Add this header for character functions
 #include <cwctype>    // Add this header for wide character functions like towlower
+#include <cstdlib>
+#include <cstring>
 
-GpuInfo::GpuInfo(WmiManager& manager) : wmiManager(manager) {
+#pragma comment(lib, "cfgmgr32.lib")
+
+namespace {
+    struct PciLocation {
+        unsigned long bus = 0;
+        unsigned long device = 0;
+        unsigned long function = 0;
+    };
+
+    // 由 PNP 设备实例 ID 取 PCI 位置：CM_DRP_ADDRESS 对 PCI 设备为 (设备号 << 16) | 功能号
+    bool QueryPciLocation(const std::wstring& instanceId, PciLocation& location) {
+        DEVINST devInst = 0;
+        if (CM_Locate_DevNodeW(&devInst, const_cast<DEVINSTID_W>(instanceId.c_str()), CM_LOCATE_DEVNODE_NORMAL) != CR_SUCCESS) {
+            return false;
+        }
+        ULONG bus = 0, address = 0;
+        ULONG size = sizeof(bus);
+        if (CM_Get_DevNode_Registry_PropertyW(devInst, CM_DRP_BUSNUMBER, nullptr, &bus, &size, 0) != CR_SUCCESS) return false;
+        size = sizeof(address);
+        if (CM_Get_DevNode_Registry_PropertyW(devInst, CM_DRP_ADDRESS, nullptr, &address, &size, 0) != CR_SUCCESS) return false;
+        location.bus = bus;
+        location.device = address >> 16;
+        location.function = address & 0xFFFF;
+        return true;
+    }
+
+    // NVML 的 PCI 信息不含功能号，从 busId（"域:总线:设备.功能"）末尾解析
+    bool QueryPciLocation(const NvmlApi& nvml, NvmlApi::Device device, PciLocation& location) {
+        NvmlApi::PciInfo pci{};
+        if (!nvml.Fn().DeviceGetPciInfo || nvml.Fn().DeviceGetPciInfo(device, &pci) != NvmlApi::kSuccess) return false;
+        pci.busId[NvmlApi::kPciBusIdBufferSize - 1] = '\0';
+        const char* dot = strrchr(pci.busId, '.');
+        location.bus = pci.bus;
+        location.device = pci.device;
+        location.function = dot ? strtoul(dot + 1, nullptr, 16) : 0;
+        return true;
+    }
+}
+
+GpuInfo::GpuInfo(WmiManager& manager, const NvmlApi* nvml) : wmiManager(manager), sharedNvml(nvml) {
     if (!wmiManager.IsInitialized()) {
         Logger::Error("WMI服务未初始化");
         return;
@@ -135,10 +177,43 @@ void GpuInfo::DetectGpusViaWmi() {
 
     pEnumerator->Release();
 
-    // 为NVIDIA GPU查询详细信息
+    // 为NVIDIA GPU查询详细信息；WMI 与 NVML 的枚举顺序没有保证，按 PCI 位置对应，
+    // 对不上的设备 nvmlIndex 保持 -1，只使用 WMI 数据
+    NvmlApi localNvml;
+    if (!sharedNvml && !localNvml.Load()) {
+        Logger::Warn("未找到 NVML，NVIDIA GPU 显存与频率使用 WMI 数据");
+        return;
+    }
+    const NvmlApi& nvml = sharedNvml ? *sharedNvml : localNvml;
+    if (!nvml.Fn().DeviceGetPciInfo) {
+        Logger::Warn("NVML 不支持 nvmlDeviceGetPciInfo，无法对应 NVIDIA GPU，显存与频率使用 WMI 数据");
+        return;
+    }
+
+    unsigned int nvmlCount = 0;
+    if (nvml.Fn().DeviceGetCount(&nvmlCount) != NvmlApi::kSuccess) return;
+    std::vector<PciLocation> nvmlLocations(nvmlCount);
+    std::vector<bool> nvmlLocated(nvmlCount, false);
+    for (unsigned int n = 0; n < nvmlCount; ++n) {
+        NvmlApi::Device device = nullptr;
+        if (nvml.Fn().DeviceGetHandleByIndex(n, &device) == NvmlApi::kSuccess) {
+            nvmlLocated[n] = QueryPciLocation(nvml, device, nvmlLocations[n]);
+        }
+    }
+
     for (size_t i = 0; i < gpuList.size(); ++i) {
-        if (gpuList[i].isNvidia && !gpuList[i].isVirtual) {
-            QueryNvidiaGpuInfo(static_cast<int>(i));
+        if (!gpuList[i].isNvidia || gpuList[i].isVirtual) continue;
+        PciLocation location;
+        if (!QueryPciLocation(gpuList[i].deviceId, location)) {
+            Logger::Warn("无法获取 GPU 的 PCI 位置，NVML 数据不可用");
+            continue;
+        }
+        for (unsigned int n = 0; n < nvmlCount; ++n) {
+            if (nvmlLocated[n] && nvmlLocations[n].bus == location.bus &&
+                nvmlLocations[n].device == location.device && nvmlLocations[n].function == location.function) {
+                QueryNvidiaGpuInfo(nvml, static_cast<int>(i), n);
+                break;
+            }
         }
     }
 }
@@ -161,51 +236,41 @@ void GpuInfo::QueryIntelGpuInfo(int index) {
     pFactory->Release();
 }
 
-void GpuInfo::QueryNvidiaGpuInfo(int index) {
-    nvmlReturn_t initResult = nvmlInit();
-    if (NVML_SUCCESS != initResult) {
-        Logger::Error("NVML初始化失败: " + std::string(nvmlErrorString(initResult)));
-        return;
-    }
-
-    nvmlDevice_t device;
-    nvmlReturn_t result = nvmlDeviceGetHandleByIndex(0, &device);
-    if (NVML_SUCCESS != result) {
-        Logger::Error("获取设备句柄失败: " + std::string(nvmlErrorString(result)));
-        nvmlShutdown();
+void GpuInfo::QueryNvidiaGpuInfo(const NvmlApi& nvml, int index, unsigned int nvmlIndex) {
+    const NvmlApi::Functions& fn = nvml.Fn();
+    NvmlApi::Device device = nullptr;
+    NvmlApi::Return result = fn.DeviceGetHandleByIndex(nvmlIndex, &device);
+    if (NvmlApi::kSuccess != result) {
+        Logger::Error("获取设备句柄失败: " + nvml.ErrorString(result));
         return;
     }
+    gpuList[index].nvmlIndex = static_cast<int>(nvmlIndex);
 
     // 获取显存信息
-    nvmlMemory_t memory;
-    result = nvmlDeviceGetMemoryInfo(device, &memory);
-    if (NVML_SUCCESS == result) {
+    NvmlApi::Memory memory{};
+    result = fn.DeviceGetMemoryInfo(device, &memory);
+    if (NvmlApi::kSuccess == result) {
         gpuList[index].dedicatedMemory = memory.total;
     }
 
     // 获取核心频率，保持 MHz 单位
     unsigned int clockMHz = 0;
-    result = nvmlDeviceGetClockInfo(device, NVML_CLOCK_GRAPHICS, &clockMHz);
-    if (NVML_SUCCESS == result) {
+    if (fn.DeviceGetClockInfo && NvmlApi::kSuccess == fn.DeviceGetClockInfo(device, NvmlApi::ClockGraphics, &clockMHz)) {
         gpuList[index].coreClock = static_cast<double>(clockMHz);
     }
 
     // 获取温度
     unsigned int temp = 0;
-    nvmlReturn_t tempResult = nvmlDeviceGetTemperature(device, NVML_TEMPERATURE_GPU, &temp);
-    if (NVML_SUCCESS == tempResult) {
+    if (fn.DeviceGetTemperature && NvmlApi::kSuccess == fn.DeviceGetTemperature(device, NvmlApi::TemperatureGpu, &temp)) {
         gpuList[index].temperature = temp;
     }
 
     // 获取计算能力
-    int major, minor;
-    result = nvmlDeviceGetCudaComputeCapability(device, &major, &minor);
-    if (NVML_SUCCESS == result) {
+    int major = 0, minor = 0;
+    if (fn.DeviceGetCudaComputeCapability && NvmlApi::kSuccess == fn.DeviceGetCudaComputeCapability(device, &major, &minor)) {
         gpuList[index].computeCapabilityMajor = major;
         gpuList[index].computeCapabilityMinor = minor;
     }
-
-    nvmlShutdown();
 }
 
 const std::vector<GpuInfo::GpuData>& GpuInfo::GetGpuData() const {
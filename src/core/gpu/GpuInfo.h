@@ -3,16 +3,13 @@
 #include <string>
 #include <d3d11.h>
 
-#if defined(SUPPORT_NVIDIA_GPU)
-#include <nvml.h>
-#endif
-
 #if defined(SUPPORT_DIRECTX)
 #include <dxgi.h>
 #endif
 #include <wbemidl.h>
 
 class WmiManager;
+class NvmlApi;
 
 class GpuInfo {
 public:
@@ -27,9 +24,11 @@ public:
         int computeCapabilityMajor = 0;
         int computeCapabilityMinor = 0;
         unsigned int temperature = 0;
+        int nvmlIndex = -1;      // NVML 设备序号，非 NVIDIA GPU 为 -1
     };
 
-    GpuInfo(WmiManager& manager);
+    // nvml 为已加载的 NVML 时直接复用，否则内部临时加载一次
+    GpuInfo(WmiManager& manager, const NvmlApi* nvml = nullptr);
     ~GpuInfo();
 
     const std::vector<GpuData>& GetGpuData() const;
@@ -37,10 +36,11 @@ public:
 private:
     void DetectGpusViaWmi();
     void QueryIntelGpuInfo(int index);
-    void QueryNvidiaGpuInfo(int index);
+    void QueryNvidiaGpuInfo(const NvmlApi& nvml, int index, unsigned int nvmlIndex);
     bool IsVirtualGpu(const std::wstring& name);  // 新增：虚拟显卡检测方法
 
     WmiManager& wmiManager;
+    const NvmlApi* sharedNvml = nullptr;
     IWbemServices* pSvc = nullptr;
     std::vector<GpuData> gpuList;
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+﻿#include "GpuService.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/Logger.h"
+#include "../Utils/WinUtils.h"
+
+GpuService::GpuService(WmiManager& wmiManager) {
+    Logger::Info("正在初始化GPU信息");
+    {
+        GpuInfo gpuInfo(wmiManager, telemetry.Api().IsLoaded() ? &telemetry.Api() : nullptr);
+        gpus = gpuInfo.GetGpuData();
+    }
+
+    const std::vector<GpuTelemetry::Device>& devices = telemetry.GetDevices();
+    telemetryIndex.assign(gpus.size(), -1);
+    dynamic.assign(gpus.size(), Dynamic());
+    for (size_t i = 0; i < gpus.size(); ++i) {
+        const GpuInfo::GpuData& gpu = gpus[i];
+        if (gpu.nvmlIndex >= 0) {
+            for (size_t d = 0; d < devices.size(); ++d) {
+                if (devices[d].index == static_cast<unsigned int>(gpu.nvmlIndex)) {
+                    telemetryIndex[i] = static_cast<int>(d);
+                    break;
+                }
+            }
+        }
+        if (primaryIndex < 0 && !gpu.isVirtual) primaryIndex = static_cast<int>(i);
+
+        std::string gpuName = WinUtils::WstringToString(gpu.name);
+        Logger::Info("检测到GPU: " + gpuName +
+                   " (虚拟: " + (gpu.isVirtual ? "是" : "否") +
+                   ", NVIDIA: " + (gpu.isNvidia ? "是" : "否") +
+                   ", 集成: " + (gpu.isIntegrated ? "是" : "否") + ")");
+    }
+    if (primaryIndex < 0 && !gpus.empty()) primaryIndex = 0;
+
+    if (primaryIndex >= 0) {
+        Logger::Info("选择主GPU: " + WinUtils::WstringToString(gpus[primaryIndex].name) +
+                   " (虚拟: " + (gpus[primaryIndex].isVirtual ? "是" : "否") + ")");
+    } else {
+        Logger::Warn("未检测到任何GPU");
+    }
+    Refresh();
+}
+
+bool GpuService::Refresh() {
+    if (!telemetry.IsAvailable()) return false;
+    uint64_t now = CounterMath::MonotonicNowNs();
+    if (lastRefreshNs != 0 && now - lastRefreshNs < kDynamicRefreshMs * 1000000ULL) return false;
+    lastRefreshNs = now;
+
+    telemetry.Update();
+    const std::vector<GpuTelemetry::Device>& devices = telemetry.GetDevices();
+    for (size_t i = 0; i < gpus.size(); ++i) {
+        if (telemetryIndex[i] < 0) continue;
+        const GpuTelemetry::Device& device = devices[telemetryIndex[i]];
+        Dynamic& entry = dynamic[i];
+        entry.valid = device.valid;
+        if (!device.valid) continue;
+        entry.temperature = static_cast<float>(device.temperature);
+        entry.coreClockMHz = static_cast<float>(device.graphicsClockMHz);
+        entry.utilization = static_cast<float>(device.gpuUtilization);
+        entry.powerWatts = static_cast<float>(device.powerWatts);
+        entry.memoryUsed = device.memoryUsed;
+    }
+    return true;
+}
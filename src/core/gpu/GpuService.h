@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GpuInfo.h"
+#include "GpuTelemetry.h"
+
+class WmiManager;
+
+// GPU 服务：进程内唯一的 GPU 枚举与动态刷新入口，温度采集、GPU 信息与共享内存发布共用
+// 静态信息（名称、显存容量、是否虚拟）在构造时通过 WMI 枚举一次；NVML 只加载一次，由内部的 GpuTelemetry 持有并复用给 GpuInfo
+// 动态数据（温度、频率、利用率、功耗、已用显存）按 GPU 顺序保存在紧凑数组中，Refresh() 每 kDynamicRefreshMs 毫秒最多刷新一次，
+// 与调用方的循环周期无关；非 NVIDIA 或虚拟 GPU 的动态数据 valid 为 false
+// 只在采集线程中使用，不加锁
+class GpuService {
+public:
+    struct Dynamic {
+        float temperature = 0.0f;       // 摄氏度
+        float coreClockMHz = 0.0f;
+        float utilization = 0.0f;       // %
+        float powerWatts = 0.0f;
+        uint64_t memoryUsed = 0;
+        bool valid = false;
+    };
+
+    static constexpr uint64_t kDynamicRefreshMs = 1000;
+
+    explicit GpuService(WmiManager& wmiManager);
+
+    GpuService(const GpuService&) = delete;
+    GpuService& operator=(const GpuService&) = delete;
+
+    // 到期时刷新动态数据并返回 true，未到期直接返回 false
+    bool Refresh();
+
+    const std::vector<GpuInfo::GpuData>& GetGpus() const { return gpus; }
+    // 与 GetGpus() 下标一一对应
+    const std::vector<Dynamic>& GetDynamic() const { return dynamic; }
+    // 优先第一个非虚拟 GPU，全部为虚拟时取第一个；没有 GPU 时返回 -1
+    int GetPrimaryIndex() const { return primaryIndex; }
+    const GpuTelemetry& GetTelemetry() const { return telemetry; }
+
+private:
+    GpuTelemetry telemetry;             // 先于 GpuInfo 构造，NVML 只加载一次
+    std::vector<GpuInfo::GpuData> gpus;
+    std::vector<int> telemetryIndex;    // gpus[i] 对应的 telemetry 设备下标，-1 表示无
+    std::vector<Dynamic> dynamic;
+    int primaryIndex = -1;
+    uint64_t lastRefreshNs = 0;
+};
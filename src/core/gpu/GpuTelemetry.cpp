@@ -0,0 +1,237 @@
+﻿#include "GpuTelemetry.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/ProcessName.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#endif
+
+namespace {
+    constexpr size_t kInitialProcessCapacity = 32;
+
+    // 进程列表在两次调用之间可能增长，容量不足时按驱动返回的数量扩容并重试
+    // 成功时结果写在 buffer[used..]，used 增加返回的个数
+    bool AppendRunningProcesses(NvmlApi::Return (*query)(NvmlApi::Device, unsigned int*, NvmlApi::ProcessInfo*),
+        NvmlApi::Device handle, std::vector<NvmlApi::ProcessInfo>& buffer, size_t& used) {
+        if (!query) return false;
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            if (buffer.size() - used < kInitialProcessCapacity) buffer.resize(used + kInitialProcessCapacity);
+            unsigned int count = static_cast<unsigned int>(buffer.size() - used);
+            NvmlApi::Return result = query(handle, &count, buffer.data() + used);
+            if (result == NvmlApi::kSuccess) {
+                used += count;
+                return true;
+            }
+            if (result != NvmlApi::kErrorInsufficientSize) return false;
+            buffer.resize(used + count + kInitialProcessCapacity);
+        }
+        return false;
+    }
+
+    uint64_t UsedMemory(unsigned long long value) {
+        return value == NvmlApi::kValueNotAvailable ? 0 : value;
+    }
+
+    // [first, last) 按 pid 升序
+    template <typename Iterator>
+    Iterator FindPid(Iterator first, Iterator last, unsigned int pid) {
+        Iterator it = std::lower_bound(first, last, pid, [](const auto& item, unsigned int value) { return item.pid < value; });
+        return (it != last && it->pid == pid) ? it : last;
+    }
+}
+
+GpuTelemetry::GpuTelemetry(const std::string& libraryPath) {
+    if (!nvml.Load(libraryPath)) return;
+    const NvmlApi::Functions& fn = nvml.Fn();
+
+    unsigned int count = 0;
+    if (fn.DeviceGetCount(&count) != NvmlApi::kSuccess) return;
+    for (unsigned int i = 0; i < count; ++i) {
+        NvmlApi::Device handle = nullptr;
+        if (fn.DeviceGetHandleByIndex(i, &handle) != NvmlApi::kSuccess) continue;   // 无权限访问的设备跳过
+        Device device;
+        device.index = i;
+        char text[NvmlApi::kDeviceUuidBufferSize > NvmlApi::kDeviceNameBufferSize
+            ? NvmlApi::kDeviceUuidBufferSize : NvmlApi::kDeviceNameBufferSize] = {};
+        if (fn.DeviceGetName(handle, text, NvmlApi::kDeviceNameBufferSize) == NvmlApi::kSuccess) device.name = text;
+        if (fn.DeviceGetUUID && fn.DeviceGetUUID(handle, text, NvmlApi::kDeviceUuidBufferSize) == NvmlApi::kSuccess) device.uuid = text;
+        handles.push_back(handle);
+        devices.push_back(std::move(device));
+    }
+    lastPcieNs.assign(handles.size(), 0);
+    processStates.resize(handles.size());
+    for (ProcessState& state : processStates) {
+        state.infos.resize(kInitialProcessCapacity);
+        state.samples.resize(kInitialProcessCapacity);
+    }
+#ifdef _WIN32
+    Logger::Info("NVML 已加载，发现 " + std::to_string(devices.size()) + " 个 NVIDIA GPU");
+#endif
+}
+
+bool GpuTelemetry::Update() {
+    if (handles.empty()) return false;
+    uint64_t now = CounterMath::MonotonicNowNs();
+    // 轮转选出本周期采样 PCIe 的 GPU
+    size_t pcieDevice = pcieCursor % handles.size();
+    bool samplePcie = lastPcieNs[pcieDevice] == 0 || now - lastPcieNs[pcieDevice] >= kPcieIntervalSeconds * 1000000000ULL;
+    if (samplePcie) {
+        lastPcieNs[pcieDevice] = now;
+        ++pcieCursor;
+    }
+    for (size_t i = 0; i < handles.size(); ++i) {
+        QueryDevice(handles[i], devices[i], samplePcie && i == pcieDevice);
+        if (devices[i].valid) {
+            QueryProcesses(handles[i], devices[i], processStates[i]);
+        } else {
+            devices[i].processes.clear();
+        }
+    }
+    RankProcesses();
+    return true;
+}
+
+// 每项查询独立判断返回值，设备不支持某项（如无风扇、消费级卡不支持功耗上限）时保留默认值
+void GpuTelemetry::QueryDevice(NvmlApi::Device handle, Device& device, bool samplePcie) {
+    const NvmlApi::Functions& fn = nvml.Fn();
+
+    NvmlApi::Memory memory{};
+    NvmlApi::Return result = fn.DeviceGetMemoryInfo(handle, &memory);
+    device.valid = result == NvmlApi::kSuccess;
+    if (!device.valid) return;     // GPU 掉线（kErrorGpuIsLost）时其余查询同样失败
+    device.memoryTotal = memory.total;
+    device.memoryUsed = memory.used;
+
+    NvmlApi::Utilization utilization{};
+    if (fn.DeviceGetUtilizationRates && fn.DeviceGetUtilizationRates(handle, &utilization) == NvmlApi::kSuccess) {
+        device.gpuUtilization = utilization.gpu;
+        device.memoryUtilization = utilization.memory;
+    }
+
+    unsigned int value = 0;
+    if (fn.DeviceGetClockInfo) {
+        if (fn.DeviceGetClockInfo(handle, NvmlApi::ClockGraphics, &value) == NvmlApi::kSuccess) device.graphicsClockMHz = value;
+        if (fn.DeviceGetClockInfo(handle, NvmlApi::ClockSm, &value) == NvmlApi::kSuccess) device.smClockMHz = value;
+        if (fn.DeviceGetClockInfo(handle, NvmlApi::ClockMemory, &value) == NvmlApi::kSuccess) device.memoryClockMHz = value;
+    }
+    if (fn.DeviceGetTemperature && fn.DeviceGetTemperature(handle, NvmlApi::TemperatureGpu, &value) == NvmlApi::kSuccess) {
+        device.temperature = value;
+    }
+    if (fn.DeviceGetPowerUsage && fn.DeviceGetPowerUsage(handle, &value) == NvmlApi::kSuccess) {
+        device.powerWatts = value / 1000.0;
+    }
+    if (fn.DeviceGetEnforcedPowerLimit && fn.DeviceGetEnforcedPowerLimit(handle, &value) == NvmlApi::kSuccess) {
+        device.powerLimitWatts = value / 1000.0;
+    }
+    device.fanPercent = (fn.DeviceGetFanSpeed && fn.DeviceGetFanSpeed(handle, &value) == NvmlApi::kSuccess)
+        ? static_cast<int32_t>(value) : -1;
+
+    unsigned long long reasons = 0;
+    if (fn.DeviceGetCurrentClocksThrottleReasons && fn.DeviceGetCurrentClocksThrottleReasons(handle, &reasons) == NvmlApi::kSuccess) {
+        device.throttleReasons = reasons;
+    }
+
+    if (samplePcie && fn.DeviceGetPcieThroughput) {
+        if (fn.DeviceGetPcieThroughput(handle, NvmlApi::PcieTxBytes, &value) == NvmlApi::kSuccess) device.pcieTxBytesPerSec = value * 1024.0;
+        if (fn.DeviceGetPcieThroughput(handle, NvmlApi::PcieRxBytes, &value) == NvmlApi::kSuccess) device.pcieRxBytesPerSec = value * 1024.0;
+    }
+}
+
+void GpuTelemetry::QueryProcesses(NvmlApi::Device handle, Device& device, ProcessState& state) {
+    const NvmlApi::Functions& fn = nvml.Fn();
+    std::vector<Process>& processes = device.processes;
+
+    // 计算与图形列表合并；两个接口都不可用时不统计
+    size_t used = 0;
+    bool computeOk = AppendRunningProcesses(fn.DeviceGetComputeRunningProcesses, handle, state.infos, used);
+    bool graphicsOk = AppendRunningProcesses(fn.DeviceGetGraphicsRunningProcesses, handle, state.infos, used);
+    if (!computeOk && !graphicsOk) {
+        processes.clear();
+        return;
+    }
+
+    // 同一进程可能同时出现在两个列表中，排序后合并相邻项
+    std::sort(state.infos.begin(), state.infos.begin() + static_cast<std::ptrdiff_t>(used), [](const NvmlApi::ProcessInfo& a, const NvmlApi::ProcessInfo& b) { return a.pid < b.pid; });
+    size_t unique = 0;
+    for (size_t i = 0; i < used; ++i) {
+        const NvmlApi::ProcessInfo& info = state.infos[i];
+        if (unique > 0 && state.infos[unique - 1].pid == info.pid) {
+            state.infos[unique - 1].usedGpuMemory = (std::max)(UsedMemory(state.infos[unique - 1].usedGpuMemory), UsedMemory(info.usedGpuMemory));
+        } else {
+            state.infos[unique++] = info;
+        }
+    }
+    auto uniqueBegin = state.infos.begin();
+    auto uniqueEnd = uniqueBegin + static_cast<std::ptrdiff_t>(unique);
+
+    // 原地移除已退出的进程，更新仍在运行的进程，新进程追加后重新排序
+    processes.erase(std::remove_if(processes.begin(), processes.end(), [&](const Process& process) {
+        return FindPid(uniqueBegin, uniqueEnd, process.pid) == uniqueEnd;
+    }), processes.end());
+    size_t existing = processes.size();
+    for (auto it = uniqueBegin; it != uniqueEnd; ++it) {
+        auto last = processes.begin() + static_cast<std::ptrdiff_t>(existing);
+        auto found = FindPid(processes.begin(), last, it->pid);
+        if (found != last) {
+            found->usedMemory = UsedMemory(it->usedGpuMemory);
+            continue;
+        }
+        Process process;
+        process.pid = it->pid;
+        process.usedMemory = UsedMemory(it->usedGpuMemory);
+        process.name = ProcessName::Query(it->pid);
+        processes.push_back(std::move(process));
+    }
+    if (processes.size() > existing) {
+        std::sort(processes.begin(), processes.end(), [](const Process& a, const Process& b) { return a.pid < b.pid; });
+    }
+
+    for (Process& process : processes) {
+        process.smUtilization = 0;
+        process.memoryUtilization = 0;
+        process.encoderUtilization = 0;
+        process.decoderUtilization = 0;
+    }
+    if (!fn.DeviceGetProcessUtilization || processes.empty()) return;
+
+    // 只取上次时间戳之后的样本；没有新样本时驱动返回 kErrorNotFound，利用率保持为0
+    unsigned int count = 0;
+    NvmlApi::Return result = NvmlApi::kErrorInsufficientSize;
+    for (int attempt = 0; attempt < 2 && result == NvmlApi::kErrorInsufficientSize; ++attempt) {
+        count = static_cast<unsigned int>(state.samples.size());
+        result = fn.DeviceGetProcessUtilization(handle, state.samples.data(), &count, state.lastSampleTimestamp);
+        if (result == NvmlApi::kErrorInsufficientSize) state.samples.resize(count + kInitialProcessCapacity);
+    }
+    if (result != NvmlApi::kSuccess) return;
+
+    for (unsigned int i = 0; i < count && i < state.samples.size(); ++i) {
+        const NvmlApi::ProcessUtilizationSample& sample = state.samples[i];
+        if (sample.timeStamp <= state.lastSampleTimestamp) continue;
+        auto found = FindPid(processes.begin(), processes.end(), sample.pid);
+        if (found == processes.end()) continue;
+        found->smUtilization = (std::max)(found->smUtilization, sample.smUtil);
+        found->memoryUtilization = (std::max)(found->memoryUtilization, sample.memUtil);
+        found->encoderUtilization = (std::max)(found->encoderUtilization, sample.encUtil);
+        found->decoderUtilization = (std::max)(found->decoderUtilization, sample.decUtil);
+    }
+    for (unsigned int i = 0; i < count && i < state.samples.size(); ++i) {
+        state.lastSampleTimestamp = (std::max)(state.lastSampleTimestamp, state.samples[i].timeStamp);
+    }
+}
+
+void GpuTelemetry::RankProcesses() {
+    topProcesses.clear();
+    for (size_t i = 0; i < devices.size(); ++i) {
+        for (const Process& process : devices[i].processes) {
+            topProcesses.push_back(RankedProcess{ static_cast<uint32_t>(i), &process });
+        }
+    }
+    size_t keep = (std::min)(topProcesses.size(), kTopProcesses);
+    std::partial_sort(topProcesses.begin(), topProcesses.begin() + static_cast<std::ptrdiff_t>(keep), topProcesses.end(),
+        [](const RankedProcess& a, const RankedProcess& b) {
+            if (a.process->usedMemory != b.process->usedMemory) return a.process->usedMemory > b.process->usedMemory;
+            return a.process->smUtilization > b.process->smUtilization;
+        });
+    topProcesses.resize(keep);
+}
@@ -0,0 +1,88 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NvmlApi.h"
+
+// 全部 NVIDIA GPU 的实时遥测（利用率、显存、功耗、频率、风扇、温度、降频原因、PCIe 吞吐）
+// 设备列表与名称在构造时枚举一次，每次 Update() 只对已有句柄调用 NVML 查询函数
+// nvmlDeviceGetPcieThroughput 在驱动内部阻塞采样约20ms（收发各一次），因此每个 GPU 的 PCIe 吞吐每 kPcieIntervalSeconds 秒
+// 才采样一次，且每次 Update() 最多采样一个 GPU，多卡机器上阻塞时间不随 GPU 数量叠加
+// 进程占用：合并计算与图形进程列表得到各进程显存，SM/显存/编解码利用率取 nvmlDeviceGetProcessUtilization
+// 自上次采样以来的样本；进程列表原地增删，查询缓冲区只增不减，进程名只在 PID 首次出现时查询
+class GpuTelemetry {
+public:
+    struct Process {
+        uint32_t pid = 0;
+        uint64_t usedMemory = 0;            // 字节；WDDM 模式下驱动不提供，为 0
+        uint32_t smUtilization = 0;         // 自上次 Update() 以来样本的最高值（%），下同
+        uint32_t memoryUtilization = 0;
+        uint32_t encoderUtilization = 0;
+        uint32_t decoderUtilization = 0;
+        std::string name;                   // UTF-8
+    };
+
+    // 指向 devices[deviceIndex].processes 中的元素，下次 Update() 前有效
+    struct RankedProcess {
+        uint32_t deviceIndex = 0;
+        const Process* process = nullptr;
+    };
+
+    struct Device {
+        std::string name;
+        std::string uuid;
+        unsigned int index = 0;             // NVML 设备序号（无权限的设备被跳过，与 devices 下标不一定相同）
+        uint64_t memoryTotal = 0;
+        uint64_t memoryUsed = 0;
+        uint32_t gpuUtilization = 0;        // %
+        uint32_t memoryUtilization = 0;     // 显存控制器忙碌百分比
+        double powerWatts = 0.0;
+        double powerLimitWatts = 0.0;
+        uint32_t graphicsClockMHz = 0;
+        uint32_t smClockMHz = 0;
+        uint32_t memoryClockMHz = 0;
+        uint32_t temperature = 0;           // 摄氏度
+        int32_t fanPercent = -1;            // 无风扇（被动散热/笔记本）为 -1
+        uint64_t throttleReasons = 0;       // nvmlClocksThrottleReason 位掩码
+        double pcieTxBytesPerSec = 0.0;
+        double pcieRxBytesPerSec = 0.0;
+        bool valid = false;                 // 本周期查询成功；GPU 掉线后为 false
+        std::vector<Process> processes;     // 按 PID 升序
+    };
+
+    static constexpr uint64_t kPcieIntervalSeconds = 5;
+    static constexpr size_t kTopProcesses = 16;
+
+    // libraryPath 为空时加载系统 NVML，否则加载指定的库（模拟实现）
+    explicit GpuTelemetry(const std::string& libraryPath = std::string());
+
+    GpuTelemetry(const GpuTelemetry&) = delete;
+    GpuTelemetry& operator=(const GpuTelemetry&) = delete;
+
+    bool Update();
+
+    const std::vector<Device>& GetDevices() const { return devices; }
+    // 全部 GPU 上的进程，按显存、SM 利用率降序，最多 kTopProcesses 个
+    const std::vector<RankedProcess>& GetTopProcesses() const { return topProcesses; }
+    bool IsAvailable() const { return !handles.empty(); }
+    const NvmlApi& Api() const { return nvml; }
+
+private:
+    struct ProcessState {
+        std::vector<NvmlApi::ProcessInfo> infos;
+        std::vector<NvmlApi::ProcessUtilizationSample> samples;
+        unsigned long long lastSampleTimestamp = 0;
+    };
+
+    void QueryDevice(NvmlApi::Device handle, Device& device, bool samplePcie);
+    void QueryProcesses(NvmlApi::Device handle, Device& device, ProcessState& state);
+    void RankProcesses();
+
+    NvmlApi nvml;
+    std::vector<NvmlApi::Device> handles;   // 与 devices 一一对应
+    std::vector<Device> devices;
+    std::vector<uint64_t> lastPcieNs;       // 每个 GPU 上次采样 PCIe 的时间
+    std::vector<ProcessState> processStates;    // 与 devices 一一对应
+    std::vector<RankedProcess> topProcesses;
+    size_t pcieCursor = 0;
+};
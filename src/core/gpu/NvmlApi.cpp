@@ -0,0 +1,125 @@
+﻿#include "NvmlApi.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include "../Utils/Logger.h"
+#include "../Utils/WinUtils.h"
+#else
+#include <dlfcn.h>
+#endif
+
+namespace {
+    template <typename Fn>
+    void Bind(Fn& target, void* symbol) {
+        target = reinterpret_cast<Fn>(symbol);
+    }
+}
+
+NvmlApi::~NvmlApi() {
+    Unload();
+}
+
+void* NvmlApi::Resolve(const char* name) const {
+#ifdef _WIN32
+    return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+    return dlsym(library, name);
+#endif
+}
+
+bool NvmlApi::Load(const std::string& libraryPath) {
+    if (initialized) return true;
+
+#ifdef _WIN32
+    if (!libraryPath.empty()) {
+        library = LoadLibraryW(WinUtils::Utf8ToWstring(libraryPath).c_str());
+    } else {
+        // 新驱动把 nvml.dll 放在 System32，旧驱动只在 NVSMI 目录
+        library = LoadLibraryExW(L"nvml.dll", nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32);
+        if (!library) {
+            wchar_t path[MAX_PATH];
+            DWORD length = ExpandEnvironmentStringsW(L"%ProgramW6432%\\NVIDIA Corporation\\NVSMI\\nvml.dll", path, MAX_PATH);
+            if (length > 0 && length <= MAX_PATH) library = LoadLibraryW(path);
+        }
+    }
+#else
+    library = dlopen(libraryPath.empty() ? "libnvidia-ml.so.1" : libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+    if (!library) return false;
+
+    // 优先使用带版本后缀的入口，旧驱动回退到无后缀版本
+    void* init = Resolve("nvmlInit_v2");
+    Bind(fn.Init, init ? init : Resolve("nvmlInit"));
+    Bind(fn.Shutdown, Resolve("nvmlShutdown"));
+    Bind(fn.ErrorString, Resolve("nvmlErrorString"));
+    void* count = Resolve("nvmlDeviceGetCount_v2");
+    Bind(fn.DeviceGetCount, count ? count : Resolve("nvmlDeviceGetCount"));
+    void* handle = Resolve("nvmlDeviceGetHandleByIndex_v2");
+    Bind(fn.DeviceGetHandleByIndex, handle ? handle : Resolve("nvmlDeviceGetHandleByIndex"));
+    Bind(fn.DeviceGetName, Resolve("nvmlDeviceGetName"));
+    Bind(fn.DeviceGetMemoryInfo, Resolve("nvmlDeviceGetMemoryInfo"));
+
+    Bind(fn.DeviceGetUUID, Resolve("nvmlDeviceGetUUID"));
+    // 无后缀的旧入口使用 v1 结构（busId 只有 16 字节），布局不同，不回退
+    void* pci = Resolve("nvmlDeviceGetPciInfo_v3");
+    Bind(fn.DeviceGetPciInfo, pci ? pci : Resolve("nvmlDeviceGetPciInfo_v2"));
+    Bind(fn.DeviceGetUtilizationRates, Resolve("nvmlDeviceGetUtilizationRates"));
+    Bind(fn.DeviceGetClockInfo, Resolve("nvmlDeviceGetClockInfo"));
+    Bind(fn.DeviceGetTemperature, Resolve("nvmlDeviceGetTemperature"));
+    Bind(fn.DeviceGetPowerUsage, Resolve("nvmlDeviceGetPowerUsage"));
+    Bind(fn.DeviceGetEnforcedPowerLimit, Resolve("nvmlDeviceGetEnforcedPowerLimit"));
+    Bind(fn.DeviceGetFanSpeed, Resolve("nvmlDeviceGetFanSpeed"));
+    // 12.x 驱动改名为 ClocksEventReasons，旧名仍导出
+    void* throttle = Resolve("nvmlDeviceGetCurrentClocksEventReasons");
+    Bind(fn.DeviceGetCurrentClocksThrottleReasons, throttle ? throttle : Resolve("nvmlDeviceGetCurrentClocksThrottleReasons"));
+    Bind(fn.DeviceGetPcieThroughput, Resolve("nvmlDeviceGetPcieThroughput"));
+    Bind(fn.DeviceGetCudaComputeCapability, Resolve("nvmlDeviceGetCudaComputeCapability"));
+    // 无后缀的旧入口使用 v1 结构（没有 GPU 实例字段），布局不同，不回退
+    void* compute = Resolve("nvmlDeviceGetComputeRunningProcesses_v3");
+    Bind(fn.DeviceGetComputeRunningProcesses, compute ? compute : Resolve("nvmlDeviceGetComputeRunningProcesses_v2"));
+    void* graphics = Resolve("nvmlDeviceGetGraphicsRunningProcesses_v3");
+    Bind(fn.DeviceGetGraphicsRunningProcesses, graphics ? graphics : Resolve("nvmlDeviceGetGraphicsRunningProcesses_v2"));
+    Bind(fn.DeviceGetProcessUtilization, Resolve("nvmlDeviceGetProcessUtilization"));
+
+    if (!fn.Init || !fn.Shutdown || !fn.ErrorString || !fn.DeviceGetCount || !fn.DeviceGetHandleByIndex ||
+        !fn.DeviceGetName || !fn.DeviceGetMemoryInfo) {
+#ifdef _WIN32
+        Logger::Warn("NVML 缺少必需的导出函数，已忽略");
+#endif
+        Unload();
+        return false;
+    }
+
+    Return result = fn.Init();
+    if (result != kSuccess) {
+#ifdef _WIN32
+        Logger::Warn("NVML初始化失败: " + ErrorString(result));
+#endif
+        Unload();
+        return false;
+    }
+    initialized = true;
+    return true;
+}
+
+void NvmlApi::Unload() {
+    if (initialized && fn.Shutdown) fn.Shutdown();
+    initialized = false;
+    if (library) {
+#ifdef _WIN32
+        FreeLibrary(static_cast<HMODULE>(library));
+#else
+        dlclose(library);
+#endif
+        library = nullptr;
+    }
+    fn = Functions();
+}
+
+std::string NvmlApi::ErrorString(Return result) const {
+    if (fn.ErrorString) {
+        const char* text = fn.ErrorString(result);
+        if (text) return text;
+    }
+    return "NVML错误 " + std::to_string(result);
+}
@@ -0,0 +1,116 @@
+﻿#pragma once
+#include <string>
+
+// 运行时加载的 NVML（NVIDIA Management Library）函数表
+// 不在编译期依赖 CUDA Toolkit 的 nvml.h / nvml.lib：没有 NVIDIA 驱动的机器上也能正常启动，
+// 传入自定义路径即可加载模拟实现的共享库，在无 GPU 的机器上驱动测试与基准
+// 下面的类型与常量按 nvml.h 的 ABI 定义，只声明用到的部分
+// Windows: nvml.dll（先 System32，再 %ProgramW6432%\NVIDIA Corporation\NVSMI）；Linux: libnvidia-ml.so.1
+class NvmlApi {
+public:
+    using Return = int;
+    using Device = struct nvmlDevice_st*;
+
+    static constexpr Return kSuccess = 0;
+    static constexpr Return kErrorNotSupported = 3;
+    static constexpr Return kErrorNotFound = 6;
+    static constexpr Return kErrorInsufficientSize = 7;
+    static constexpr Return kErrorFunctionNotFound = 13;
+    static constexpr Return kErrorGpuIsLost = 15;
+
+    static constexpr unsigned int kDeviceNameBufferSize = 96;
+    static constexpr unsigned int kDeviceUuidBufferSize = 80;
+    static constexpr unsigned int kPciBusIdBufferSize = 32;
+    static constexpr unsigned long long kValueNotAvailable = ~0ULL;    // WDDM 模式下进程显存用量不可用
+
+    enum ClockType { ClockGraphics = 0, ClockSm = 1, ClockMemory = 2 };
+    enum TemperatureSensor { TemperatureGpu = 0 };
+    enum PcieCounter { PcieTxBytes = 0, PcieRxBytes = 1 };
+
+    struct Memory {
+        unsigned long long total;
+        unsigned long long free;
+        unsigned long long used;
+    };
+
+    struct Utilization {
+        unsigned int gpu;
+        unsigned int memory;
+    };
+
+    // nvmlPciInfo_t（_v2/_v3 入口使用）；不含功能号，需要时从 busId 解析
+    struct PciInfo {
+        char busIdLegacy[16];
+        unsigned int domain;
+        unsigned int bus;
+        unsigned int device;
+        unsigned int pciDeviceId;
+        unsigned int pciSubSystemId;
+        char busId[kPciBusIdBufferSize];    // "域:总线:设备.功能"，十六进制
+    };
+
+    // nvmlProcessInfo_v2_t（_v2/_v3 入口使用）
+    struct ProcessInfo {
+        unsigned int pid;
+        unsigned long long usedGpuMemory;
+        unsigned int gpuInstanceId;
+        unsigned int computeInstanceId;
+    };
+
+    // nvmlProcessUtilizationSample_t，timeStamp 为 CPU 时间戳（微秒）
+    struct ProcessUtilizationSample {
+        unsigned int pid;
+        unsigned long long timeStamp;
+        unsigned int smUtil;
+        unsigned int memUtil;
+        unsigned int encUtil;
+        unsigned int decUtil;
+    };
+
+    // 必需函数缺失时 Load() 失败；可选函数缺失时为 nullptr，调用方需判断
+    struct Functions {
+        Return (*Init)() = nullptr;
+        Return (*Shutdown)() = nullptr;
+        const char* (*ErrorString)(Return) = nullptr;
+        Return (*DeviceGetCount)(unsigned int*) = nullptr;
+        Return (*DeviceGetHandleByIndex)(unsigned int, Device*) = nullptr;
+        Return (*DeviceGetName)(Device, char*, unsigned int) = nullptr;
+        Return (*DeviceGetMemoryInfo)(Device, Memory*) = nullptr;
+        // 可选
+        Return (*DeviceGetUUID)(Device, char*, unsigned int) = nullptr;
+        Return (*DeviceGetPciInfo)(Device, PciInfo*) = nullptr;
+        Return (*DeviceGetUtilizationRates)(Device, Utilization*) = nullptr;
+        Return (*DeviceGetClockInfo)(Device, int, unsigned int*) = nullptr;
+        Return (*DeviceGetTemperature)(Device, int, unsigned int*) = nullptr;
+        Return (*DeviceGetPowerUsage)(Device, unsigned int*) = nullptr;                // 毫瓦
+        Return (*DeviceGetEnforcedPowerLimit)(Device, unsigned int*) = nullptr;        // 毫瓦
+        Return (*DeviceGetFanSpeed)(Device, unsigned int*) = nullptr;                  // 百分比
+        Return (*DeviceGetCurrentClocksThrottleReasons)(Device, unsigned long long*) = nullptr;
+        Return (*DeviceGetPcieThroughput)(Device, int, unsigned int*) = nullptr;       // KB/s，驱动内部采样约20ms
+        Return (*DeviceGetCudaComputeCapability)(Device, int*, int*) = nullptr;
+        Return (*DeviceGetComputeRunningProcesses)(Device, unsigned int*, ProcessInfo*) = nullptr;
+        Return (*DeviceGetGraphicsRunningProcesses)(Device, unsigned int*, ProcessInfo*) = nullptr;
+        Return (*DeviceGetProcessUtilization)(Device, ProcessUtilizationSample*, unsigned int*, unsigned long long) = nullptr;
+    };
+
+    NvmlApi() = default;
+    ~NvmlApi();
+
+    NvmlApi(const NvmlApi&) = delete;
+    NvmlApi& operator=(const NvmlApi&) = delete;
+
+    // 加载库并调用 nvmlInit；libraryPath 为空时按平台默认位置查找
+    bool Load(const std::string& libraryPath = std::string());
+    void Unload();
+
+    bool IsLoaded() const { return initialized; }
+    const Functions& Fn() const { return fn; }
+    std::string ErrorString(Return result) const;
+
+private:
+    void* Resolve(const char* name) const;
+
+    void* library = nullptr;
+    bool initialized = false;
+    Functions fn;
+};
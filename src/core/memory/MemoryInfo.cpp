@@ -1,19 +1,216 @@
-#include "MemoryInfo.h"
-#include <windows.h>
+﻿#include "MemoryInfo.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <psapi.h>
+#include <pdhmsg.h>
+#pragma comment(lib, "pdh.lib")
+#pragma comment(lib, "psapi.lib")
+#endif
 
 MemoryInfo::MemoryInfo() {
+#ifdef _WIN32
+    InitializeCounters();
+#else
+    memInfoFile.Open("/proc/meminfo", 8192);
+    vmStatFile.Open("/proc/vmstat", 16384);
+#endif
+    Update();
+}
+
+MemoryInfo::~MemoryInfo() {
+#ifdef _WIN32
+    CleanupCounters();
+#endif
+}
+
+#ifdef _WIN32
+
+void MemoryInfo::InitializeCounters() {
+    if (PdhOpenQuery(NULL, 0, &query) != ERROR_SUCCESS) {
+        Logger::Warn("内存信息: 无法打开性能计数器查询，速率类数据将保持为0");
+        query = nullptr;
+        return;
+    }
+    // 使用英文计数器名称以避免本地化问题；单个计数器不存在（如旧系统无 Standby 分类）时对应字段保持为0
+    PdhAddEnglishCounterW(query, L"\\Memory\\Page Faults/sec", 0, &pageFaultsCounter);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Page Reads/sec", 0, &pageReadsCounter);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Pages Input/sec", 0, &pagesInputCounter);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Pages Output/sec", 0, &pagesOutputCounter);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Standby Cache Core Bytes", 0, &standbyCounters[0]);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Standby Cache Normal Priority Bytes", 0, &standbyCounters[1]);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Standby Cache Reserve Bytes", 0, &standbyCounters[2]);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Modified Page List Bytes", 0, &modifiedCounter);
+    PdhAddEnglishCounterW(query, L"\\Paging File(_Total)\\% Usage", 0, &pagingFileUsageCounter);
+    PdhCollectQueryData(query);
+}
+
+void MemoryInfo::CleanupCounters() {
+    if (query) {
+        PdhCloseQuery(query);
+        query = nullptr;
+    }
+}
+
+bool MemoryInfo::Update() {
+    MEMORYSTATUSEX memStatus{};
     memStatus.dwLength = sizeof(memStatus);
-    GlobalMemoryStatusEx(&memStatus);
+    if (!GlobalMemoryStatusEx(&memStatus)) {
+        Logger::Warn("GlobalMemoryStatusEx 失败");
+        return false;
+    }
+    details.totalPhysical = memStatus.ullTotalPhys;
+    details.availablePhysical = memStatus.ullAvailPhys;
+    details.totalVirtual = memStatus.ullTotalVirtual;
+
+    PERFORMANCE_INFORMATION perfInfo{};
+    perfInfo.cb = sizeof(perfInfo);
+    if (GetPerformanceInfo(&perfInfo, sizeof(perfInfo))) {
+        uint64_t pageSize = perfInfo.PageSize;
+        details.commitCharge = static_cast<uint64_t>(perfInfo.CommitTotal) * pageSize;
+        details.commitLimit = static_cast<uint64_t>(perfInfo.CommitLimit) * pageSize;
+        details.cached = static_cast<uint64_t>(perfInfo.SystemCache) * pageSize;
+        // 提交上限 = 物理内存 + 页面文件，差值即页面文件容量
+        details.swapTotal = details.commitLimit > details.totalPhysical ? details.commitLimit - details.totalPhysical : 0;
+    }
+
+    static const SIZE_T largePageMinimum = GetLargePageMinimum();
+    details.hugePageSize = largePageMinimum;
+
+    if (!query || PdhCollectQueryData(query) != ERROR_SUCCESS) return true;
+
+    auto readDouble = [](PDH_HCOUNTER counter, double& out) {
+        if (!counter) return false;
+        PDH_FMT_COUNTERVALUE value;
+        if (PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, NULL, &value) != ERROR_SUCCESS) return false;
+        if (value.CStatus != PDH_CSTATUS_VALID_DATA && value.CStatus != PDH_CSTATUS_NEW_DATA) return false;
+        out = (std::max)(value.doubleValue, 0.0);
+        return true;
+    };
+
+    double value = 0.0;
+    uint64_t standby = 0;
+    for (PDH_HCOUNTER counter : standbyCounters) {
+        if (readDouble(counter, value)) standby += static_cast<uint64_t>(value);
+    }
+    details.standby = standby;
+    if (readDouble(modifiedCounter, value)) details.dirty = static_cast<uint64_t>(value);
+    if (readDouble(pagingFileUsageCounter, value)) {
+        details.swapUsed = static_cast<uint64_t>(details.swapTotal * (std::min)(value, 100.0) / 100.0);
+    }
+
+    // 速率型计数器由 PDH 按两次采样差值计算，首次采样无效
+    if (hasBaseline) {
+        double faults = 0.0, hardFaults = 0.0;
+        readDouble(pageFaultsCounter, faults);
+        readDouble(pageReadsCounter, hardFaults);
+        details.majorFaultsPerSec = hardFaults;
+        details.minorFaultsPerSec = (std::max)(faults - hardFaults, 0.0);
+        if (readDouble(pagesInputCounter, value)) details.swapInPagesPerSec = value;
+        if (readDouble(pagesOutputCounter, value)) details.swapOutPagesPerSec = value;
+    }
+    hasBaseline = true;
+    return true;
+}
+
+#else
+
+namespace {
+    struct MemInfoField {
+        const char* key;
+        size_t keyLength;
+        uint64_t MemoryInfo::Details::* field;
+        bool kilobytes;   // 值以 kB 为单位（HugePages_* 为个数）
+    };
+
+#define MEMINFO_FIELD(key, member, kb) { key ":", sizeof(key), &MemoryInfo::Details::member, kb }
+    const MemInfoField kMemInfoFields[] = {
+        MEMINFO_FIELD("MemTotal", totalPhysical, true),
+        MEMINFO_FIELD("MemAvailable", availablePhysical, true),
+        MEMINFO_FIELD("Cached", cached, true),
+        MEMINFO_FIELD("Inactive(file)", standby, true),
+        MEMINFO_FIELD("Dirty", dirty, true),
+        MEMINFO_FIELD("Writeback", writeback, true),
+        MEMINFO_FIELD("SwapTotal", swapTotal, true),
+        MEMINFO_FIELD("SwapFree", swapUsed, true),          // 先存空闲量，解析后换算为已用
+        MEMINFO_FIELD("CommitLimit", commitLimit, true),
+        MEMINFO_FIELD("Committed_AS", commitCharge, true),
+        MEMINFO_FIELD("VmallocTotal", totalVirtual, true),
+        MEMINFO_FIELD("HugePages_Total", hugePagesTotal, false),
+        MEMINFO_FIELD("HugePages_Free", hugePagesFree, false),
+        MEMINFO_FIELD("Hugepagesize", hugePageSize, true),
+    };
+#undef MEMINFO_FIELD
+}
+
+bool MemoryInfo::ParseMemInfo() {
+    if (!memInfoFile.Read()) return false;
+    const char* p = memInfoFile.Data();
+    const char* end = memInfoFile.End();
+    while (p < end) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+        for (const auto& f : kMemInfoFields) {
+            if (!TextScan::StartsWith(line, p, f.key, f.keyLength)) continue;
+            const char* q = line + f.keyLength;
+            uint64_t value = 0;
+            if (TextScan::NextU64(q, p, value)) {
+                details.*(f.field) = f.kilobytes ? value * 1024 : value;
+            }
+            break;
+        }
+    }
+    uint64_t swapFree = details.swapUsed;
+    details.swapUsed = details.swapTotal > swapFree ? details.swapTotal - swapFree : 0;
+    return true;
 }
 
-ULONGLONG MemoryInfo::GetTotalPhysical() const {
-    return memStatus.ullTotalPhys;
+bool MemoryInfo::ParseVmStat(uint64_t& swapIn, uint64_t& swapOut, uint64_t& faults, uint64_t& majorFaults) {
+    if (!vmStatFile.Read()) return false;
+    const char* p = vmStatFile.Data();
+    const char* end = vmStatFile.End();
+    int found = 0;
+    while (p < end && found < 4) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+        const char* q = nullptr;
+        uint64_t* target = nullptr;
+        if (TextScan::StartsWith(line, p, "pswpin ", 7)) { q = line + 7; target = &swapIn; }
+        else if (TextScan::StartsWith(line, p, "pswpout ", 8)) { q = line + 8; target = &swapOut; }
+        else if (TextScan::StartsWith(line, p, "pgfault ", 8)) { q = line + 8; target = &faults; }
+        else if (TextScan::StartsWith(line, p, "pgmajfault ", 11)) { q = line + 11; target = &majorFaults; }
+        if (target && TextScan::NextU64(q, p, *target)) ++found;
+    }
+    return found > 0;
 }
 
-ULONGLONG MemoryInfo::GetAvailablePhysical() const {
-    return memStatus.ullAvailPhys;
+bool MemoryInfo::Update() {
+    uint64_t now = CounterMath::MonotonicNowNs();
+    if (!ParseMemInfo()) return false;
+
+    uint64_t swapIn = 0, swapOut = 0, faults = 0, majorFaults = 0;
+    if (!ParseVmStat(swapIn, swapOut, faults, majorFaults)) return true;
+
+    uint64_t elapsedNs = now - lastSampleNs;
+    if (hasBaseline && elapsedNs > 0) {
+        details.swapInPagesPerSec = CounterMath::PerSecond(CounterMath::Delta(prevSwapIn, swapIn), elapsedNs);
+        details.swapOutPagesPerSec = CounterMath::PerSecond(CounterMath::Delta(prevSwapOut, swapOut), elapsedNs);
+        // pgfault 包含主要缺页
+        uint64_t dFaults = CounterMath::Delta(prevFaults, faults);
+        uint64_t dMajor = CounterMath::Delta(prevMajorFaults, majorFaults);
+        details.majorFaultsPerSec = CounterMath::PerSecond(dMajor, elapsedNs);
+        details.minorFaultsPerSec = CounterMath::PerSecond(dFaults > dMajor ? dFaults - dMajor : 0, elapsedNs);
+    }
+    prevSwapIn = swapIn;
+    prevSwapOut = swapOut;
+    prevFaults = faults;
+    prevMajorFaults = majorFaults;
+    lastSampleNs = now;
+    hasBaseline = true;
+    return true;
 }
 
-ULONGLONG MemoryInfo::GetTotalVirtual() const {
-    return memStatus.ullTotalVirtual;
-}                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                           
\ No newline at end of file
+#endif
@@ -1,13 +1,80 @@
-#pragma once
+﻿#pragma once
+#include <cstdint>
+
+#ifdef _WIN32
 #include <windows.h>
+#include <pdh.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
 
+// 内存信息（常驻对象，每个周期调用 Update 刷新）
+// 除总量/可用量外，还提供提交量、缓存、脏页、交换区及缺页速率，速率基于单调时钟的计数器差值
+// Linux: /proc/meminfo、/proc/vmstat（各保持一个打开的 fd）
+// Windows: GlobalMemoryStatusEx + GetPerformanceInfo + PDH Memory 计数器
 class MemoryInfo {
 public:
+    struct Details {
+        uint64_t totalPhysical = 0;        // 物理内存总量（字节）
+        uint64_t availablePhysical = 0;    // 可用物理内存（字节）
+        uint64_t totalVirtual = 0;         // 虚拟地址空间（字节）
+        uint64_t commitCharge = 0;         // 已提交（字节）
+        uint64_t commitLimit = 0;          // 提交上限（字节）
+        uint64_t cached = 0;               // 文件缓存（字节）
+        uint64_t standby = 0;              // 备用/非活动文件页（字节）
+        uint64_t dirty = 0;                // 脏页/已修改页（字节）
+        uint64_t writeback = 0;            // 正在回写（字节），Windows 为0
+        uint64_t swapTotal = 0;            // 交换区/页面文件总量（字节）
+        uint64_t swapUsed = 0;             // 交换区/页面文件已用（字节）
+        double swapInPagesPerSec = 0.0;    // 换入（页/秒）
+        double swapOutPagesPerSec = 0.0;   // 换出（页/秒）
+        double minorFaultsPerSec = 0.0;    // 次要缺页（次/秒）
+        double majorFaultsPerSec = 0.0;    // 主要缺页（需要读盘，次/秒）
+        uint64_t hugePagesTotal = 0;       // 大页总数
+        uint64_t hugePagesFree = 0;        // 空闲大页数
+        uint64_t hugePageSize = 0;         // 大页大小（字节）
+    };
+
     MemoryInfo();
-    ULONGLONG GetTotalPhysical() const;
-    ULONGLONG GetAvailablePhysical() const;
-    ULONGLONG GetTotalVirtual() const;
+    ~MemoryInfo();
+
+    MemoryInfo(const MemoryInfo&) = delete;
+    MemoryInfo& operator=(const MemoryInfo&) = delete;
+
+    // 刷新一次；首次调用只建立速率基线
+    bool Update();
+    const Details& GetDetails() const { return details; }
+
+    uint64_t GetTotalPhysical() const { return details.totalPhysical; }
+    uint64_t GetAvailablePhysical() const { return details.availablePhysical; }
+    uint64_t GetTotalVirtual() const { return details.totalVirtual; }
 
 private:
-    MEMORYSTATUSEX memStatus;
-};                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                               
\ No newline at end of file
+    Details details;
+    bool hasBaseline = false;
+    uint64_t lastSampleNs = 0;
+
+#ifdef _WIN32
+    void InitializeCounters();
+    void CleanupCounters();
+
+    PDH_HQUERY query = nullptr;
+    PDH_HCOUNTER pageFaultsCounter = nullptr;     // \Memory\Page Faults/sec（全部缺页）
+    PDH_HCOUNTER pageReadsCounter = nullptr;      // \Memory\Page Reads/sec（硬缺页读盘次数）
+    PDH_HCOUNTER pagesInputCounter = nullptr;     // \Memory\Pages Input/sec
+    PDH_HCOUNTER pagesOutputCounter = nullptr;    // \Memory\Pages Output/sec
+    PDH_HCOUNTER standbyCounters[3] = {};         // Standby Cache Core/Normal/Reserve Bytes
+    PDH_HCOUNTER modifiedCounter = nullptr;       // \Memory\Modified Page List Bytes
+    PDH_HCOUNTER pagingFileUsageCounter = nullptr;// \Paging File(_Total)\% Usage
+#else
+    bool ParseMemInfo();
+    bool ParseVmStat(uint64_t& swapIn, uint64_t& swapOut, uint64_t& faults, uint64_t& majorFaults);
+
+    ProcFile memInfoFile;
+    ProcFile vmStatFile;
+    uint64_t prevSwapIn = 0;
+    uint64_t prevSwapOut = 0;
+    uint64_t prevFaults = 0;
+    uint64_t prevMajorFaults = 0;
+#endif
+};
@@ -0,0 +1,262 @@
+﻿#include "NumaInfo.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <pdhmsg.h>
+#include <cwctype>
+#pragma comment(lib, "pdh.lib")
+#endif
+
+NumaInfo::NumaInfo() {
+    DiscoverNodes();
+#ifdef _WIN32
+    InitializeCounters();
+#endif
+    Update();
+}
+
+NumaInfo::~NumaInfo() {
+#ifdef _WIN32
+    CleanupCounters();
+#endif
+}
+
+void NumaInfo::ApplyCoreUsage(const std::vector<SchedulerStats::CoreSample>& cores) {
+    for (auto& node : nodes) {
+        double sum = 0.0;
+        int count = 0;
+        for (int cpu : node.cpus) {
+            if (cpu < 0 || static_cast<size_t>(cpu) >= cores.size()) continue;
+            sum += cores[cpu].usage;
+            ++count;
+        }
+        node.cpuUsage = count > 0 ? sum / count : 0.0;
+    }
+}
+
+#ifdef _WIN32
+
+void NumaInfo::DiscoverNodes() {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) {
+        Logger::Warn("NUMA信息: GetNumaHighestNodeNumber 失败");
+        return;
+    }
+    // PDH Processor(*) 实例按处理器组连续编号：组 g 的起始编号为组 0..g-1 的活动处理器数之和
+    std::vector<int> groupBase;
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    int base = 0;
+    for (WORD g = 0; g < groupCount; ++g) {
+        groupBase.push_back(base);
+        base += static_cast<int>(GetActiveProcessorCount(g));
+    }
+    for (ULONG n = 0; n <= highestNode; ++n) {
+        Node node;
+        node.nodeId = n;
+        GROUP_AFFINITY affinity{};
+        if (GetNumaNodeProcessorMaskEx(static_cast<USHORT>(n), &affinity) && affinity.Group < groupBase.size()) {
+            // 与 PDH Processor(*) 实例编号一致：组起始编号 + 组内位号
+            for (int bit = 0; bit < 64; ++bit) {
+                if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+                    node.cpus.push_back(groupBase[affinity.Group] + bit);
+                }
+            }
+        }
+        ULONGLONG freeBytes = 0;
+        // 编号不连续时中间的节点不存在，跳过
+        if (node.cpus.empty() && !GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(n), &freeBytes)) continue;
+        nodes.push_back(std::move(node));
+    }
+    Logger::Debug("NUMA信息: 发现 " + std::to_string(nodes.size()) + " 个节点");
+}
+
+void NumaInfo::InitializeCounters() {
+    if (PdhOpenQuery(NULL, 0, &query) != ERROR_SUCCESS) {
+        query = nullptr;
+        return;
+    }
+    // 旧系统没有该计数器对象时节点总量保持为0，仅提供空闲量
+    if (PdhAddEnglishCounterW(query, L"\\NUMA Node Memory(*)\\Total MBytes", 0, &totalMBytesCounter) != ERROR_SUCCESS) {
+        Logger::Warn("NUMA信息: 无法添加 NUMA Node Memory 计数器，节点内存总量不可用");
+        CleanupCounters();
+    }
+}
+
+void NumaInfo::CleanupCounters() {
+    if (query) {
+        PdhCloseQuery(query);
+        query = nullptr;
+    }
+    totalMBytesCounter = nullptr;
+}
+
+bool NumaInfo::Update() {
+    if (nodes.empty()) return false;
+
+    for (auto& node : nodes) {
+        ULONGLONG freeBytes = 0;
+        if (GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(node.nodeId), &freeBytes)) {
+            node.freeMemory = freeBytes;
+        }
+    }
+
+    if (query && PdhCollectQueryData(query) == ERROR_SUCCESS) {
+        DWORD bufferSize = static_cast<DWORD>(counterArrayBuffer.size());
+        DWORD itemCount = 0;
+        PDH_STATUS status = PdhGetFormattedCounterArrayW(totalMBytesCounter, PDH_FMT_LARGE, &bufferSize, &itemCount,
+            counterArrayBuffer.empty() ? nullptr : reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data()));
+        if (status == PDH_MORE_DATA) {
+            counterArrayBuffer.resize(bufferSize);
+            status = PdhGetFormattedCounterArrayW(totalMBytesCounter, PDH_FMT_LARGE, &bufferSize, &itemCount,
+                reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data()));
+        }
+        if (status == ERROR_SUCCESS) {
+            auto* items = reinterpret_cast<PPDH_FMT_COUNTERVALUE_ITEM_W>(counterArrayBuffer.data());
+            for (DWORD i = 0; i < itemCount; ++i) {
+                const wchar_t* name = items[i].szName;
+                if (!name || !iswdigit(name[0])) continue; // 跳过 _Total
+                uint32_t id = static_cast<uint32_t>(_wtoi(name));
+                for (auto& node : nodes) {
+                    if (node.nodeId == id) {
+                        node.totalMemory = static_cast<uint64_t>(items[i].FmtValue.largeValue) * 1024 * 1024;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto& node : nodes) {
+        node.usedMemory = node.totalMemory > node.freeMemory ? node.totalMemory - node.freeMemory : 0;
+    }
+    hasBaseline = true;
+    return true;
+}
+
+#else
+
+namespace {
+    const char kNodeRoot[] = "/sys/devices/system/node/";
+
+    // 解析 sysfs 的编号列表，如 "0-3,8-11"
+    void ParseIdList(const char* p, const char* end, std::vector<int>& out) {
+        out.clear();
+        while (p < end) {
+            uint64_t first = 0;
+            if (!TextScan::ParseU64(p, end, first)) break;
+            uint64_t last = first;
+            if (p < end && *p == '-') {
+                ++p;
+                if (!TextScan::ParseU64(p, end, last)) break;
+            }
+            for (uint64_t id = first; id <= last && id < 4096; ++id) out.push_back(static_cast<int>(id));
+            if (p < end && *p == ',') ++p;
+            else break;
+        }
+    }
+}
+
+void NumaInfo::DiscoverNodes() {
+    ProcFile online(std::string(kNodeRoot) + "online", 256);
+    if (!online.Read()) return;   // 内核未启用 NUMA 时不存在该目录
+
+    std::vector<int> ids;
+    ParseIdList(online.Data(), online.End(), ids);
+    for (int id : ids) {
+        std::string dir = std::string(kNodeRoot) + "node" + std::to_string(id) + "/";
+        NodeFiles files;
+        if (!files.meminfo.Open(dir + "meminfo", 4096)) continue;
+        files.numastat.Open(dir + "numastat", 512);
+
+        Node node;
+        node.nodeId = static_cast<uint32_t>(id);
+        // 核心归属只在热插拔时变化，发现阶段读取一次
+        ProcFile cpuList(dir + "cpulist", 256);
+        if (cpuList.Read()) ParseIdList(cpuList.Data(), cpuList.End(), node.cpus);
+
+        nodes.push_back(std::move(node));
+        nodeFiles.push_back(std::move(files));
+    }
+}
+
+// 每行形如 "Node 0 MemTotal:       16330912 kB"
+bool NumaInfo::ReadMemInfo(ProcFile& file, Node& node) {
+    if (!file.Read()) return false;
+    const char* p = file.Data();
+    const char* end = file.End();
+    int found = 0;
+    while (p < end && found < 2) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+        const char* q = TextScan::SkipSpaces(TextScan::SkipToken(line, p), p);   // "Node"
+        q = TextScan::SkipSpaces(TextScan::SkipToken(q, p), p);                  // 节点号
+        uint64_t* target = nullptr;
+        if (TextScan::StartsWith(q, p, "MemTotal:", 9)) { q += 9; target = &node.totalMemory; }
+        else if (TextScan::StartsWith(q, p, "MemFree:", 8)) { q += 8; target = &node.freeMemory; }
+        uint64_t value = 0;
+        if (target && TextScan::NextU64(q, p, value)) {
+            *target = value * 1024;
+            ++found;
+        }
+    }
+    node.usedMemory = node.totalMemory > node.freeMemory ? node.totalMemory - node.freeMemory : 0;
+    return found > 0;
+}
+
+bool NumaInfo::ReadNumaStat(ProcFile& file, Node& node, uint64_t elapsedNs) {
+    if (!file.IsOpen() || !file.Read()) return false;
+
+    struct Field {
+        const char* key;
+        size_t keyLength;
+        uint64_t Node::* counter;
+        double Node::* rate;
+    };
+    static const Field kFields[] = {
+        { "numa_hit ", 9, &Node::numaHit, &Node::numaHitPerSec },
+        { "numa_miss ", 10, &Node::numaMiss, &Node::numaMissPerSec },
+        { "numa_foreign ", 13, &Node::numaForeign, &Node::numaForeignPerSec },
+        { "local_node ", 11, &Node::localNode, nullptr },
+        { "other_node ", 11, &Node::otherNode, &Node::otherNodePerSec },
+    };
+
+    const char* p = file.Data();
+    const char* end = file.End();
+    while (p < end) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+        for (const auto& f : kFields) {
+            if (!TextScan::StartsWith(line, p, f.key, f.keyLength)) continue;
+            const char* q = line + f.keyLength;
+            uint64_t value = 0;
+            if (TextScan::NextU64(q, p, value)) {
+                if (f.rate && hasBaseline && elapsedNs > 0) {
+                    node.*(f.rate) = CounterMath::PerSecond(CounterMath::Delta(node.*(f.counter), value), elapsedNs);
+                }
+                node.*(f.counter) = value;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool NumaInfo::Update() {
+    if (nodes.empty()) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t elapsedNs = now - lastSampleNs;
+    bool ok = false;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        ok = ReadMemInfo(nodeFiles[i].meminfo, nodes[i]) || ok;
+        ReadNumaStat(nodeFiles[i].numastat, nodes[i], elapsedNs);
+    }
+    lastSampleNs = now;
+    hasBaseline = true;
+    return ok;
+}
+
+#endif
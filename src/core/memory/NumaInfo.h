@@ -0,0 +1,77 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../cpu/SchedulerStats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <pdh.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// NUMA 节点级内存与 CPU 统计
+// 多路服务器上总量/可用量会掩盖单个节点耗尽和跨节点访问，这里按节点给出内存、numastat 计数器及节点 CPU 使用率
+// Linux: /sys/devices/system/node/node*/{meminfo,numastat,cpulist}
+// Windows: GetNumaAvailableMemoryNodeEx、GetNumaNodeProcessorMaskEx，总量取 PDH "NUMA Node Memory"，无 numastat 等价数据
+class NumaInfo {
+public:
+    struct Node {
+        uint32_t nodeId = 0;
+        uint64_t totalMemory = 0;        // 节点内存总量（字节）
+        uint64_t freeMemory = 0;         // 节点空闲内存（字节）
+        uint64_t usedMemory = 0;         // 节点已用内存（字节）
+        uint64_t numaHit = 0;            // 累计：按意图分配到本节点的页数
+        uint64_t numaMiss = 0;           // 累计：意图在其他节点、实际分配到本节点的页数
+        uint64_t numaForeign = 0;        // 累计：意图在本节点、实际分配到其他节点的页数
+        uint64_t localNode = 0;          // 累计：本节点上运行的进程分配到本节点的页数
+        uint64_t otherNode = 0;          // 累计：其他节点上运行的进程分配到本节点的页数
+        double numaHitPerSec = 0.0;
+        double numaMissPerSec = 0.0;
+        double numaForeignPerSec = 0.0;
+        double otherNodePerSec = 0.0;    // 跨节点分配速率
+        double cpuUsage = 0.0;           // 节点内逻辑核心的平均使用率（%）
+        std::vector<int> cpus;           // 节点内逻辑核心编号
+    };
+
+    NumaInfo();
+    ~NumaInfo();
+
+    NumaInfo(const NumaInfo&) = delete;
+    NumaInfo& operator=(const NumaInfo&) = delete;
+
+    // 刷新节点内存与计数器；首次调用只建立速率基线
+    bool Update();
+    // 用调度器统计的每核心使用率汇总节点 CPU 使用率（避免重复采集 CPU 时间）
+    void ApplyCoreUsage(const std::vector<SchedulerStats::CoreSample>& cores);
+
+    const std::vector<Node>& GetNodes() const { return nodes; }
+    bool IsAvailable() const { return !nodes.empty(); }
+
+private:
+    std::vector<Node> nodes;
+    bool hasBaseline = false;
+    uint64_t lastSampleNs = 0;
+
+#ifdef _WIN32
+    void DiscoverNodes();
+    void InitializeCounters();
+    void CleanupCounters();
+
+    PDH_HQUERY query = nullptr;
+    PDH_HCOUNTER totalMBytesCounter = nullptr;   // \NUMA Node Memory(*)\Total MBytes
+    std::vector<BYTE> counterArrayBuffer;
+#else
+    struct NodeFiles {
+        ProcFile meminfo;
+        ProcFile numastat;
+    };
+
+    void DiscoverNodes();
+    bool ReadMemInfo(ProcFile& file, Node& node);
+    bool ReadNumaStat(ProcFile& file, Node& node, uint64_t elapsedNs);
+
+    std::vector<NodeFiles> nodeFiles;    // 与 nodes 一一对应
+#endif
+};
@@ -5,6 +5,7 @@
 
 #include "NetworkAdapter.h"
 #include "Logger.h"
+#include "../Utils/CounterMath.h"
 #include <comutil.h>
 #include <sstream>
 #include <iomanip>
@@ -22,8 +23,10 @@ NetworkAdapter::~NetworkAdapter() {
 }
 
 void NetworkAdapter::Initialize() {
+    lastEnumerateNs = CounterMath::MonotonicNowNs();
+    ++generation;
     if (wmiManager.IsInitialized()) {
-        QueryAdapterInfo();
+        retryPending = !QueryAdapterInfo();
         initialized = true;
     }
     else {
@@ -33,17 +36,43 @@ void NetworkAdapter::Initialize() {
 
 void NetworkAdapter::Cleanup() {
     adapters.clear();
+    macIndex.clear();
     initialized = false;
 }
 
-void NetworkAdapter::Refresh() {
-    Cleanup();
-    Initialize();
+bool NetworkAdapter::Refresh() {
+    const uint64_t now = CounterMath::MonotonicNowNs();
+    bool changed = changeMonitor.ConsumeChanges();
+    if (!changed && retryPending) {
+        changed = now - lastEnumerateNs >= kRetrySeconds * 1000000000ULL;
+    }
+    if (!changed && !changeMonitor.IsAvailable()) {
+        changed = now - lastEnumerateNs >= kFallbackRefreshSeconds * 1000000000ULL;
+    }
+    if (!changed) return false;
+    lastEnumerateNs = now;
+
+    // 查询失败时保留上次的清单（与 DiskTopology 重建失败时相同），稍后重试
+    std::vector<AdapterInfo> previous;
+    std::unordered_map<std::wstring, size_t> previousIndex;
+    previous.swap(adapters);
+    previousIndex.swap(macIndex);
+    if (!wmiManager.IsInitialized() || !QueryAdapterInfo()) {
+        adapters.swap(previous);
+        macIndex.swap(previousIndex);
+        retryPending = true;
+        Logger::Warn("网卡清单重新枚举失败，保留上次结果");
+        return false;
+    }
+    retryPending = false;
+    ++generation;
+    Logger::Debug("网络变更，网卡清单已重新枚举: " + std::to_string(adapters.size()) + " 个");
+    return true;
 }
 
-void NetworkAdapter::QueryAdapterInfo() {
-    QueryWmiAdapterInfo();
-    UpdateAdapterAddresses();
+bool NetworkAdapter::QueryAdapterInfo() {
+    if (!QueryWmiAdapterInfo()) return false;
+    return UpdateAdapterAddresses();
 }
 
 bool NetworkAdapter::IsVirtualAdapter(const std::wstring& name) const {
@@ -66,7 +95,7 @@ bool NetworkAdapter::IsVirtualAdapter(const std::wstring& name) const {
     return false;
 }
 
-void NetworkAdapter::QueryWmiAdapterInfo() {
+bool NetworkAdapter::QueryWmiAdapterInfo() {
     IEnumWbemClassObject* pEnumerator = nullptr;
     HRESULT hres = wmiManager.GetWmiService()->ExecQuery(
         bstr_t("WQL"),
@@ -78,7 +107,7 @@ void NetworkAdapter::QueryWmiAdapterInfo() {
 
     if (FAILED(hres)) {
         Logger::Error("网络适配器WMI查询失败: HRESULT=0x" + std::to_string(hres));
-        return;
+        return false;
     }
 
     ULONG uReturn = 0;
@@ -128,6 +157,7 @@ void NetworkAdapter::QueryWmiAdapterInfo() {
         info.adapterType = L"未知";
 
         if (!info.name.empty() && !info.mac.empty()) {
+            macIndex[info.mac] = adapters.size();
             adapters.push_back(info);
         }
 
@@ -135,6 +165,7 @@ void NetworkAdapter::QueryWmiAdapterInfo() {
     }
 
     SafeRelease(pEnumerator);
+    return true;
 }
 
 std::wstring NetworkAdapter::FormatMacAddress(const unsigned char* address, size_t length) const {
@@ -147,22 +178,25 @@ std::wstring NetworkAdapter::FormatMacAddress(const unsigned char* address, size
     return ss.str();
 }
 
-void NetworkAdapter::UpdateAdapterAddresses() {
-    ULONG bufferSize = 15000;
-    std::vector<BYTE> buffer(bufferSize);
-    PIP_ADAPTER_ADDRESSES pAddresses = reinterpret_cast<PIP_ADAPTER_ADDRESSES>(&buffer[0]);
+bool NetworkAdapter::UpdateAdapterAddresses() {
+    if (addressBuffer.empty()) addressBuffer.resize(15000);
+    ULONG bufferSize = static_cast<ULONG>(addressBuffer.size());
+    PIP_ADAPTER_ADDRESSES pAddresses = reinterpret_cast<PIP_ADAPTER_ADDRESSES>(addressBuffer.data());
 
-    DWORD result = GetAdaptersAddresses(AF_INET,
-        GAA_FLAG_INCLUDE_PREFIX | GAA_FLAG_INCLUDE_GATEWAYS,  // 添加网关信息
+    // AF_UNSPEC 同时取 IPv4 与 IPv6；DNS 服务器默认包含
+    const ULONG flags = GAA_FLAG_INCLUDE_PREFIX | GAA_FLAG_INCLUDE_GATEWAYS | GAA_FLAG_SKIP_ANYCAST | GAA_FLAG_SKIP_MULTICAST;
+    DWORD result = GetAdaptersAddresses(AF_UNSPEC,
+        flags,
         nullptr,
         pAddresses,
         &bufferSize);
 
-    if (result == ERROR_BUFFER_OVERFLOW) {
-        buffer.resize(bufferSize);
-        pAddresses = reinterpret_cast<PIP_ADAPTER_ADDRESSES>(&buffer[0]);
-        result = GetAdaptersAddresses(AF_INET,
-            GAA_FLAG_INCLUDE_PREFIX | GAA_FLAG_INCLUDE_GATEWAYS,
+    // 两次调用之间接口可能增加，最多重试两次
+    for (int retry = 0; retry < 2 && result == ERROR_BUFFER_OVERFLOW; ++retry) {
+        addressBuffer.resize(bufferSize);
+        pAddresses = reinterpret_cast<PIP_ADAPTER_ADDRESSES>(addressBuffer.data());
+        result = GetAdaptersAddresses(AF_UNSPEC,
+            flags,
             nullptr,
             pAddresses,
             &bufferSize);
@@ -170,7 +204,7 @@ void NetworkAdapter::UpdateAdapterAddresses() {
 
     if (result != NO_ERROR) {
         Logger::Error("获取网络适配器地址失败: " + std::to_string(result));
-        return;
+        return false;
     }
 
     for (PIP_ADAPTER_ADDRESSES adapter = pAddresses; adapter; adapter = adapter->Next) {
@@ -183,50 +217,79 @@ void NetworkAdapter::UpdateAdapterAddresses() {
             adapter->PhysicalAddress,
             adapter->PhysicalAddressLength);
 
-        for (auto& adapterInfo : adapters) {
-            if (adapterInfo.mac == macAddress) {
-                // 更新连接状态
-                adapterInfo.isConnected = (adapter->OperStatus == IfOperStatusUp);
-
-                // 更新网络速度 - 修复未连接网卡显示异常速度问题
-                if (adapterInfo.isConnected) {
-                    // 仅当连接时记录真实速度
-                    adapterInfo.speed = adapter->TransmitLinkSpeed;
-                    adapterInfo.speedString = FormatSpeed(adapter->TransmitLinkSpeed);
-                } else {
-                    // 未连接时设置为0
-                    adapterInfo.speed = 0;
-                    adapterInfo.speedString = L"未连接";
-                }
-
-                // 确定网卡类型
-                adapterInfo.adapterType = DetermineAdapterType(
-                    adapterInfo.name, 
-                    adapterInfo.description, 
-                    adapter->IfType
-                );
-
-                // 更新IP地址（仅当连接时）
-                if (adapterInfo.isConnected) {
-                    PIP_ADAPTER_UNICAST_ADDRESS address = adapter->FirstUnicastAddress;
-                    while (address) {
-                        if (address->Address.lpSockaddr->sa_family == AF_INET) {
-                            char ipStr[INET_ADDRSTRLEN];
-                            sockaddr_in* ipv4 = reinterpret_cast<sockaddr_in*>(address->Address.lpSockaddr);
-                            inet_ntop(AF_INET, &(ipv4->sin_addr), ipStr, INET_ADDRSTRLEN);
-                            adapterInfo.ip = std::wstring(ipStr, ipStr + strlen(ipStr));
-                            break;
-                        }
-                        address = address->Next;
-                    }
-                }
-                else {
-                    adapterInfo.ip = L"未连接";
-                }
-                break;
+        auto indexed = macIndex.find(macAddress);
+        if (indexed == macIndex.end()) continue;
+        AdapterInfo& adapterInfo = adapters[indexed->second];
+        // 更新连接状态
+        adapterInfo.isConnected = (adapter->OperStatus == IfOperStatusUp);
+
+        // 更新网络速度 - 修复未连接网卡显示异常速度问题
+        if (adapterInfo.isConnected) {
+            // 仅当连接时记录真实速度
+            adapterInfo.speed = adapter->TransmitLinkSpeed;
+            adapterInfo.speedString = FormatSpeed(adapter->TransmitLinkSpeed);
+        } else {
+            // 未连接时设置为0
+            adapterInfo.speed = 0;
+            adapterInfo.speedString = L"未连接";
+        }
+
+        // 确定网卡类型
+        adapterInfo.adapterType = DetermineAdapterType(
+            adapterInfo.name, 
+            adapterInfo.description, 
+            adapter->IfType
+        );
+
+        // 更新地址、网关与DNS（仅当连接时）
+        adapterInfo.addresses.clear();
+        adapterInfo.gateways.clear();
+        adapterInfo.dnsServers.clear();
+        if (adapterInfo.isConnected) {
+            Address entry;
+            for (auto* unicast = adapter->FirstUnicastAddress; unicast; unicast = unicast->Next) {
+                if (!FormatSocketAddress(unicast->Address, entry)) continue;
+                entry.prefixLength = unicast->OnLinkPrefixLength;
+                adapterInfo.addresses.push_back(entry);
+            }
+            for (auto* gateway = adapter->FirstGatewayAddress; gateway; gateway = gateway->Next) {
+                if (FormatSocketAddress(gateway->Address, entry)) adapterInfo.gateways.push_back(entry);
             }
+            for (auto* dns = adapter->FirstDnsServerAddress; dns; dns = dns->Next) {
+                if (FormatSocketAddress(dns->Address, entry)) adapterInfo.dnsServers.push_back(entry);
+            }
+
+            // 主地址：IPv4 优先，纯 IPv6 主机取第一个非链路本地地址
+            const Address* primary = nullptr;
+            for (const auto& candidate : adapterInfo.addresses) {
+                if (candidate.family == AF_INET) { primary = &candidate; break; }
+                if (!primary && candidate.address.compare(0, 5, L"fe80:") != 0) primary = &candidate;
+            }
+            if (!primary && !adapterInfo.addresses.empty()) primary = &adapterInfo.addresses.front();
+            adapterInfo.ip = primary ? primary->address : L"";
+        }
+        else {
+            adapterInfo.ip = L"未连接";
         }
     }
+    return true;
+}
+
+bool NetworkAdapter::FormatSocketAddress(const SOCKET_ADDRESS& socketAddress, Address& out) {
+    const sockaddr* sa = socketAddress.lpSockaddr;
+    if (!sa) return false;
+    char text[INET6_ADDRSTRLEN] = {};
+    if (sa->sa_family == AF_INET) {
+        inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(sa)->sin_addr, text, sizeof(text));
+    } else if (sa->sa_family == AF_INET6) {
+        inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6*>(sa)->sin6_addr, text, sizeof(text));
+    } else {
+        return false;
+    }
+    out.address.assign(text, text + strlen(text));
+    out.family = sa->sa_family;
+    out.prefixLength = 0;
+    return !out.address.empty();
 }
 
 // 添加格式化网络速度的辅助方法
@@ -4,36 +4,57 @@
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <iphlpapi.h>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "WmiManager.h"
+#include "NetworkChangeMonitor.h"
 
+// 网卡清单常驻缓存：只在收到网络变更通知时重新执行 WMI 查询与地址枚举，
+// 通知不可用时每60秒重新枚举一次；重新枚举失败时保留上次的清单，kRetrySeconds 秒后重试
 class NetworkAdapter {
 public:
+    struct Address {
+        std::wstring address;           // 文本形式，IPv6 不含 %scope
+        int family = AF_INET;           // AF_INET / AF_INET6
+        uint8_t prefixLength = 0;       // 仅单播地址有效
+    };
+
     struct AdapterInfo {
         std::wstring name;
         std::wstring mac;
-        std::wstring ip;
+        std::wstring ip;                // 主地址：优先 IPv4，其次非链路本地 IPv6
+        std::vector<Address> addresses; // 全部单播地址（IPv4 与 IPv6）
+        std::vector<Address> gateways;
+        std::vector<Address> dnsServers;
         std::wstring description;
         std::wstring adapterType; // 新增：网卡类型（无线/有线）
-        bool isEnabled;
-        bool isConnected;
-        uint64_t speed;
+        bool isEnabled = false;
+        bool isConnected = false;
+        uint64_t speed = 0;
         std::wstring speedString;
     };
 
     explicit NetworkAdapter(WmiManager& manager);
     ~NetworkAdapter();
 
+    static constexpr uint64_t kFallbackRefreshSeconds = 60;
+    static constexpr uint64_t kRetrySeconds = 5;
+
     const std::vector<AdapterInfo>& GetAdapters() const;
-    void Refresh();
+    // 有变更时重新枚举；返回是否重新枚举
+    bool Refresh();
+    // 每次重新枚举后递增
+    uint64_t GetGeneration() const { return generation; }
 
 private:
     void Initialize();
     void Cleanup();
-    void QueryAdapterInfo();
-    void QueryWmiAdapterInfo();
-    void UpdateAdapterAddresses();
+    bool QueryAdapterInfo();
+    bool QueryWmiAdapterInfo();
+    bool UpdateAdapterAddresses();
+    static bool FormatSocketAddress(const SOCKET_ADDRESS& socketAddress, Address& out);
     std::wstring FormatMacAddress(const unsigned char* address, size_t length) const;
     std::wstring FormatSpeed(uint64_t bitsPerSecond) const;  // 添加声明
     bool IsVirtualAdapter(const std::wstring& name) const;
@@ -42,5 +63,11 @@ private:
 
     WmiManager& wmiManager;
     std::vector<AdapterInfo> adapters;
+    std::unordered_map<std::wstring, size_t> macIndex;     // MAC -> adapters 下标
+    std::vector<BYTE> addressBuffer;                       // GetAdaptersAddresses 缓冲区，只增不减
+    NetworkChangeMonitor changeMonitor;
+    uint64_t generation = 0;
+    uint64_t lastEnumerateNs = 0;
+    bool retryPending = false;          // 上次重新枚举失败，等待重试
     bool initialized;
 };
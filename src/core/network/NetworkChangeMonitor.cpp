@@ -0,0 +1,139 @@
+﻿#include "NetworkChangeMonitor.h"
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#pragma comment(lib, "iphlpapi.lib")
+#else
+#include <cerrno>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+NetworkChangeMonitor::NetworkChangeMonitor() {
+    // InitialNotification = FALSE：注册时不回调当前已有的接口
+    if (NotifyIpInterfaceChange(AF_UNSPEC, &NetworkChangeMonitor::OnInterfaceChange, this, FALSE, &interfaceHandle) != NO_ERROR) {
+        interfaceHandle = NULL;
+    }
+    if (NotifyUnicastIpAddressChange(AF_UNSPEC, &NetworkChangeMonitor::OnAddressChange, this, FALSE, &addressHandle) != NO_ERROR) {
+        addressHandle = NULL;
+    }
+    if (NotifyRouteChange2(AF_UNSPEC, &NetworkChangeMonitor::OnRouteChange, this, FALSE, &routeHandle) != NO_ERROR) {
+        routeHandle = NULL;
+    }
+
+    // DNS 服务器（静态配置与 DHCP 下发）写在各接口的注册表子键中
+    const wchar_t* dnsKeys[2] = {
+        L"SYSTEM\\CurrentControlSet\\Services\\Tcpip\\Parameters\\Interfaces",
+        L"SYSTEM\\CurrentControlSet\\Services\\Tcpip6\\Parameters\\Interfaces",
+    };
+    for (int i = 0; i < 2; ++i) {
+        RegistryWatch& watch = dnsWatches[i];
+        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, dnsKeys[i], 0, KEY_NOTIFY, &watch.key) != ERROR_SUCCESS) {
+            watch.key = NULL;
+            continue;
+        }
+        watch.event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        if (!watch.event || !ArmRegistryWatch(watch)) {
+            Logger::Warn("DNS 配置变更通知注册失败，DNS 服务器变化需等到其他网络变更时刷新");
+        }
+    }
+    available = interfaceHandle != NULL;
+    if (!available) Logger::Warn("网络变更通知注册失败，网卡信息将定期重新枚举");
+}
+
+NetworkChangeMonitor::~NetworkChangeMonitor() {
+    // CancelMibChangeNotify2 会等待正在执行的回调返回
+    if (interfaceHandle) CancelMibChangeNotify2(interfaceHandle);
+    if (addressHandle) CancelMibChangeNotify2(addressHandle);
+    if (routeHandle) CancelMibChangeNotify2(routeHandle);
+    for (RegistryWatch& watch : dnsWatches) {
+        if (watch.key) RegCloseKey(watch.key);
+        if (watch.event) CloseHandle(watch.event);
+    }
+}
+
+// REG_NOTIFY_THREAD_AGNOSTIC：通知不随调用线程退出而失效；每次触发后需要重新登记
+bool NetworkChangeMonitor::ArmRegistryWatch(RegistryWatch& watch) {
+    if (!watch.key || !watch.event) return false;
+    return RegNotifyChangeKeyValue(watch.key, TRUE, REG_NOTIFY_CHANGE_NAME | REG_NOTIFY_CHANGE_LAST_SET | REG_NOTIFY_THREAD_AGNOSTIC,
+        watch.event, TRUE) == ERROR_SUCCESS;
+}
+
+void NetworkChangeMonitor::CheckRegistryWatches() {
+    for (RegistryWatch& watch : dnsWatches) {
+        if (!watch.event || WaitForSingleObject(watch.event, 0) != WAIT_OBJECT_0) continue;
+        changeCount.fetch_add(1, std::memory_order_relaxed);
+        ArmRegistryWatch(watch);
+    }
+}
+
+VOID NETIOAPI_API_ NetworkChangeMonitor::OnInterfaceChange(PVOID context, PMIB_IPINTERFACE_ROW, MIB_NOTIFICATION_TYPE) {
+    static_cast<NetworkChangeMonitor*>(context)->changeCount.fetch_add(1, std::memory_order_release);
+}
+
+VOID NETIOAPI_API_ NetworkChangeMonitor::OnAddressChange(PVOID context, PMIB_UNICASTIPADDRESS_ROW, MIB_NOTIFICATION_TYPE) {
+    static_cast<NetworkChangeMonitor*>(context)->changeCount.fetch_add(1, std::memory_order_release);
+}
+
+VOID NETIOAPI_API_ NetworkChangeMonitor::OnRouteChange(PVOID context, PMIB_IPFORWARD_ROW2, MIB_NOTIFICATION_TYPE) {
+    static_cast<NetworkChangeMonitor*>(context)->changeCount.fetch_add(1, std::memory_order_release);
+}
+
+#else
+
+NetworkChangeMonitor::NetworkChangeMonitor() {
+    socketFd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (socketFd < 0) return;
+    sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    // 路由组用于发现默认网关变化
+    addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE;
+    if (bind(socketFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(socketFd);
+        socketFd = -1;
+        return;
+    }
+    available = true;
+}
+
+NetworkChangeMonitor::~NetworkChangeMonitor() {
+    if (socketFd >= 0) close(socketFd);
+}
+
+// 订阅的组只会收到 RTM_NEWLINK/DELLINK/NEWADDR/DELADDR/NEWROUTE/DELROUTE，不需要解析内容，有数据即视为变更
+void NetworkChangeMonitor::Drain() {
+    if (socketFd < 0) return;
+    char buffer[8192];
+    for (;;) {
+        ssize_t n = recv(socketFd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            changeCount.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        // 接收队列溢出说明丢了事件，按发生过变更处理
+        if (n < 0 && errno == ENOBUFS) {
+            changeCount.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        break;
+    }
+}
+
+#endif
+
+bool NetworkChangeMonitor::ConsumeChanges() {
+#ifdef _WIN32
+    CheckRegistryWatches();
+#else
+    Drain();
+#endif
+    uint64_t count = changeCount.load(std::memory_order_acquire);
+    if (count == consumedCount) return false;
+    consumedCount = count;
+    return true;
+}
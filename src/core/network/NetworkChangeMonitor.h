@@ -0,0 +1,57 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+#include <iphlpapi.h>
+#endif
+
+// 网络接口/地址变更通知
+// 只累计变更次数，使用方在 ConsumeChanges() 返回 true 时再重新枚举网卡
+// Windows: NotifyIpInterfaceChange（接口增删、连接状态）、NotifyUnicastIpAddressChange（地址变化）与
+//          NotifyRouteChange2（网关/路由变化），回调在系统线程池中执行；DNS 服务器没有对应的通知，
+//          改为监视 Tcpip/Tcpip6 的 Parameters\Interfaces 注册表键，ConsumeChanges() 时非阻塞检查事件
+// Linux: NETLINK_ROUTE 非阻塞套接字订阅链路、IPv4/IPv6 地址与路由组，ConsumeChanges() 时读空队列
+class NetworkChangeMonitor {
+public:
+    NetworkChangeMonitor();
+    ~NetworkChangeMonitor();
+
+    NetworkChangeMonitor(const NetworkChangeMonitor&) = delete;
+    NetworkChangeMonitor& operator=(const NetworkChangeMonitor&) = delete;
+
+    // 自上次调用以来是否发生过网络变更
+    bool ConsumeChanges();
+    // 通知机制不可用时使用方应退回到定期重新枚举
+    bool IsAvailable() const { return available; }
+
+private:
+    std::atomic<uint64_t> changeCount{ 0 };
+    uint64_t consumedCount = 0;
+    bool available = false;
+
+#ifdef _WIN32
+    static VOID NETIOAPI_API_ OnInterfaceChange(PVOID context, PMIB_IPINTERFACE_ROW row, MIB_NOTIFICATION_TYPE type);
+    static VOID NETIOAPI_API_ OnAddressChange(PVOID context, PMIB_UNICASTIPADDRESS_ROW row, MIB_NOTIFICATION_TYPE type);
+    static VOID NETIOAPI_API_ OnRouteChange(PVOID context, PMIB_IPFORWARD_ROW2 row, MIB_NOTIFICATION_TYPE type);
+
+    struct RegistryWatch {
+        HKEY key = NULL;
+        HANDLE event = NULL;
+    };
+
+    bool ArmRegistryWatch(RegistryWatch& watch);
+    void CheckRegistryWatches();
+
+    HANDLE interfaceHandle = NULL;
+    HANDLE addressHandle = NULL;
+    HANDLE routeHandle = NULL;
+    RegistryWatch dnsWatches[2];        // Tcpip、Tcpip6
+#else
+    void Drain();
+
+    int socketFd = -1;
+#endif
+};
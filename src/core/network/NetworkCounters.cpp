@@ -0,0 +1,199 @@
+﻿#include "NetworkCounters.h"
+#include "../Utils/CounterMath.h"
+#include <algorithm>
+#include <cctype>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include "../Utils/WinUtils.h"
+#include <cstdio>
+#pragma comment(lib, "iphlpapi.lib")
+#else
+#include "../Utils/TextScan.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#endif
+
+NetworkCounters::NetworkCounters() {
+#ifndef _WIN32
+    available = netDevFile.Open("/proc/net/dev", 8192);
+#endif
+    Rescan();
+}
+
+const NetworkCounters::Interface* NetworkCounters::FindByMac(const std::string& mac) const {
+    for (const auto& iface : interfaces) {
+        if (iface.mac.size() == mac.size() &&
+            std::equal(mac.begin(), mac.end(), iface.mac.begin(), [](char a, char b) { return std::toupper(static_cast<unsigned char>(a)) == b; })) {
+            return &iface;
+        }
+    }
+    return nullptr;
+}
+
+double NetworkCounters::UtilizationPercent(const Interface& iface, uint64_t linkSpeedBps) {
+    uint64_t speed = linkSpeedBps ? linkSpeedBps : iface.linkSpeedBps;
+    if (speed == 0) return 0.0;
+    double bitsPerSec = (std::max)(iface.rxBytesPerSec, iface.txBytesPerSec) * 8.0;
+    return (std::min)(bitsPerSec * 100.0 / static_cast<double>(speed), 100.0);
+}
+
+// counters 顺序: 收字节 发字节 收包 发包 收错误 发错误 收丢弃 发丢弃
+void NetworkCounters::ApplySample(Interface& iface, const uint64_t (&counters)[8], uint64_t elapsedNs) {
+    uint64_t* previous[8] = { &iface.rxBytes, &iface.txBytes, &iface.rxPackets, &iface.txPackets,
+        &iface.rxErrors, &iface.txErrors, &iface.rxDrops, &iface.txDrops };
+    double* rates[8] = { &iface.rxBytesPerSec, &iface.txBytesPerSec, &iface.rxPacketsPerSec, &iface.txPacketsPerSec,
+        &iface.rxErrorsPerSec, &iface.txErrorsPerSec, &iface.rxDropsPerSec, &iface.txDropsPerSec };
+    for (int i = 0; i < 8; ++i) {
+        *rates[i] = (iface.hasBaseline && elapsedNs > 0)
+            ? CounterMath::PerSecond(CounterMath::Delta64(*previous[i], counters[i]), elapsedNs) : 0.0;
+        *previous[i] = counters[i];
+    }
+    iface.hasBaseline = true;
+    iface.seen = true;
+}
+
+#ifdef _WIN32
+
+namespace {
+    std::string FormatMac(const UCHAR* address, ULONG length) {
+        std::string mac;
+        char part[4];
+        for (ULONG i = 0; i < length; ++i) {
+            snprintf(part, sizeof(part), i ? ":%02X" : "%02X", address[i]);
+            mac += part;
+        }
+        return mac;
+    }
+}
+
+void NetworkCounters::Rescan() {
+    PMIB_IF_TABLE2 table = nullptr;
+    if (GetIfTable2(&table) != NO_ERROR || !table) {
+        // 保留已选定的接口与基线，下次 Rescan 再重试
+        Logger::Warn("GetIfTable2 失败，沿用上次的接口列表");
+        return;
+    }
+    // 按 LUID 沿用已有接口的累计值与基线，重新枚举后的第一个周期不会出现零流量
+    std::vector<Interface> previous = std::move(interfaces);
+    std::vector<NET_LUID> previousLuids = std::move(luids);
+    interfaces.clear();
+    luids.clear();
+    for (ULONG i = 0; i < table->NumEntries; ++i) {
+        const MIB_IF_ROW2& row = table->Table[i];
+        // 只保留物理网卡本身，排除同一网卡上叠加的 NDIS 过滤驱动接口
+        if (!row.InterfaceAndOperStatusFlags.HardwareInterface || row.InterfaceAndOperStatusFlags.FilterInterface) continue;
+        if (row.Type != IF_TYPE_ETHERNET_CSMACD && row.Type != IF_TYPE_IEEE80211) continue;
+        if (row.PhysicalAddressLength == 0) continue;
+        Interface iface;
+        for (size_t j = 0; j < previousLuids.size(); ++j) {
+            if (previousLuids[j].Value == row.InterfaceLuid.Value) {
+                iface = std::move(previous[j]);
+                break;
+            }
+        }
+        iface.name = WinUtils::WstringToUtf8(row.Alias);
+        iface.mac = FormatMac(row.PhysicalAddress, row.PhysicalAddressLength);
+        interfaces.push_back(std::move(iface));
+        luids.push_back(row.InterfaceLuid);
+    }
+    FreeMibTable(table);
+    available = !interfaces.empty();
+    Logger::Debug("网卡计数: 发现 " + std::to_string(interfaces.size()) + " 个物理接口");
+}
+
+bool NetworkCounters::Update() {
+    if (!available) return false;
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t elapsedNs = lastSampleNs ? now - lastSampleNs : 0;
+    bool anyFailed = false;
+    for (size_t i = 0; i < interfaces.size(); ++i) {
+        MIB_IF_ROW2 row{};
+        row.InterfaceLuid = luids[i];
+        if (GetIfEntry2(&row) != NO_ERROR) {
+            interfaces[i].seen = false;
+            anyFailed = true;
+            continue;
+        }
+        uint64_t counters[8] = { row.InOctets, row.OutOctets, row.InUcastPkts + row.InNUcastPkts, row.OutUcastPkts + row.OutNUcastPkts,
+            row.InErrors, row.OutErrors, row.InDiscards, row.OutDiscards };
+        interfaces[i].linkSpeedBps = row.OperStatus == IfOperStatusUp ? row.TransmitLinkSpeed : 0;
+        ApplySample(interfaces[i], counters, elapsedNs);
+    }
+    // 网卡被移除后丢弃，下次 Rescan 再发现新网卡
+    if (anyFailed) {
+        for (size_t i = interfaces.size(); i-- > 0;) {
+            if (interfaces[i].seen) continue;
+            interfaces.erase(interfaces.begin() + i);
+            luids.erase(luids.begin() + i);
+        }
+    }
+    lastSampleNs = now;
+    return true;
+}
+
+#else
+
+void NetworkCounters::ReadSysfsInfo(Interface& iface) const {
+    const std::string base = "/sys/class/net/" + iface.name;
+    std::ifstream addressFile(base + "/address");
+    std::getline(addressFile, iface.mac);
+    for (char& c : iface.mac) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    // speed 单位为 Mb/s，链路断开或虚拟网卡为 -1 或读取失败
+    std::ifstream speedFile(base + "/speed");
+    long long megabits = 0;
+    if (speedFile >> megabits && megabits > 0) iface.linkSpeedBps = static_cast<uint64_t>(megabits) * 1000000ULL;
+}
+
+// 新接口在 Update() 中自动出现，消失的接口自动移除，这里无需处理；保留已有基线
+void NetworkCounters::Rescan() {}
+
+// 前两行为表头；每行: 名称: 收字节 收包 收错误 收丢弃 fifo frame compressed multicast 发字节 发包 发错误 发丢弃 fifo colls carrier compressed
+bool NetworkCounters::Update() {
+    if (!available || !netDevFile.Read()) return false;
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t elapsedNs = lastSampleNs ? now - lastSampleNs : 0;
+    for (auto& iface : interfaces) iface.seen = false;
+
+    const char* end = netDevFile.End();
+    const char* p = TextScan::NextLine(TextScan::NextLine(netDevFile.Data(), end), end);
+    while (p < end) {
+        const char* lineEnd = TextScan::NextLine(p, end);
+        p = TextScan::SkipSpaces(p, lineEnd);
+        const char* colon = static_cast<const char*>(memchr(p, ':', static_cast<size_t>(lineEnd - p)));
+        if (!colon) { p = lineEnd; continue; }
+        size_t nameLength = static_cast<size_t>(colon - p);
+        const char* name = p;
+        p = colon + 1;
+        if (nameLength == 2 && memcmp(name, "lo", 2) == 0) { p = lineEnd; continue; }
+
+        uint64_t f[16] = {};
+        int count = 0;
+        while (count < 16 && TextScan::NextU64(p, lineEnd, f[count])) ++count;
+        p = lineEnd;
+        if (count < 16) continue;
+
+        Interface* iface = nullptr;
+        for (auto& candidate : interfaces) {
+            if (candidate.name.size() == nameLength && memcmp(candidate.name.data(), name, nameLength) == 0) {
+                iface = &candidate;
+                break;
+            }
+        }
+        if (!iface) {
+            Interface fresh;
+            fresh.name.assign(name, nameLength);
+            ReadSysfsInfo(fresh);
+            interfaces.push_back(std::move(fresh));
+            iface = &interfaces.back();
+        }
+        uint64_t counters[8] = { f[0], f[8], f[1], f[9], f[2], f[10], f[3], f[11] };
+        ApplySample(*iface, counters, elapsedNs);
+    }
+    interfaces.erase(std::remove_if(interfaces.begin(), interfaces.end(), [](const Interface& i) { return !i.seen; }), interfaces.end());
+    lastSampleNs = now;
+    return true;
+}
+
+#endif
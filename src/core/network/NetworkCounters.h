@@ -0,0 +1,77 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+#include <iphlpapi.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// 网卡流量与错误计数（吞吐、包速率、错误、丢包、链路利用率）
+// 所有速率基于单调时钟的相邻两次采样差值，计数器均为64位，变小按重置处理（CounterMath::Delta64），不会出现32位回绕尖峰
+// Windows: Rescan() 时用 GetIfTable2 选出物理以太网/无线接口，之后每次采样只对这些接口调用 GetIfEntry2（不分配内存）
+// Linux: /proc/net/dev（常驻 fd + pread），新接口首次出现时从 /sys/class/net/<名称>/ 读取 MAC 与链路速率；跳过 lo
+class NetworkCounters {
+public:
+    struct Interface {
+        std::string name;               // Windows: 接口别名（UTF-8）；Linux: eth0
+        std::string mac;                // AA:BB:CC:DD:EE:FF，与 NetworkAdapter 的 MAC 格式一致
+        uint64_t linkSpeedBps = 0;      // 接口上报的链路速率，未知为0
+        double rxBytesPerSec = 0.0;
+        double txBytesPerSec = 0.0;
+        double rxPacketsPerSec = 0.0;
+        double txPacketsPerSec = 0.0;
+        double rxErrorsPerSec = 0.0;
+        double txErrorsPerSec = 0.0;
+        double rxDropsPerSec = 0.0;
+        double txDropsPerSec = 0.0;
+
+        // 最近一次采样的累计值
+        uint64_t rxBytes = 0;
+        uint64_t txBytes = 0;
+        uint64_t rxPackets = 0;
+        uint64_t txPackets = 0;
+        uint64_t rxErrors = 0;
+        uint64_t txErrors = 0;
+        uint64_t rxDrops = 0;
+        uint64_t txDrops = 0;
+        bool hasBaseline = false;
+        bool seen = false;
+    };
+
+    NetworkCounters();
+
+    NetworkCounters(const NetworkCounters&) = delete;
+    NetworkCounters& operator=(const NetworkCounters&) = delete;
+
+    // 采样一次；新接口在首次出现的周期只建立基线
+    bool Update();
+    // 重新枚举接口（Windows 下在网卡插拔后调用，Linux 下新接口会自动出现）；已有接口保留基线
+    void Rescan();
+
+    const std::vector<Interface>& GetInterfaces() const { return interfaces; }
+    const Interface* FindByMac(const std::string& mac) const;
+    bool IsAvailable() const { return available; }
+
+    // 链路利用率：收发中较大的一方占链路速率的百分比（全双工链路收发各自独立）
+    static double UtilizationPercent(const Interface& iface, uint64_t linkSpeedBps);
+
+private:
+    void ApplySample(Interface& iface, const uint64_t (&counters)[8], uint64_t elapsedNs);
+
+    std::vector<Interface> interfaces;
+    bool available = false;
+    uint64_t lastSampleNs = 0;
+
+#ifdef _WIN32
+    std::vector<NET_LUID> luids;        // 与 interfaces 一一对应
+#else
+    void ReadSysfsInfo(Interface& iface) const;
+
+    ProcFile netDevFile;
+#endif
+};
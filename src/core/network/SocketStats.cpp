@@ -0,0 +1,411 @@
+﻿#include "SocketStats.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/ProcessName.h"
+#include <algorithm>
+#include <iterator>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <ws2tcpip.h>
+#include <iphlpapi.h>
+#pragma comment(lib, "iphlpapi.lib")
+#else
+#include "../Utils/TextScan.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+bool SocketStats::Update() {
+    if (!available) return false;
+    uint64_t now = CounterMath::MonotonicNowNs();
+    bool scanProcesses = lastProcessScanNs == 0 || now - lastProcessScanNs >= processScanIntervalNs;
+
+    uint64_t counters[kCounterCount] = {};
+    bool countersRead = ReadProtocolCounters(counters);
+    if (countersRead) {
+        ApplyCounters(counters, hasBaseline ? now - lastSampleNs : 0);
+        lastSampleNs = now;
+    } else {
+        summary.protocolValid = false;
+    }
+
+    summary.socketsValid = CollectSockets(scanProcesses, countersRead ? &counters[CurrEstab] : nullptr);
+    if (scanProcesses && summary.socketsValid) {
+        SelectTopProcesses();
+        lastProcessScanNs = now;
+        uint64_t costNs = CounterMath::MonotonicNowNs() - now;
+        processScanIntervalNs = (std::max<uint64_t>)(kProcessScanSeconds * 1000000000ULL, costNs * kProcessScanBudget);
+    }
+    return summary.socketsValid || summary.protocolValid;
+}
+
+void SocketStats::ApplyCounters(const uint64_t (&counters)[kCounterCount], uint64_t elapsedNs) {
+    // 与 Counter 顺序一致；InSegs/OutSegs 只用于计算重传比例
+    double* rates[kCounterCount] = {
+        &summary.activeOpensPerSec, &summary.passiveOpensPerSec, &summary.attemptFailsPerSec, &summary.estabResetsPerSec,
+        nullptr, nullptr, &summary.retransSegsPerSec, &summary.tcpInErrorsPerSec, &summary.tcpOutResetsPerSec,
+        &summary.udpInDatagramsPerSec, &summary.udpNoPortsPerSec, &summary.udpInErrorsPerSec, &summary.udpOutDatagramsPerSec,
+        &summary.udpReceiveBufferErrorsPerSec, &summary.listenOverflowsPerSec, &summary.listenDropsPerSec, nullptr
+    };
+    bool valid = hasBaseline && elapsedNs > 0;
+    uint64_t deltas[kCounterCount] = {};
+    for (int i = 0; i < kCounterCount; ++i) {
+        if (valid) deltas[i] = CounterMath::Delta(previousCounters[i], counters[i]);
+        if (rates[i]) *rates[i] = valid ? CounterMath::PerSecond(deltas[i], elapsedNs) : 0.0;
+        previousCounters[i] = counters[i];
+    }
+    summary.retransPercent = deltas[OutSegs] ? 100.0 * static_cast<double>(deltas[RetransSegs]) / static_cast<double>(deltas[OutSegs]) : 0.0;
+    summary.protocolValid = valid;
+    hasBaseline = true;
+}
+
+void SocketStats::SelectTopProcesses() {
+    std::vector<std::pair<uint32_t, ProcessCounts>> ranked(processCounts.begin(), processCounts.end());
+    size_t keep = (std::min)(ranked.size(), kTopProcesses);
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(), [](const auto& a, const auto& b) {
+        return a.second.tcp + a.second.udp > b.second.tcp + b.second.udp;
+    });
+
+    topProcesses.resize(keep);
+    for (size_t i = 0; i < keep; ++i) {
+        ProcessConnections& entry = topProcesses[i];
+        bool samePid = entry.pid == ranked[i].first;
+        entry.pid = ranked[i].first;
+        entry.tcpConnections = ranked[i].second.tcp;
+        entry.udpSockets = ranked[i].second.udp;
+        if (samePid && !entry.name.empty()) continue;
+        entry.name = ProcessName::Query(entry.pid);
+    }
+}
+
+#ifdef _WIN32
+
+namespace {
+    // MIB_TCP_STATE（1..12）到 SocketStats::TcpState 的映射，DELETE_TCB 归入 Close
+    const int kWindowsStateMap[13] = {
+        -1, SocketStats::Close, SocketStats::Listen, SocketStats::SynSent, SocketStats::SynRecv, SocketStats::Established,
+        SocketStats::FinWait1, SocketStats::FinWait2, SocketStats::CloseWait, SocketStats::Closing, SocketStats::LastAck,
+        SocketStats::TimeWait, SocketStats::Close
+    };
+
+    // 表大小在两次调用之间可能增长，扩容时多留余量并重试
+    template <typename Query>
+    bool QueryTable(std::vector<BYTE>& buffer, Query query) {
+        if (buffer.empty()) buffer.resize(64 * 1024);
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            DWORD size = static_cast<DWORD>(buffer.size());
+            DWORD result = query(buffer.data(), &size);
+            if (result == NO_ERROR) return true;
+            if (result != ERROR_INSUFFICIENT_BUFFER) return false;
+            buffer.resize(size + size / 8);
+        }
+        return false;
+    }
+}
+
+SocketStats::SocketStats() {
+    available = true;
+}
+
+SocketStats::~SocketStats() = default;
+
+bool SocketStats::CollectSockets(bool scanProcesses, const uint64_t*) {
+    Summary& s = summary;
+    std::fill(std::begin(s.tcpStates), std::end(s.tcpStates), 0u);
+    s.tcpSockets = 0;
+    s.udpSockets = 0;
+    s.listenQueueFull = 0;
+    if (scanProcesses) processCounts.clear();
+
+    auto countTcp = [&](DWORD state, DWORD pid) {
+        int mapped = state < 13 ? kWindowsStateMap[state] : -1;
+        if (mapped < 0) return;
+        ++s.tcpStates[mapped];
+        ++s.tcpSockets;
+        if (scanProcesses && pid != 0 && mapped != Listen) ++processCounts[pid].tcp;
+    };
+    auto countUdp = [&](DWORD pid) {
+        ++s.udpSockets;
+        if (scanProcesses && pid != 0) ++processCounts[pid].udp;
+    };
+
+    bool ok = false;
+    if (QueryTable(tableBuffer, [](BYTE* data, DWORD* size) {
+            return GetExtendedTcpTable(data, size, FALSE, AF_INET, TCP_TABLE_OWNER_PID_ALL, 0); })) {
+        auto* table = reinterpret_cast<MIB_TCPTABLE_OWNER_PID*>(tableBuffer.data());
+        for (DWORD i = 0; i < table->dwNumEntries; ++i) countTcp(table->table[i].dwState, table->table[i].dwOwningPid);
+        ok = true;
+    }
+    if (QueryTable(tableBuffer, [](BYTE* data, DWORD* size) {
+            return GetExtendedTcpTable(data, size, FALSE, AF_INET6, TCP_TABLE_OWNER_PID_ALL, 0); })) {
+        auto* table = reinterpret_cast<MIB_TCP6TABLE_OWNER_PID*>(tableBuffer.data());
+        for (DWORD i = 0; i < table->dwNumEntries; ++i) countTcp(table->table[i].dwState, table->table[i].dwOwningPid);
+        ok = true;
+    }
+    if (QueryTable(tableBuffer, [](BYTE* data, DWORD* size) {
+            return GetExtendedUdpTable(data, size, FALSE, AF_INET, UDP_TABLE_OWNER_PID, 0); })) {
+        auto* table = reinterpret_cast<MIB_UDPTABLE_OWNER_PID*>(tableBuffer.data());
+        for (DWORD i = 0; i < table->dwNumEntries; ++i) countUdp(table->table[i].dwOwningPid);
+    }
+    if (QueryTable(tableBuffer, [](BYTE* data, DWORD* size) {
+            return GetExtendedUdpTable(data, size, FALSE, AF_INET6, UDP_TABLE_OWNER_PID, 0); })) {
+        auto* table = reinterpret_cast<MIB_UDP6TABLE_OWNER_PID*>(tableBuffer.data());
+        for (DWORD i = 0; i < table->dwNumEntries; ++i) countUdp(table->table[i].dwOwningPid);
+    }
+    if (!ok) Logger::Warn("GetExtendedTcpTable 失败，套接字计数不可用");
+    return ok;
+}
+
+// TCP 计数在 IPv4/IPv6 间分开统计，这里求和；监听队列溢出没有对应计数，保持为0
+bool SocketStats::ReadProtocolCounters(uint64_t (&counters)[kCounterCount]) {
+    bool ok = false;
+    for (ULONG family : { static_cast<ULONG>(AF_INET), static_cast<ULONG>(AF_INET6) }) {
+        MIB_TCPSTATS2 tcp{};
+        if (GetTcpStatisticsEx2(&tcp, family) == NO_ERROR) {
+            counters[ActiveOpens] += tcp.dwActiveOpens;
+            counters[PassiveOpens] += tcp.dwPassiveOpens;
+            counters[AttemptFails] += tcp.dwAttemptFails;
+            counters[EstabResets] += tcp.dwEstabResets;
+            counters[InSegs] += tcp.dw64InSegs;
+            counters[OutSegs] += tcp.dw64OutSegs;
+            counters[RetransSegs] += tcp.dwRetransSegs;
+            counters[InErrs] += tcp.dwInErrs;
+            counters[OutRsts] += tcp.dwOutRsts;
+            counters[CurrEstab] += tcp.dwCurrEstab;
+            ok = true;
+        }
+        MIB_UDPSTATS2 udp{};
+        if (GetUdpStatisticsEx2(&udp, family) == NO_ERROR) {
+            counters[UdpInDatagrams] += udp.dw64InDatagrams;
+            counters[UdpNoPorts] += udp.dwNoPorts;
+            counters[UdpInErrors] += udp.dwInErrors;
+            counters[UdpOutDatagrams] += udp.dw64OutDatagrams;
+        }
+    }
+    return ok;
+}
+
+#else
+
+namespace {
+    // /proc/net/snmp 与 /proc/net/netstat 中需要的列
+    const char* const kTcpNames[] = { "ActiveOpens", "PassiveOpens", "AttemptFails", "EstabResets", "InSegs", "OutSegs", "RetransSegs", "InErrs", "OutRsts", "CurrEstab" };
+    const char* const kUdpNames[] = { "InDatagrams", "NoPorts", "InErrors", "OutDatagrams", "RcvbufErrors" };
+    const char* const kTcpExtNames[] = { "ListenOverflows", "ListenDrops" };
+
+    // 从文件首行开始按表头/数值两行一组查找
+    const char* FindRow(const char* p, const char* end, const char* prefix, size_t prefixLength) {
+        while (p < end) {
+            if (TextScan::StartsWith(p, end, prefix, prefixLength)) return p;
+            p = TextScan::NextLine(p, end);
+        }
+        return nullptr;
+    }
+}
+
+SocketStats::SocketStats() {
+    std::fill(std::begin(snmpColumns), std::end(snmpColumns), static_cast<int16_t>(-2));
+    std::fill(std::begin(netstatColumns), std::end(netstatColumns), static_cast<int16_t>(-2));
+    snmpFile.Open("/proc/net/snmp", 8192);
+    netstatFile.Open("/proc/net/netstat", 8192);
+
+    diagSocket = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (diagSocket >= 0) {
+        // 内核回应异常时不让采样线程无限阻塞
+        timeval timeout{ 1, 0 };
+        setsockopt(diagSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        receiveBuffer.resize(64 * 1024);
+    }
+    available = diagSocket >= 0 || snmpFile.IsOpen();
+}
+
+SocketStats::~SocketStats() {
+    if (diagSocket >= 0) close(diagSocket);
+}
+
+bool SocketStats::CollectSockets(bool scanProcesses, const uint64_t* currentEstablished) {
+    Summary& s = summary;
+    std::fill(std::begin(s.tcpStates), std::end(s.tcpStates), 0u);
+    s.tcpSockets = 0;
+    s.udpSockets = 0;
+    s.listenQueueFull = 0;
+    if (diagSocket < 0) return false;
+
+    // 进程扫描周期需要全部连接的 inode，做完整导出；其余周期由内核跳过 ESTABLISHED，不再逐个生成消息
+    bool skipEstablished = !scanProcesses && currentEstablished;
+    uint32_t tcpStateMask = skipEstablished ? ~(1u << (Established + 1)) : ~0u;
+    tcpInodes.clear();
+    udpInodes.clear();
+    // IPv6 被禁用或 udp_diag 模块未加载时对应导出返回错误，只要求 IPv4 TCP 成功
+    bool ok = DumpFamily(AF_INET, IPPROTO_TCP, tcpStateMask, scanProcesses);
+    DumpFamily(AF_INET6, IPPROTO_TCP, tcpStateMask, scanProcesses);
+    DumpFamily(AF_INET, IPPROTO_UDP, ~0u, scanProcesses);
+    DumpFamily(AF_INET6, IPPROTO_UDP, ~0u, scanProcesses);
+    if (ok && skipEstablished) {
+        uint64_t closeWait = s.tcpStates[CloseWait];
+        uint32_t established = static_cast<uint32_t>(*currentEstablished > closeWait ? *currentEstablished - closeWait : 0);
+        s.tcpStates[Established] = established;
+        s.tcpSockets += established;
+    }
+    if (ok && scanProcesses) ScanProcessDescriptors();
+    return ok;
+}
+
+bool SocketStats::DumpFamily(int family, int protocol, uint32_t states, bool collectInodes) {
+    struct {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message{};
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.header.nlmsg_seq = ++sequence;
+    message.request.sdiag_family = static_cast<uint8_t>(family);
+    message.request.sdiag_protocol = static_cast<uint8_t>(protocol);
+    message.request.idiag_states = states;
+
+    sockaddr_nl kernel{};
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(diagSocket, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0) return false;
+
+    Summary& s = summary;
+    for (;;) {
+        ssize_t received = recv(diagSocket, receiveBuffer.data(), receiveBuffer.size(), 0);
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (received == 0) return false;
+        int remaining = static_cast<int>(received);
+        for (auto* header = reinterpret_cast<nlmsghdr*>(receiveBuffer.data()); NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_seq != sequence) continue;
+            if (header->nlmsg_type == NLMSG_DONE) return true;
+            if (header->nlmsg_type == NLMSG_ERROR) return false;
+            if (header->nlmsg_type != SOCK_DIAG_BY_FAMILY) continue;
+            const auto* diag = static_cast<const inet_diag_msg*>(NLMSG_DATA(header));
+            if (protocol == IPPROTO_UDP) {
+                ++s.udpSockets;
+                if (collectInodes && diag->idiag_inode) udpInodes.push_back(diag->idiag_inode);
+                continue;
+            }
+            // 内核状态 1..11 与 TcpState 顺序一致，TCP_NEW_SYN_RECV(12) 归入 SynRecv
+            int state = diag->idiag_state == 12 ? SynRecv : static_cast<int>(diag->idiag_state) - 1;
+            if (state < 0 || state >= kTcpStateCount) continue;
+            ++s.tcpStates[state];
+            ++s.tcpSockets;
+            if (state == Listen) {
+                // 监听套接字的 rqueue 为当前接受队列长度，wqueue 为 backlog 上限
+                if (diag->idiag_wqueue > 0 && diag->idiag_rqueue >= diag->idiag_wqueue) ++s.listenQueueFull;
+            } else if (collectInodes && diag->idiag_inode) {
+                tcpInodes.push_back(diag->idiag_inode);
+            }
+        }
+    }
+}
+
+void SocketStats::ScanProcessDescriptors() {
+    processCounts.clear();
+    std::sort(tcpInodes.begin(), tcpInodes.end());
+    std::sort(udpInodes.begin(), udpInodes.end());
+
+    DIR* proc = opendir("/proc");
+    if (!proc) return;
+    char path[sizeof(dirent::d_name) + 16];
+    char link[64];
+    while (dirent* processEntry = readdir(proc)) {
+        if (!TextScan::IsDigit(processEntry->d_name[0])) continue;
+        snprintf(path, sizeof(path), "/proc/%s/fd", processEntry->d_name);
+        int directoryFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directoryFd < 0) continue;      // 进程已退出或无权限
+        DIR* descriptors = fdopendir(directoryFd);
+        if (!descriptors) {
+            close(directoryFd);
+            continue;
+        }
+        ProcessCounts counts;
+        while (dirent* fdEntry = readdir(descriptors)) {
+            if (fdEntry->d_name[0] == '.') continue;
+            ssize_t length = readlinkat(directoryFd, fdEntry->d_name, link, sizeof(link));
+            if (length <= 8 || memcmp(link, "socket:[", 8) != 0) continue;
+            const char* p = link + 8;
+            uint64_t inode = 0;
+            if (!TextScan::ParseU64(p, link + length, inode)) continue;
+            if (std::binary_search(tcpInodes.begin(), tcpInodes.end(), inode)) ++counts.tcp;
+            else if (std::binary_search(udpInodes.begin(), udpInodes.end(), inode)) ++counts.udp;
+        }
+        closedir(descriptors);
+        if (counts.tcp || counts.udp) {
+            processCounts[static_cast<uint32_t>(strtoul(processEntry->d_name, nullptr, 10))] = counts;
+        }
+    }
+    closedir(proc);
+}
+
+// 格式: "Tcp: 名称 名称 ...\nTcp: 数值 数值 ...\n"；列位置在首次读取时解析并缓存
+bool SocketStats::ParseCounterPairs(ProcFile& file, const char* prefix, size_t prefixLength,
+    const char* const* names, const int* ids, size_t count, int16_t* columns, uint64_t (&counters)[kCounterCount]) {
+    const char* end = file.End();
+    const char* header = FindRow(file.Data(), end, prefix, prefixLength);
+    if (!header) return false;
+    const char* values = TextScan::NextLine(header, end);
+    if (!TextScan::StartsWith(values, end, prefix, prefixLength)) return false;
+
+    if (columns[ids[0]] == -2) {
+        for (size_t i = 0; i < count; ++i) columns[ids[i]] = -1;
+        const char* headerEnd = TextScan::NextLine(header, end);
+        const char* p = header + prefixLength;
+        for (int16_t column = 0;; ++column) {
+            p = TextScan::SkipSpaces(p, headerEnd);
+            const char* token = p;
+            p = TextScan::SkipToken(p, headerEnd);
+            if (p == token) break;
+            for (size_t i = 0; i < count; ++i) {
+                size_t nameLength = strlen(names[i]);
+                if (static_cast<size_t>(p - token) == nameLength && memcmp(token, names[i], nameLength) == 0) columns[ids[i]] = column;
+            }
+        }
+    }
+
+    const char* valuesEnd = TextScan::NextLine(values, end);
+    const char* p = values + prefixLength;
+    for (int16_t column = 0; p < valuesEnd; ++column) {
+        p = TextScan::SkipSpaces(p, valuesEnd);
+        const char* token = p;
+        p = TextScan::SkipToken(p, valuesEnd);
+        if (p == token) break;
+        for (size_t i = 0; i < count; ++i) {
+            if (columns[ids[i]] != column) continue;
+            const char* q = token;
+            uint64_t value = 0;
+            if (TextScan::ParseU64(q, p, value)) counters[ids[i]] = value;
+        }
+    }
+    return true;
+}
+
+bool SocketStats::ReadProtocolCounters(uint64_t (&counters)[kCounterCount]) {
+    static const int kTcpIds[] = { ActiveOpens, PassiveOpens, AttemptFails, EstabResets, InSegs, OutSegs, RetransSegs, InErrs, OutRsts, CurrEstab };
+    static const int kUdpIds[] = { UdpInDatagrams, UdpNoPorts, UdpInErrors, UdpOutDatagrams, UdpRcvbufErrors };
+    static const int kTcpExtIds[] = { ListenOverflows, ListenDrops };
+
+    if (!snmpFile.Read()) return false;
+    bool ok = ParseCounterPairs(snmpFile, "Tcp:", 4, kTcpNames, kTcpIds, 10, snmpColumns, counters);
+    ParseCounterPairs(snmpFile, "Udp:", 4, kUdpNames, kUdpIds, 5, snmpColumns, counters);
+    if (netstatFile.Read()) {
+        ParseCounterPairs(netstatFile, "TcpExt:", 7, kTcpExtNames, kTcpExtIds, 2, netstatColumns, counters);
+    }
+    return ok;
+}
+
+#endif
@@ -0,0 +1,128 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// TCP/UDP 套接字与连接统计：按状态计数、监听队列溢出、重传速率、各进程连接数
+// 计数每个周期全量统计；进程归属开销较大，每 kProcessScanSeconds 秒统计一次并保留前 kTopProcesses 个进程，
+// 单次扫描耗时超过间隔的 1/kProcessScanBudget 时按耗时拉长间隔（数十万连接时扫描本身需要数百毫秒）
+// Windows: GetExtendedTcpTable/GetExtendedUdpTable（表中直接带 PID），协议计数来自 GetTcpStatisticsEx2/GetUdpStatisticsEx2；
+//          系统不提供监听队列溢出计数
+// Linux: NETLINK_SOCK_DIAG 批量导出（二进制 inet_diag_msg，不解析 /proc/net/tcp 文本），
+//        协议计数来自 /proc/net/snmp 与 /proc/net/netstat（表头列位置只解析一次）；
+//        ESTABLISHED 通常占绝大多数，非扫描周期导出时排除该状态，其数量由 snmp 的 CurrEstab（ESTABLISHED + CLOSE_WAIT）推算；
+//        进程归属通过 /proc/<pid>/fd 的 socket:[inode] 与导出结果中的 inode 对应
+class SocketStats {
+public:
+    // 状态顺序与 Linux 内核 TCP_ESTABLISHED..TCP_CLOSING 一致
+    enum TcpState {
+        Established, SynSent, SynRecv, FinWait1, FinWait2, TimeWait, Close, CloseWait, LastAck, Listen, Closing,
+        kTcpStateCount
+    };
+
+    struct Summary {
+        uint32_t tcpStates[kTcpStateCount] = {};
+        uint32_t tcpSockets = 0;
+        uint32_t udpSockets = 0;
+        uint32_t listenQueueFull = 0;   // 接受队列已满的监听套接字数（仅 Linux）
+        double retransSegsPerSec = 0.0;
+        double retransPercent = 0.0;    // 重传段占发送段的百分比
+        double listenOverflowsPerSec = 0.0;
+        double listenDropsPerSec = 0.0;
+        double activeOpensPerSec = 0.0;
+        double passiveOpensPerSec = 0.0;
+        double attemptFailsPerSec = 0.0;
+        double estabResetsPerSec = 0.0;
+        double tcpInErrorsPerSec = 0.0;
+        double tcpOutResetsPerSec = 0.0;
+        double udpInDatagramsPerSec = 0.0;
+        double udpOutDatagramsPerSec = 0.0;
+        double udpNoPortsPerSec = 0.0;
+        double udpInErrorsPerSec = 0.0;
+        double udpReceiveBufferErrorsPerSec = 0.0;
+        bool socketsValid = false;      // 套接字计数是否成功
+        bool protocolValid = false;     // 协议计数速率是否可用（需两次采样）
+    };
+
+    struct ProcessConnections {
+        uint32_t pid = 0;
+        uint32_t tcpConnections = 0;    // 非监听 TCP 套接字
+        uint32_t udpSockets = 0;
+        std::string name;               // UTF-8
+    };
+
+    static constexpr uint64_t kProcessScanSeconds = 10;
+    static constexpr uint64_t kProcessScanBudget = 50;
+    static constexpr size_t kTopProcesses = 8;
+
+    SocketStats();
+    ~SocketStats();
+
+    SocketStats(const SocketStats&) = delete;
+    SocketStats& operator=(const SocketStats&) = delete;
+
+    bool Update();
+
+    const Summary& GetSummary() const { return summary; }
+    // 按连接数降序
+    const std::vector<ProcessConnections>& GetTopProcesses() const { return topProcesses; }
+    bool IsAvailable() const { return available; }
+
+private:
+    // 协议计数下标，与 previousCounters 对应
+    enum Counter {
+        ActiveOpens, PassiveOpens, AttemptFails, EstabResets, InSegs, OutSegs, RetransSegs, InErrs, OutRsts,
+        UdpInDatagrams, UdpNoPorts, UdpInErrors, UdpOutDatagrams, UdpRcvbufErrors,
+        ListenOverflows, ListenDrops,
+        CurrEstab,                      // 瞬时值，不计算速率
+        kCounterCount
+    };
+
+    struct ProcessCounts {
+        uint32_t tcp = 0;
+        uint32_t udp = 0;
+    };
+
+    bool CollectSockets(bool scanProcesses, const uint64_t* currentEstablished);
+    bool ReadProtocolCounters(uint64_t (&counters)[kCounterCount]);
+    void ApplyCounters(const uint64_t (&counters)[kCounterCount], uint64_t elapsedNs);
+    void SelectTopProcesses();
+
+    Summary summary;
+    std::vector<ProcessConnections> topProcesses;
+    std::unordered_map<uint32_t, ProcessCounts> processCounts;     // 复用桶，只在进程扫描周期填充
+    uint64_t previousCounters[kCounterCount] = {};
+    uint64_t lastSampleNs = 0;
+    uint64_t lastProcessScanNs = 0;
+    uint64_t processScanIntervalNs = kProcessScanSeconds * 1000000000ULL;
+    bool hasBaseline = false;
+    bool available = false;
+
+#ifdef _WIN32
+    std::vector<BYTE> tableBuffer;      // GetExtended*Table 缓冲区，只增不减
+#else
+    // states 为内核 TCP 状态位掩码（1 << state）
+    bool DumpFamily(int family, int protocol, uint32_t states, bool collectInodes);
+    void ScanProcessDescriptors();
+    static bool ParseCounterPairs(ProcFile& file, const char* prefix, size_t prefixLength,
+        const char* const* names, const int* ids, size_t count, int16_t* columns, uint64_t (&counters)[kCounterCount]);
+
+    int diagSocket = -1;
+    uint32_t sequence = 0;
+    std::vector<char> receiveBuffer;
+    std::vector<uint64_t> tcpInodes;    // 进程扫描周期：非监听 TCP 套接字 inode（排序后二分查找）
+    std::vector<uint64_t> udpInodes;
+    ProcFile snmpFile;
+    ProcFile netstatFile;
+    int16_t snmpColumns[kCounterCount];     // 各计数在表头中的列号，-1 表示未找到
+    int16_t netstatColumns[kCounterCount];
+#endif
+};
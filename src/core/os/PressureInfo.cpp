@@ -0,0 +1,216 @@
+﻿#include "PressureInfo.h"
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef _WIN32
+#include "../Utils/Logger.h"
+#include <pdhmsg.h>
+#pragma comment(lib, "pdh.lib")
+#endif
+
+namespace {
+    // 内存压力预警阈值：some avg10 超过进入值时告警，回落到退出值以下才解除，避免在阈值附近抖动
+    constexpr double kMemoryWarningEnter = 10.0;
+    constexpr double kMemoryWarningLeave = 5.0;
+}
+
+PressureInfo::PressureInfo() {
+#ifdef _WIN32
+    available = InitializeCounters();
+#else
+    // 内核未启用 PSI（CONFIG_PSI=n 或 psi=0）时文件不存在，对应资源保持不可用
+    bool cpuOk = cpuFile.Open("/proc/pressure/cpu", 256);
+    bool memoryOk = memoryFile.Open("/proc/pressure/memory", 256);
+    bool ioOk = ioFile.Open("/proc/pressure/io", 256);
+    available = cpuOk || memoryOk || ioOk;
+#endif
+}
+
+PressureInfo::~PressureInfo() {
+#ifdef _WIN32
+    CleanupCounters();
+#endif
+}
+
+void PressureInfo::UpdateMemoryWarning() {
+    const Resource& memory = snapshot.memory;
+    if (!memory.available) {
+        snapshot.memoryPressureWarning = false;
+        return;
+    }
+    double level = (std::max)(memory.someAvg10, memory.someStallPercent);
+    if (snapshot.memoryPressureWarning) {
+        snapshot.memoryPressureWarning = level >= kMemoryWarningLeave;
+    } else {
+        snapshot.memoryPressureWarning = level >= kMemoryWarningEnter;
+    }
+}
+
+#ifdef _WIN32
+
+bool PressureInfo::InitializeCounters() {
+    SYSTEM_INFO systemInfo{};
+    GetSystemInfo(&systemInfo);
+    logicalProcessors = (std::max)(systemInfo.dwNumberOfProcessors, static_cast<DWORD>(1));
+
+    if (PdhOpenQuery(NULL, 0, &query) != ERROR_SUCCESS) {
+        Logger::Warn("压力信息: 无法打开性能计数器查询");
+        query = nullptr;
+        return false;
+    }
+    // 使用英文计数器名称以避免本地化问题
+    PdhAddEnglishCounterW(query, L"\\System\\Processor Queue Length", 0, &queueLengthCounter);
+    PdhAddEnglishCounterW(query, L"\\PhysicalDisk(_Total)\\% Idle Time", 0, &diskIdleCounter);
+    PdhAddEnglishCounterW(query, L"\\Memory\\Page Reads/sec", 0, &pageReadsCounter);
+    PdhAddEnglishCounterW(query, L"\\PhysicalDisk(_Total)\\Avg. Disk sec/Read", 0, &diskReadLatencyCounter);
+    if (PdhCollectQueryData(query) != ERROR_SUCCESS) {
+        Logger::Warn("压力信息: 无法收集性能计数器基线数据");
+        CleanupCounters();
+        return false;
+    }
+    lastSampleNs = CounterMath::MonotonicNowNs();
+    return true;
+}
+
+void PressureInfo::CleanupCounters() {
+    if (query) {
+        PdhCloseQuery(query);
+        query = nullptr;
+    }
+}
+
+// 按内核 PSI 相同的指数衰减方式由每周期阻塞占比推算 10/60 秒均值
+void PressureInfo::UpdateAverages(Resource& resource, double somePercent, double elapsedSeconds, bool first) {
+    resource.someStallPercent = somePercent;
+    if (first) {
+        resource.someAvg10 = resource.someAvg60 = somePercent;
+        return;
+    }
+    double e10 = std::exp(-elapsedSeconds / 10.0);
+    double e60 = std::exp(-elapsedSeconds / 60.0);
+    resource.someAvg10 = resource.someAvg10 * e10 + somePercent * (1.0 - e10);
+    resource.someAvg60 = resource.someAvg60 * e60 + somePercent * (1.0 - e60);
+}
+
+// Windows 近似：
+//   CPU    : 运行队列中等待的线程数 / 逻辑处理器数，封顶100%（有线程排队即视为存在 CPU 争用）
+//   I/O    : 100 - 物理磁盘空闲时间占比，即至少有一个 I/O 未完成的时间占比
+//   内存   : 硬缺页读次数 × 平均读延迟，即每秒因缺页等待磁盘的时间，封顶100%
+// Windows 没有 full 语义的等价数据，full 字段保持为0
+bool PressureInfo::Update() {
+    if (!available || !query) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    if (PdhCollectQueryData(query) != ERROR_SUCCESS) return false;
+    double elapsedSeconds = (now - lastSampleNs) / 1e9;
+    lastSampleNs = now;
+
+    auto readDouble = [](PDH_HCOUNTER counter, double& out) {
+        if (!counter) return false;
+        PDH_FMT_COUNTERVALUE value;
+        if (PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, NULL, &value) != ERROR_SUCCESS) return false;
+        if (value.CStatus != PDH_CSTATUS_VALID_DATA && value.CStatus != PDH_CSTATUS_NEW_DATA) return false;
+        out = (std::max)(value.doubleValue, 0.0);
+        return true;
+    };
+    auto clampPercent = [](double v) { return (std::min)((std::max)(v, 0.0), 100.0); };
+    bool first = !hasBaseline;
+
+    double queueLength = 0.0;
+    if (readDouble(queueLengthCounter, queueLength)) {
+        snapshot.cpu.available = snapshot.cpu.estimated = true;
+        UpdateAverages(snapshot.cpu, clampPercent(queueLength * 100.0 / logicalProcessors), elapsedSeconds, first);
+    }
+
+    double idle = 0.0;
+    if (readDouble(diskIdleCounter, idle)) {
+        snapshot.io.available = snapshot.io.estimated = true;
+        UpdateAverages(snapshot.io, clampPercent(100.0 - idle), elapsedSeconds, first);
+    }
+
+    double pageReads = 0.0, readLatency = 0.0;
+    if (readDouble(pageReadsCounter, pageReads) && readDouble(diskReadLatencyCounter, readLatency)) {
+        snapshot.memory.available = snapshot.memory.estimated = true;
+        UpdateAverages(snapshot.memory, clampPercent(pageReads * readLatency * 100.0), elapsedSeconds, first);
+    }
+
+    UpdateMemoryWarning();
+    hasBaseline = true;
+    return true;
+}
+
+#else
+
+// 解析一个 PSI 文件：
+//   some avg10=0.12 avg60=0.05 avg300=0.01 total=123456
+//   full avg10=0.00 avg60=0.00 avg300=0.00 total=7890
+// 旧内核的 cpu 文件没有 full 行，对应字段保持为0
+bool PressureInfo::ReadResource(ProcFile& file, Resource& resource, uint64_t elapsedNs) {
+    if (!file.IsOpen() || !file.Read()) {
+        resource.available = false;
+        return false;
+    }
+
+    const char* p = file.Data();
+    const char* end = file.End();
+    while (p < end) {
+        const char* line = p;
+        p = TextScan::NextLine(p, end);
+
+        bool isSome = TextScan::StartsWith(line, p, "some ", 5);
+        if (!isSome && !TextScan::StartsWith(line, p, "full ", 5)) continue;
+
+        double avg10 = 0.0, avg60 = 0.0;
+        uint64_t total = 0;
+        bool hasTotal = false;
+        const char* lineEnd = (p > line && p[-1] == '\n') ? p - 1 : p;
+        const char* q = TextScan::SkipSpaces(line + 5, lineEnd);
+        while (q < lineEnd) {
+            if (TextScan::StartsWith(q, lineEnd, "avg10=", 6)) {
+                q += 6;
+                TextScan::ParseFixed(q, lineEnd, avg10);
+            } else if (TextScan::StartsWith(q, lineEnd, "avg60=", 6)) {
+                q += 6;
+                TextScan::ParseFixed(q, lineEnd, avg60);
+            } else if (TextScan::StartsWith(q, lineEnd, "total=", 6)) {
+                q += 6;
+                hasTotal = TextScan::ParseU64(q, lineEnd, total);
+            }
+            q = TextScan::SkipSpaces(TextScan::SkipToken(q, lineEnd), lineEnd);
+        }
+
+        uint64_t& prevTotal = isSome ? resource.someTotalUs : resource.fullTotalUs;
+        double& stallPercent = isSome ? resource.someStallPercent : resource.fullStallPercent;
+        if (hasTotal) {
+            // total 为微秒，elapsedNs / 1000 为本周期的微秒数
+            if (hasBaseline && elapsedNs > 0) {
+                double stalledUs = static_cast<double>(CounterMath::Delta(prevTotal, total));
+                stallPercent = (std::min)(stalledUs * 1000.0 * 100.0 / static_cast<double>(elapsedNs), 100.0);
+            }
+            prevTotal = total;
+        }
+        (isSome ? resource.someAvg10 : resource.fullAvg10) = avg10;
+        (isSome ? resource.someAvg60 : resource.fullAvg60) = avg60;
+    }
+    resource.available = true;
+    return true;
+}
+
+bool PressureInfo::Update() {
+    if (!available) return false;
+
+    uint64_t now = CounterMath::MonotonicNowNs();
+    uint64_t elapsedNs = now - lastSampleNs;
+    bool ok = ReadResource(cpuFile, snapshot.cpu, elapsedNs);
+    ok = ReadResource(memoryFile, snapshot.memory, elapsedNs) || ok;
+    ok = ReadResource(ioFile, snapshot.io, elapsedNs) || ok;
+    lastSampleNs = now;
+    hasBaseline = true;
+
+    UpdateMemoryWarning();
+    return ok;
+}
+
+#endif
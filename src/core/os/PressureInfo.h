@@ -0,0 +1,74 @@
+﻿#pragma once
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <pdh.h>
+#else
+#include "../Utils/ProcFile.h"
+#endif
+
+// 压力阻塞信息（PSI）
+// 阻塞时间在使用率饱和之前就能反映资源争用，用于容量规划和内存压力预警
+// Linux: /proc/pressure/{cpu,memory,io}，avg10/avg60 取内核值，阻塞率由 total（微秒）的相邻差值计算
+// Windows: 无 PSI，用性能计数器近似（见 PressureInfo.cpp），结果带 estimated 标记
+class PressureInfo {
+public:
+    struct Resource {
+        bool available = false;          // 该资源是否有数据
+        bool estimated = false;          // 是否为 Windows 计数器近似值
+        double someAvg10 = 0.0;          // 至少一个任务阻塞的时间占比（%），10秒均值
+        double someAvg60 = 0.0;          // 同上，60秒均值
+        double fullAvg10 = 0.0;          // 所有非空闲任务同时阻塞的时间占比（%），10秒均值
+        double fullAvg60 = 0.0;          // 同上，60秒均值
+        double someStallPercent = 0.0;   // 本采样周期内 some 阻塞占比（%）
+        double fullStallPercent = 0.0;   // 本采样周期内 full 阻塞占比（%）
+        uint64_t someTotalUs = 0;        // 累计 some 阻塞时间（微秒）
+        uint64_t fullTotalUs = 0;        // 累计 full 阻塞时间（微秒）
+    };
+
+    struct Snapshot {
+        Resource cpu;
+        Resource memory;
+        Resource io;
+        bool memoryPressureWarning = false;  // 内存压力预警（带滞回，见 UpdateMemoryWarning）
+    };
+
+    PressureInfo();
+    ~PressureInfo();
+
+    PressureInfo(const PressureInfo&) = delete;
+    PressureInfo& operator=(const PressureInfo&) = delete;
+
+    // 采样一次；首次调用只建立阻塞率基线
+    bool Update();
+    const Snapshot& GetSnapshot() const { return snapshot; }
+    bool IsAvailable() const { return available; }
+
+private:
+    void UpdateMemoryWarning();
+
+    Snapshot snapshot;
+    bool available = false;
+    bool hasBaseline = false;
+    uint64_t lastSampleNs = 0;
+
+#ifdef _WIN32
+    bool InitializeCounters();
+    void CleanupCounters();
+    static void UpdateAverages(Resource& resource, double somePercent, double elapsedSeconds, bool first);
+
+    PDH_HQUERY query = nullptr;
+    PDH_HCOUNTER queueLengthCounter = nullptr;   // \System\Processor Queue Length
+    PDH_HCOUNTER diskIdleCounter = nullptr;      // \PhysicalDisk(_Total)\% Idle Time
+    PDH_HCOUNTER pageReadsCounter = nullptr;     // \Memory\Page Reads/sec
+    PDH_HCOUNTER diskReadLatencyCounter = nullptr; // \PhysicalDisk(_Total)\Avg. Disk sec/Read
+    DWORD logicalProcessors = 1;
+#else
+    bool ReadResource(ProcFile& file, Resource& resource, uint64_t elapsedNs);
+
+    ProcFile cpuFile;
+    ProcFile memoryFile;
+    ProcFile ioFile;
+#endif
+};
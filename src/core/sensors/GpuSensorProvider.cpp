@@ -0,0 +1,44 @@
+﻿#include "GpuSensorProvider.h"
+#include "../gpu/GpuService.h"
+#include "../Utils/WinUtils.h"
+#include <limits>
+#include <string>
+
+GpuSensorProvider::GpuSensorProvider(const GpuService& gpuService) : service(gpuService) {}
+
+void GpuSensorProvider::Register(SensorRegistry& registry) {
+    const auto& gpus = service.GetGpus();
+    for (size_t i = 0; i < gpus.size(); ++i) {
+        // 没有 NVML 数据的 GPU（虚拟显卡、非 NVIDIA）不提供动态读数
+        if (gpus[i].isVirtual || gpus[i].nvmlIndex < 0) continue;
+        // 同型号的多块 GPU 按 NVML 序号区分，否则会合并为同一硬件
+        uint16_t hardware = registry.AddHardware(WinUtils::WstringToUtf8(gpus[i].name) + " (GPU " + std::to_string(gpus[i].nvmlIndex) + ")",
+            HardwareCategory::Gpu);
+        Entry entry;
+        entry.gpu = i;
+        entry.hardware = hardware;
+        entry.temperature = registry.AddSensor(hardware, SensorKind::Temperature, "GPU Core", static_cast<int>(i) == service.GetPrimaryIndex());
+        entry.clock = registry.AddSensor(hardware, SensorKind::Clock, "GPU Core");
+        entry.load = registry.AddSensor(hardware, SensorKind::Load, "GPU Core");
+        entry.power = registry.AddSensor(hardware, SensorKind::Power, "GPU Package");
+        entries.push_back(entry);
+    }
+}
+
+bool GpuSensorProvider::Sample(const SensorSampleContext& context) {
+    const auto& dynamic = service.GetDynamic();
+    const double unavailable = std::numeric_limits<double>::quiet_NaN();
+    double* values = context.values;
+    const uint8_t* due = context.sensorDue;
+    bool any = false;
+    for (const Entry& entry : entries) {
+        if (!context.hardwareDue[entry.hardware]) continue;
+        const GpuService::Dynamic& data = dynamic[entry.gpu];
+        if (due[entry.temperature]) values[entry.temperature] = data.valid ? data.temperature : unavailable;
+        if (due[entry.clock]) values[entry.clock] = data.valid ? data.coreClockMHz : unavailable;
+        if (due[entry.load]) values[entry.load] = data.valid ? data.utilization : unavailable;
+        if (due[entry.power]) values[entry.power] = data.valid ? data.powerWatts : unavailable;
+        any = any || data.valid;
+    }
+    return any;
+}
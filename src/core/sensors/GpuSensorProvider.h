@@ -0,0 +1,30 @@
+﻿#pragma once
+#include <vector>
+#include "SensorRegistry.h"
+
+class GpuService;
+
+// 把 GpuService 的动态数据登记为传感器：每个由 NVML 管理的非虚拟 GPU 提供温度、核心频率、利用率与功耗
+// 不自行查询驱动，Sample() 只读取 GpuService 按其周期刷新的紧凑数组；GpuService 由调用方持有且须比本对象存活更久
+class GpuSensorProvider : public ISensorProvider {
+public:
+    explicit GpuSensorProvider(const GpuService& service);
+
+    const char* Name() const override { return "GpuService"; }
+    void Register(SensorRegistry& registry) override;
+    bool Sample(const SensorSampleContext& context) override;
+    bool IsAvailable() const override { return !entries.empty(); }
+
+private:
+    struct Entry {
+        size_t gpu = 0;             // GpuService::GetGpus() 下标
+        uint16_t hardware = 0;
+        SensorId temperature = SensorRegistry::kInvalidSensor;
+        SensorId clock = SensorRegistry::kInvalidSensor;
+        SensorId load = SensorRegistry::kInvalidSensor;
+        SensorId power = SensorRegistry::kInvalidSensor;
+    };
+
+    const GpuService& service;
+    std::vector<Entry> entries;
+};
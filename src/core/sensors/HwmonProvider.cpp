@@ -0,0 +1,189 @@
+﻿#include "HwmonProvider.h"
+
+#ifndef _WIN32
+#include "../Utils/TextScan.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <limits>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+HwmonProvider::HwmonProvider(const std::string& sysfsRoot) : root(sysfsRoot) {}
+
+void HwmonProvider::Register(SensorRegistry&) {}
+
+bool HwmonProvider::Sample(const SensorSampleContext&) {
+    return false;
+}
+
+#else
+
+namespace {
+    // 按驱动名（hwmon name 或 thermal zone type）判断硬件类别
+    const char* const kCpuChips[] = { "coretemp", "k10temp", "zenpower", "x86_pkg_temp", "cpu_thermal", "cpu-thermal" };
+    const char* const kGpuChips[] = { "amdgpu", "radeon", "nouveau", "i915", "xe" };
+    const char* const kStorageChips[] = { "nvme", "drivetemp" };
+    const char* const kBoardChips[] = { "acpitz", "nct6775", "nct6683", "nct6687", "it87", "pch_cannonlake", "pch_skylake" };
+
+    template <size_t N>
+    bool Contains(const char* const (&names)[N], const std::string& chip) {
+        for (const char* name : names) {
+            if (chip == name) return true;
+        }
+        return false;
+    }
+
+    HardwareCategory CategoryOf(const std::string& chip) {
+        if (Contains(kCpuChips, chip)) return HardwareCategory::Cpu;
+        if (Contains(kGpuChips, chip)) return HardwareCategory::Gpu;
+        if (Contains(kStorageChips, chip)) return HardwareCategory::Storage;
+        if (Contains(kBoardChips, chip)) return HardwareCategory::Motherboard;
+        return HardwareCategory::Other;
+    }
+
+    // 代表 CPU 整体温度的读数：Intel 的 Package、AMD 的 Tctl/Tdie
+    bool IsPrimaryLabel(const std::string& label) {
+        return label.compare(0, 7, "Package") == 0 || label == "Tctl" || label == "Tdie";
+    }
+
+    // hwmon sysfs 接口的输入文件：前缀 + 序号 + 后缀，原始值按 scale 换算为注册表单位
+    struct InputType {
+        const char* prefix;
+        const char* suffix;
+        SensorKind kind;
+        double scale;
+    };
+
+    const InputType kInputTypes[] = {
+        { "temp", "_input", SensorKind::Temperature, 0.001 },     // 毫摄氏度
+        { "fan", "_input", SensorKind::Fan, 1.0 },                // RPM
+        { "pwm", "", SensorKind::Control, 100.0 / 255.0 },        // 占空比 0-255
+        { "in", "_input", SensorKind::Voltage, 0.001 },           // 毫伏
+        { "power", "_input", SensorKind::Power, 0.000001 },       // 微瓦，瞬时值
+        { "power", "_average", SensorKind::Power, 0.000001 },     // 微瓦，驱动只提供平均值时使用（amdgpu）
+    };
+
+    std::string ReadLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        while (!line.empty() && (line.back() == '\n' || line.back() == ' ')) line.pop_back();
+        return line;
+    }
+
+    // 目录中以 prefix 开头、后接序号与 suffix 的条目，按序号排序（hwmon10 排在 hwmon9 之后）
+    std::vector<std::pair<unsigned long, std::string>> ListNumbered(const std::string& directory, const char* prefix, const char* suffix) {
+        std::vector<std::pair<unsigned long, std::string>> entries;
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) return entries;
+        size_t prefixLength = strlen(prefix);
+        size_t suffixLength = strlen(suffix);
+        while (dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            size_t length = strlen(name);
+            if (length <= prefixLength + suffixLength || strncmp(name, prefix, prefixLength) != 0) continue;
+            if (strcmp(name + length - suffixLength, suffix) != 0) continue;
+            char* digitsEnd = nullptr;
+            unsigned long index = strtoul(name + prefixLength, &digitsEnd, 10);
+            if (digitsEnd != name + length - suffixLength || digitsEnd == name + prefixLength) continue;
+            entries.emplace_back(index, name);
+        }
+        closedir(dir);
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+}
+
+HwmonProvider::HwmonProvider(const std::string& sysfsRoot) : root(sysfsRoot) {}
+
+void HwmonProvider::Register(SensorRegistry& registry) {
+    RegisterHwmon(registry, root + "/hwmon");
+    RegisterThermalZones(registry, root + "/thermal");
+}
+
+void HwmonProvider::AddInput(SensorRegistry& registry, const std::string& path, uint16_t hardware, SensorKind kind,
+    const std::string& label, double scale, bool primary) {
+    ProcFile file;
+    if (!file.Open(path, 32)) return;
+    ids.push_back(registry.AddSensor(hardware, kind, label, primary));
+    inputs.push_back(std::move(file));
+    scales.push_back(scale);
+}
+
+void HwmonProvider::RegisterHwmon(SensorRegistry& registry, const std::string& directory) {
+    for (const auto& device : ListNumbered(directory, "hwmon", "")) {
+        const std::string base = directory + "/" + device.second;
+        std::string chip = ReadLine(base + "/name");
+        if (chip.empty()) chip = device.second;
+        HardwareCategory category = CategoryOf(chip);
+        // 同名芯片（多路 CPU、多块 NVMe）按 hwmon 序号区分；没有任何输入的设备不登记
+        const std::string hardwareName = chip + " (" + device.second + ")";
+        bool registered = false;
+        uint16_t hardware = 0;
+        for (const InputType& type : kInputTypes) {
+            for (const auto& input : ListNumbered(base, type.prefix, type.suffix)) {
+                const std::string prefix = base + "/" + type.prefix + std::to_string(input.first);
+                // 同一路功耗同时有瞬时值与平均值时只取瞬时值
+                if (type.kind == SensorKind::Power && strcmp(type.suffix, "_average") == 0 &&
+                    access((prefix + "_input").c_str(), F_OK) == 0) continue;
+                if (!registered) {
+                    hardware = registry.AddHardware(hardwareName, category);
+                    registered = true;
+                }
+                std::string label = ReadLine(prefix + "_label");
+                if (label.empty()) label = type.prefix + std::to_string(input.first);
+                bool primary = type.kind == SensorKind::Temperature && category == HardwareCategory::Cpu && IsPrimaryLabel(label);
+                AddInput(registry, base + "/" + input.second, hardware, type.kind, label, type.scale, primary);
+            }
+        }
+    }
+}
+
+void HwmonProvider::RegisterThermalZones(SensorRegistry& registry, const std::string& directory) {
+    for (const auto& zone : ListNumbered(directory, "thermal_zone", "")) {
+        const std::string base = directory + "/" + zone.second;
+        // 注册了 hwmon 的 zone 会在其下出现 hwmonN 目录，读数已由 hwmon 提供
+        DIR* dir = opendir(base.c_str());
+        if (!dir) continue;
+        bool hasHwmon = false;
+        while (dirent* entry = readdir(dir)) {
+            if (strncmp(entry->d_name, "hwmon", 5) == 0) {
+                hasHwmon = true;
+                break;
+            }
+        }
+        closedir(dir);
+        if (hasHwmon) continue;
+
+        std::string type = ReadLine(base + "/type");
+        if (type.empty()) type = zone.second;
+        uint16_t hardware = registry.AddHardware(type + " (" + zone.second + ")", CategoryOf(type));
+        AddInput(registry, base + "/temp", hardware, SensorKind::Temperature, type, 0.001, type == "x86_pkg_temp");
+    }
+}
+
+bool HwmonProvider::Sample(const SensorSampleContext& context) {
+    double* values = context.values;
+    bool any = false;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (!context.sensorDue[ids[i]]) continue;
+        ProcFile& input = inputs[i];
+        int64_t raw = 0;
+        // 传感器离线时 read 返回 ENODATA/EIO
+        const char* p = input.Read() ? input.Data() : nullptr;
+        if (p && TextScan::ParseI64(p, input.End(), raw)) {
+            values[ids[i]] = static_cast<double>(raw) * scales[i];
+            any = true;
+        } else {
+            values[ids[i]] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    return any;
+}
+
+#endif
@@ -0,0 +1,40 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include "SensorRegistry.h"
+
+#ifndef _WIN32
+#include "../Utils/ProcFile.h"
+#endif
+
+// Linux 原生传感器：/sys/class/hwmon/hwmon* 下的温度、风扇转速与占空比、电压、功耗，以及 /sys/class/thermal/thermal_zone*/temp
+// Register() 时枚举一次并为每个传感器保持文件常驻打开，Sample() 只用 pread 重新读取到期的传感器（ProcFile），稳定运行后不再分配内存
+// 已注册 hwmon 的 thermal zone 跳过，避免同一传感器出现两次；硬件类别按驱动名判断（coretemp/k10temp 为 CPU，nvme 为存储等）
+// Windows 下没有对应接口，IsAvailable() 始终为 false
+class HwmonProvider : public ISensorProvider {
+public:
+    // sysfsRoot 指向其他目录时可在没有传感器的机器上用模拟目录测试
+    explicit HwmonProvider(const std::string& sysfsRoot = "/sys/class");
+
+    HwmonProvider(const HwmonProvider&) = delete;
+    HwmonProvider& operator=(const HwmonProvider&) = delete;
+
+    const char* Name() const override { return "hwmon"; }
+    void Register(SensorRegistry& registry) override;
+    bool Sample(const SensorSampleContext& context) override;
+    bool IsAvailable() const override { return !ids.empty(); }
+
+private:
+    std::string root;
+    std::vector<SensorId> ids;
+
+#ifndef _WIN32
+    void RegisterHwmon(SensorRegistry& registry, const std::string& directory);
+    void RegisterThermalZones(SensorRegistry& registry, const std::string& directory);
+    void AddInput(SensorRegistry& registry, const std::string& path, uint16_t hardware, SensorKind kind,
+        const std::string& label, double scale, bool primary);
+
+    std::vector<ProcFile> inputs;       // 与 ids 一一对应，内容为整数（毫摄氏度、RPM、0-255、毫伏、微瓦）
+    std::vector<double> scales;         // 与 ids 一一对应，原始值乘以该系数得到注册表单位
+#endif
+};
@@ -0,0 +1,25 @@
+﻿#pragma once
+#include <cstdint>
+
+class SensorRegistry;
+
+// 一次采样的输入与输出，数组由注册表按订阅维护
+struct SensorSampleContext {
+    double* values = nullptr;               // 按传感器 ID，原始读数，注册表随后按死区过滤
+    const uint8_t* sensorDue = nullptr;     // 按传感器 ID，非 0 表示本周期需要读取
+    const uint8_t* hardwareDue = nullptr;   // 按硬件下标，其下至少一个传感器需要读取
+};
+
+// 传感器提供者接口
+// Register() 在加入注册表时调用一次：枚举传感器、登记描述并记下分配到的 ID，读取句柄保持常驻；
+// Sample() 只在提供者有传感器到期时调用，只读取到期的传感器并写入 values[id]（读取失败写 NaN），
+// 未到期的读数保持不变；按硬件节点整体刷新的来源（Libre）只刷新 hardwareDue 标记的节点
+class ISensorProvider {
+public:
+    virtual ~ISensorProvider() = default;
+
+    virtual const char* Name() const = 0;
+    virtual void Register(SensorRegistry& registry) = 0;
+    virtual bool Sample(const SensorSampleContext& context) = 0;
+    virtual bool IsAvailable() const = 0;
+};
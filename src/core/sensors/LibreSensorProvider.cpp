@@ -0,0 +1,78 @@
+﻿#include "LibreSensorProvider.h"
+#include "../Utils/Logger.h"
+#include <cmath>
+#include <limits>
+// 以托管代码模式调用 LibreHardwareMonitorBridge
+#pragma managed
+#include "../Utils/LibreHardwareMonitorBridge.h"
+
+LibreSensorProvider::LibreSensorProvider() {
+    LibreHardwareMonitorBridge::Initialize();
+}
+
+LibreSensorProvider::~LibreSensorProvider() {
+    try {
+        LibreHardwareMonitorBridge::Cleanup();
+    }
+    catch (...) {
+        Logger::Warn("LibreHardwareMonitor 清理异常");
+    }
+}
+
+namespace {
+    SensorKind KindOf(LibreHardwareMonitorBridge::Kind kind) {
+        switch (kind) {
+        case LibreHardwareMonitorBridge::Kind::Fan: return SensorKind::Fan;
+        case LibreHardwareMonitorBridge::Kind::Voltage: return SensorKind::Voltage;
+        case LibreHardwareMonitorBridge::Kind::Power: return SensorKind::Power;
+        case LibreHardwareMonitorBridge::Kind::Control: return SensorKind::Control;
+        default: return SensorKind::Temperature;
+        }
+    }
+
+    HardwareCategory CategoryOf(LibreHardwareMonitorBridge::Device device) {
+        switch (device) {
+        case LibreHardwareMonitorBridge::Device::Cpu: return HardwareCategory::Cpu;
+        case LibreHardwareMonitorBridge::Device::Gpu: return HardwareCategory::Gpu;
+        default: return HardwareCategory::Motherboard;
+        }
+    }
+}
+
+void LibreSensorProvider::Register(SensorRegistry& registry) {
+    // 枚举结果按硬件下标排列，同一节点的传感器相邻
+    for (const auto& entry : LibreHardwareMonitorBridge::EnumerateSensors()) {
+        if (nodes.empty() || nodes.back().libreHardware != entry.hardware) {
+            Node node;
+            node.libreHardware = entry.hardware;
+            node.hardware = registry.AddHardware(entry.hardwareName, CategoryOf(entry.device));
+            node.first = ids.size();
+            nodes.push_back(node);
+        }
+        const std::string& name = entry.name;
+        SensorKind kind = KindOf(entry.kind);
+        // CPU 温度取 Package/Tctl，CPU 功耗取 Package
+        bool primary = entry.device == LibreHardwareMonitorBridge::Device::Cpu &&
+            ((kind == SensorKind::Temperature && (name.find("Package") != std::string::npos || name.find("Tctl") != std::string::npos)) ||
+             (kind == SensorKind::Power && name.find("Package") != std::string::npos));
+        ids.push_back(registry.AddSensor(nodes.back().hardware, kind, name, primary));
+        libreSensors.push_back(entry.sensor);
+        nodes.back().end = ids.size();
+    }
+}
+
+bool LibreSensorProvider::Sample(const SensorSampleContext& context) {
+    bool any = false;
+    for (const Node& node : nodes) {
+        if (!context.hardwareDue[node.hardware]) continue;
+        bool updated = LibreHardwareMonitorBridge::UpdateHardware(node.libreHardware);
+        for (size_t i = node.first; i < node.end; ++i) {
+            if (!context.sensorDue[ids[i]]) continue;
+            double value = updated ? LibreHardwareMonitorBridge::ReadSensor(node.libreHardware, libreSensors[i])
+                                   : std::numeric_limits<double>::quiet_NaN();
+            context.values[ids[i]] = value;
+            any = any || !std::isnan(value);
+        }
+    }
+    return any;
+}
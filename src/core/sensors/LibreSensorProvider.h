@@ -0,0 +1,38 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include "SensorRegistry.h"
+
+// LibreHardwareMonitor（C++/CLI 桥接）兼容提供者，只在定义 TCMT_WITH_LIBRE 时使用
+// 提供 CPU/GPU/主板（Super I/O）的温度、风扇转速与占空比、电压和功耗
+// 会在进程内加载 CLR 与 LibreHardwareMonitorLib.dll：启动慢、内存占用大，采样线程可能遇到 GC 暂停；
+// Windows 原生提供者覆盖 CPU 温度之前暂时保留
+// 本头文件不含托管类型，实现文件以 /clr 编译
+// 登记时记下每个传感器在 Libre 中的硬件/传感器下标；采样时每个到期的硬件节点只 Update() 一次，
+// 再按下标读取到期的传感器，没有订阅的硬件节点不刷新；之后新出现的传感器忽略
+class LibreSensorProvider : public ISensorProvider {
+public:
+    LibreSensorProvider();
+    ~LibreSensorProvider() override;
+
+    LibreSensorProvider(const LibreSensorProvider&) = delete;
+    LibreSensorProvider& operator=(const LibreSensorProvider&) = delete;
+
+    const char* Name() const override { return "LibreHardwareMonitor"; }
+    void Register(SensorRegistry& registry) override;
+    bool Sample(const SensorSampleContext& context) override;
+    bool IsAvailable() const override { return !ids.empty(); }
+
+private:
+    // 一个 Libre 硬件节点及其传感器在 ids 中的区间
+    struct Node {
+        int libreHardware = 0;
+        uint16_t hardware = 0;
+        size_t first = 0;
+        size_t end = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<SensorId> ids;
+    std::vector<int> libreSensors;      // 与 ids 一一对应，Libre 中的传感器下标
+};
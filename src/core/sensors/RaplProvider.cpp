@@ -0,0 +1,113 @@
+﻿#include "RaplProvider.h"
+
+#ifndef _WIN32
+#include "../Utils/CounterMath.h"
+#include "../Utils/TextScan.h"
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <limits>
+#endif
+
+#ifdef _WIN32
+
+RaplProvider::RaplProvider(const std::string& sysfsRoot) : root(sysfsRoot) {}
+
+void RaplProvider::Register(SensorRegistry&) {}
+
+bool RaplProvider::Sample(const SensorSampleContext&) {
+    return false;
+}
+
+#else
+
+namespace {
+    const char kZonePrefix[] = "intel-rapl:";
+
+    std::string ReadLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        while (!line.empty() && (line.back() == '\n' || line.back() == ' ')) line.pop_back();
+        return line;
+    }
+
+    // 区域名（package-0、core、uncore、dram、psys）转为传感器名称
+    std::string LabelOf(const std::string& zoneName) {
+        if (zoneName.compare(0, 7, "package") == 0) return "Package";
+        if (zoneName == "core") return "Core";
+        if (zoneName == "uncore") return "Uncore";
+        if (zoneName == "dram") return "DRAM";
+        if (zoneName == "psys") return "Platform";
+        return zoneName;
+    }
+}
+
+RaplProvider::RaplProvider(const std::string& sysfsRoot) : root(sysfsRoot) {}
+
+void RaplProvider::Register(SensorRegistry& registry) {
+    const std::string directory = root + "/powercap";
+    std::vector<std::string> names;
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return;
+    while (dirent* entry = readdir(dir)) {
+        if (strncmp(entry->d_name, kZonePrefix, sizeof(kZonePrefix) - 1) == 0) names.emplace_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for (const std::string& name : names) {
+        const std::string base = directory + "/" + name;
+        const std::string zoneName = ReadLine(base + "/name");
+        if (zoneName.empty()) continue;
+        // intel-rapl:N 为顶层区域，intel-rapl:N:M 为其子区域，归入父区域的硬件
+        size_t parentEnd = name.find(':', sizeof(kZonePrefix) - 1);
+        bool topLevel = parentEnd == std::string::npos;
+        const std::string parent = topLevel ? name : name.substr(0, parentEnd);
+        const std::string parentName = topLevel ? zoneName : ReadLine(directory + "/" + parent + "/name");
+        if (parentName.empty()) continue;
+        HardwareCategory category = parentName.compare(0, 7, "package") == 0 ? HardwareCategory::Cpu : HardwareCategory::Other;
+
+        Zone zone;
+        if (!zone.energy.Open(base + "/energy_uj", 32)) continue;
+        const std::string range = ReadLine(base + "/max_energy_range_uj");
+        const char* p = range.c_str();
+        if (!TextScan::ParseU64(p, range.c_str() + range.size(), zone.range)) zone.range = 0;
+
+        uint16_t hardware = registry.AddHardware(parentName + " (" + parent + ")", category);
+        zone.id = registry.AddSensor(hardware, SensorKind::Power, LabelOf(zoneName), topLevel && category == HardwareCategory::Cpu);
+        zones.push_back(std::move(zone));
+    }
+}
+
+bool RaplProvider::Sample(const SensorSampleContext& context) {
+    const uint64_t now = CounterMath::MonotonicNowNs();
+    const double unavailable = std::numeric_limits<double>::quiet_NaN();
+    bool any = false;
+    for (Zone& zone : zones) {
+        if (!context.sensorDue[zone.id]) continue;
+        uint64_t energy = 0;
+        const char* p = zone.energy.Read() ? zone.energy.Data() : nullptr;
+        if (!p || !TextScan::ParseU64(p, zone.energy.End(), energy)) {
+            context.values[zone.id] = unavailable;
+            zone.primed = false;
+            continue;
+        }
+        if (zone.primed && now > zone.lastNs) {
+            uint64_t delta = zone.range ? CounterMath::DeltaWithRange(zone.lastEnergy, energy, zone.range)
+                                        : CounterMath::Delta(zone.lastEnergy, energy);
+            // 微焦/秒 = 微瓦
+            context.values[zone.id] = CounterMath::PerSecond(delta, now - zone.lastNs) / 1000000.0;
+            any = true;
+        } else {
+            context.values[zone.id] = unavailable;
+        }
+        zone.lastEnergy = energy;
+        zone.lastNs = now;
+        zone.primed = true;
+    }
+    return any;
+}
+
+#endif
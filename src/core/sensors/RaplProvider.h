@@ -0,0 +1,45 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SensorRegistry.h"
+
+#ifndef _WIN32
+#include "../Utils/ProcFile.h"
+#endif
+
+// Linux RAPL 功耗：/sys/class/powercap/intel-rapl:* 的累计能耗计数（微焦），AMD 处理器也以同名接口提供
+// 功耗 = 两次读取之间的能耗差 / 时间差，计数器按 max_energy_range_uj 回绕（CounterMath::DeltaWithRange）；
+// 首次读取只建立基线，读数为 NaN
+// 每个顶层区域（package-N、psys）登记为一个硬件，子区域（core、uncore、dram）作为其下的传感器；
+// intel-rapl-mmio 与 MSR 接口是同一计数，跳过以免重复
+// 较新内核的 energy_uj 只对 root 可读，打不开的区域不登记；Windows 下 IsAvailable() 始终为 false
+class RaplProvider : public ISensorProvider {
+public:
+    explicit RaplProvider(const std::string& sysfsRoot = "/sys/class");
+
+    RaplProvider(const RaplProvider&) = delete;
+    RaplProvider& operator=(const RaplProvider&) = delete;
+
+    const char* Name() const override { return "RAPL"; }
+    void Register(SensorRegistry& registry) override;
+    bool Sample(const SensorSampleContext& context) override;
+    bool IsAvailable() const override { return !zones.empty(); }
+
+private:
+#ifndef _WIN32
+    struct Zone {
+        SensorId id = SensorRegistry::kInvalidSensor;
+        ProcFile energy;                // energy_uj
+        uint64_t range = 0;             // max_energy_range_uj，为 0 时按普通计数器处理
+        uint64_t lastEnergy = 0;
+        uint64_t lastNs = 0;
+        bool primed = false;            // 已有基线
+    };
+
+    std::vector<Zone> zones;
+#else
+    std::vector<SensorId> zones;
+#endif
+    std::string root;
+};
@@ -0,0 +1,200 @@
+﻿#include "SensorRegistry.h"
+#include "../Utils/CounterMath.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // 主循环周期有抖动，提前不超过间隔的 1/10 也算到期，避免与订阅间隔相同的传感器隔一个周期才刷新
+    constexpr uint64_t kEarlyToleranceDivisor = 10;
+}
+
+SensorRegistry::~SensorRegistry() {
+    // 提供者可能持有指向注册表的状态，先于其他成员释放
+    providers.clear();
+}
+
+void SensorRegistry::AddProvider(std::unique_ptr<ISensorProvider> provider) {
+    if (!provider) return;
+    ProviderRange range;
+    range.first = static_cast<SensorId>(descriptors.size());
+    provider->Register(*this);
+    range.end = static_cast<SensorId>(descriptors.size());
+    providers.push_back(std::move(provider));
+    providerRanges.push_back(range);
+}
+
+uint32_t SensorRegistry::Intern(const std::string& text) {
+    auto it = interned.find(text);
+    if (it != interned.end()) return it->second;
+    uint32_t offset = static_cast<uint32_t>(pool.size());
+    pool.insert(pool.end(), text.begin(), text.end());
+    pool.push_back('\0');
+    interned.emplace(text, offset);
+    return offset;
+}
+
+uint16_t SensorRegistry::AddHardware(const std::string& name, HardwareCategory category) {
+    uint32_t offset = Intern(name);
+    for (size_t i = 0; i < hardware.size(); ++i) {
+        if (hardware[i].nameOffset == offset && hardware[i].category == category) return static_cast<uint16_t>(i);
+    }
+    Hardware entry;
+    entry.nameOffset = offset;
+    entry.category = category;
+    hardware.push_back(entry);
+    hardwareDue.push_back(0);
+    return static_cast<uint16_t>(hardware.size() - 1);
+}
+
+SensorId SensorRegistry::AddSensor(uint16_t hardwareIndex, SensorKind kind, const std::string& name, bool primary) {
+    Descriptor descriptor;
+    descriptor.nameOffset = Intern(name);
+    descriptor.hardware = hardwareIndex;
+    descriptor.kind = kind;
+    descriptor.unit = UnitOf(kind);
+    descriptor.primary = primary;
+    descriptors.push_back(descriptor);
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    raw.push_back(std::numeric_limits<double>::quiet_NaN());
+    deadbands.push_back(DefaultDeadband(kind));
+    publishedNs.push_back(0);
+    intervals.push_back(0);
+    lastSampleNs.push_back(0);
+    sensorDue.push_back(0);
+    ++generation;
+    return static_cast<SensorId>(descriptors.size() - 1);
+}
+
+SubscriptionId SensorRegistry::Subscribe(const std::vector<SensorId>& sensors, uint32_t intervalMs) {
+    size_t slot = 0;
+    while (slot < subscriptions.size() && subscriptions[slot].active) ++slot;
+    if (slot == subscriptions.size()) subscriptions.emplace_back();
+    Subscription& subscription = subscriptions[slot];
+    subscription.sensors.clear();
+    for (SensorId id : sensors) {
+        if (id < descriptors.size()) subscription.sensors.push_back(id);
+    }
+    subscription.intervalMs = (std::max)(intervalMs, 1u);
+    subscription.active = true;
+    RecomputeIntervals();
+    return static_cast<SubscriptionId>(slot);
+}
+
+void SensorRegistry::Unsubscribe(SubscriptionId subscription) {
+    if (subscription >= subscriptions.size() || !subscriptions[subscription].active) return;
+    subscriptions[subscription].active = false;
+    subscriptions[subscription].sensors.clear();
+    RecomputeIntervals();
+}
+
+void SensorRegistry::RecomputeIntervals() {
+    std::vector<uint32_t> previous(intervals);
+    std::fill(intervals.begin(), intervals.end(), 0u);
+    for (const Subscription& subscription : subscriptions) {
+        if (!subscription.active) continue;
+        for (SensorId id : subscription.sensors) {
+            if (intervals[id] == 0 || subscription.intervalMs < intervals[id]) intervals[id] = subscription.intervalMs;
+        }
+    }
+    for (SensorId id = 0; id < intervals.size(); ++id) {
+        // 不再有人订阅的读数不会再刷新，置为不可用而不是留着过期值
+        if (intervals[id] == 0 && !std::isnan(values[id])) {
+            values[id] = raw[id] = std::numeric_limits<double>::quiet_NaN();
+            ++valueGeneration;
+        }
+        // 间隔缩短后立即读取一次，不必等旧间隔走完
+        if (intervals[id] != 0 && (previous[id] == 0 || intervals[id] < previous[id])) lastSampleNs[id] = 0;
+    }
+}
+
+bool SensorRegistry::Sample() {
+    const uint64_t now = CounterMath::MonotonicNowNs();
+    std::fill(hardwareDue.begin(), hardwareDue.end(), static_cast<uint8_t>(0));
+    for (SensorId id = 0; id < descriptors.size(); ++id) {
+        bool due = false;
+        if (intervals[id] != 0) {
+            const uint64_t intervalNs = static_cast<uint64_t>(intervals[id]) * 1000000ULL;
+            due = lastSampleNs[id] == 0 || now - lastSampleNs[id] + intervalNs / kEarlyToleranceDivisor >= intervalNs;
+        }
+        sensorDue[id] = due ? 1 : 0;
+        if (due) {
+            lastSampleNs[id] = now;
+            hardwareDue[descriptors[id].hardware] = 1;
+        }
+    }
+
+    SensorSampleContext context;
+    context.values = raw.data();
+    context.sensorDue = sensorDue.data();
+    context.hardwareDue = hardwareDue.data();
+    bool any = false;
+    for (size_t i = 0; i < providers.size(); ++i) {
+        const ProviderRange& range = providerRanges[i];
+        bool providerDue = false;
+        for (SensorId id = range.first; id < range.end && !providerDue; ++id) providerDue = sensorDue[id] != 0;
+        if (!providerDue || !providers[i]->IsAvailable()) continue;
+        if (providers[i]->Sample(context)) any = true;
+        for (SensorId id = range.first; id < range.end; ++id) {
+            if (sensorDue[id] && Publish(id, now)) ++valueGeneration;
+        }
+    }
+    return any;
+}
+
+bool SensorRegistry::Publish(SensorId id, uint64_t nowNs) {
+    const double current = raw[id];
+    const double published = values[id];
+    const Deadband& deadband = deadbands[id];
+    bool changed;
+    if (std::isnan(current) || std::isnan(published)) {
+        changed = std::isnan(current) != std::isnan(published);
+    } else {
+        const uint64_t refreshNs = static_cast<uint64_t>(deadband.refreshMs) * 1000000ULL;
+        changed = std::fabs(current - published) >= deadband.threshold && current != published;
+        if (!changed && refreshNs != 0 && nowNs - publishedNs[id] >= refreshNs) changed = true;
+    }
+    if (!changed) return false;
+    values[id] = current;
+    publishedNs[id] = nowNs;
+    return true;
+}
+
+SensorRegistry::Deadband SensorRegistry::DefaultDeadband(SensorKind kind) {
+    // 各种类读数的常见抖动幅度；至少每 30 秒发布一次，消费方可据此确认数据仍在更新
+    Deadband deadband;
+    deadband.refreshMs = 30000;
+    switch (kind) {
+    case SensorKind::Temperature: deadband.threshold = 0.5; break;     // ℃
+    case SensorKind::Fan: deadband.threshold = 25.0; break;            // RPM
+    case SensorKind::Voltage: deadband.threshold = 0.01; break;        // V
+    case SensorKind::Power: deadband.threshold = 0.5; break;           // W
+    case SensorKind::Clock: deadband.threshold = 25.0; break;          // MHz
+    case SensorKind::Load: deadband.threshold = 1.0; break;            // %
+    case SensorKind::Control: deadband.threshold = 1.0; break;         // %
+    }
+    return deadband;
+}
+
+SensorId SensorRegistry::FindPrimary(HardwareCategory category, SensorKind kind) const {
+    SensorId fallback = kInvalidSensor;
+    for (SensorId id = 0; id < descriptors.size(); ++id) {
+        const Descriptor& descriptor = descriptors[id];
+        if (descriptor.kind != kind || hardware[descriptor.hardware].category != category) continue;
+        if (descriptor.primary) return id;
+        if (fallback == kInvalidSensor) fallback = id;
+    }
+    return fallback;
+}
+
+SensorUnit SensorRegistry::UnitOf(SensorKind kind) {
+    switch (kind) {
+    case SensorKind::Fan: return SensorUnit::Rpm;
+    case SensorKind::Voltage: return SensorUnit::Volt;
+    case SensorKind::Power: return SensorUnit::Watt;
+    case SensorKind::Clock: return SensorUnit::Megahertz;
+    case SensorKind::Load: return SensorUnit::Percent;
+    case SensorKind::Control: return SensorUnit::Percent;
+    default: return SensorUnit::Celsius;
+    }
+}
@@ -0,0 +1,126 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ISensorProvider.h"
+
+enum class SensorKind : uint8_t { Temperature, Fan, Voltage, Power, Clock, Load, Control };
+enum class SensorUnit : uint8_t { Celsius, Rpm, Volt, Watt, Megahertz, Percent };
+enum class HardwareCategory : uint8_t { Cpu, Gpu, Storage, Motherboard, Other };
+
+using SensorId = uint32_t;
+using SubscriptionId = uint32_t;
+
+// 传感器注册表：发现传感器时分配稳定的整数 ID，并一次性记录种类、单位、所属硬件与名称（名称驻留在字符串池中）
+// 每个周期 Sample() 只由各提供者把读数写入与 ID 对应的 double 数组，NaN 表示本周期不可用
+// 注册只在初始化阶段进行；注册期间 NameOf() 返回的指针可能因字符串池扩容而失效
+// 只采样被订阅的传感器：消费方（共享内存区段、导出、告警规则）用 Subscribe() 声明所需传感器与刷新间隔，
+// 同一传感器取各订阅中最短的间隔；没有传感器到期的提供者整轮跳过，未订阅的传感器保持 NaN
+// 提供者写入的是原始读数，注册表按死区过滤后才更新对外读数：与上次发布值相差不足 threshold 时保持原值，
+// 超过 refreshMs 未发布时无论变化多小都发布一次；只有对外读数变化才递增 GetValueGeneration()
+class SensorRegistry {
+public:
+    static constexpr SensorId kInvalidSensor = 0xFFFFFFFFu;
+    static constexpr SubscriptionId kInvalidSubscription = 0xFFFFFFFFu;
+
+    struct Hardware {
+        uint32_t nameOffset = 0;
+        HardwareCategory category = HardwareCategory::Other;
+    };
+
+    // threshold 为 0 时任何变化都发布；refreshMs 为 0 时不强制刷新
+    struct Deadband {
+        double threshold = 0.0;
+        uint32_t refreshMs = 0;
+    };
+
+    struct Descriptor {
+        uint32_t nameOffset = 0;
+        uint16_t hardware = 0;          // hardware 表下标
+        SensorKind kind = SensorKind::Temperature;
+        SensorUnit unit = SensorUnit::Celsius;
+        bool primary = false;           // 所属类别的代表读数（如 CPU Package、主 GPU 核心温度）
+    };
+
+    SensorRegistry() = default;
+    ~SensorRegistry();
+
+    SensorRegistry(const SensorRegistry&) = delete;
+    SensorRegistry& operator=(const SensorRegistry&) = delete;
+
+    // 接管提供者并立即调用其 Register()
+    void AddProvider(std::unique_ptr<ISensorProvider> provider);
+
+    // 供提供者在 Register() 中调用；同名同类别的硬件只登记一次
+    uint16_t AddHardware(const std::string& name, HardwareCategory category);
+    SensorId AddSensor(uint16_t hardware, SensorKind kind, const std::string& name, bool primary = false);
+
+    // 订阅一组传感器，intervalMs 为期望的最长刷新间隔；无效 ID 忽略
+    SubscriptionId Subscribe(const std::vector<SensorId>& sensors, uint32_t intervalMs);
+    void Unsubscribe(SubscriptionId subscription);
+    // 各传感器的生效间隔（毫秒），未订阅为 0
+    uint32_t IntervalOf(SensorId id) const { return intervals[id]; }
+
+    // 登记时按种类使用 DefaultDeadband()，可逐个传感器覆盖
+    void SetDeadband(SensorId id, const Deadband& deadband) { deadbands[id] = deadband; }
+    const Deadband& DeadbandOf(SensorId id) const { return deadbands[id]; }
+    static Deadband DefaultDeadband(SensorKind kind);
+
+    // 只读取到期的传感器；返回是否有提供者读到数据
+    bool Sample();
+
+    size_t Count() const { return descriptors.size(); }
+    const Descriptor& Describe(SensorId id) const { return descriptors[id]; }
+    const char* NameOf(SensorId id) const { return pool.data() + descriptors[id].nameOffset; }
+    const char* HardwareNameOf(SensorId id) const { return pool.data() + hardware[descriptors[id].hardware].nameOffset; }
+    HardwareCategory CategoryOf(SensorId id) const { return hardware[descriptors[id].hardware].category; }
+    double Value(SensorId id) const { return values[id]; }
+    const double* Values() const { return values.data(); }
+    const std::vector<std::unique_ptr<ISensorProvider>>& GetProviders() const { return providers; }
+
+    // 类别中第一个标记为 primary 的该种类传感器，没有时取第一个该种类传感器；都没有时返回 kInvalidSensor
+    SensorId FindPrimary(HardwareCategory category, SensorKind kind) const;
+    // 每登记一个传感器递增，发布端据此判断描述是否需要重写
+    uint64_t GetGeneration() const { return generation; }
+    // 对外读数越过死区、强制刷新或变为/不再是 NaN 时递增，发布端据此判断读数是否需要重写
+    uint64_t GetValueGeneration() const { return valueGeneration; }
+
+    static SensorUnit UnitOf(SensorKind kind);
+
+private:
+    struct Subscription {
+        std::vector<SensorId> sensors;
+        uint32_t intervalMs = 0;
+        bool active = false;
+    };
+
+    // 提供者在 Register() 中登记的传感器 ID 连续，记下区间以便跳过没有到期传感器的提供者
+    struct ProviderRange {
+        SensorId first = 0;
+        SensorId end = 0;
+    };
+
+    uint32_t Intern(const std::string& text);
+    void RecomputeIntervals();
+    bool Publish(SensorId id, uint64_t nowNs);
+
+    std::vector<std::unique_ptr<ISensorProvider>> providers;
+    std::vector<ProviderRange> providerRanges;              // 与 providers 一一对应
+    std::vector<Hardware> hardware;
+    std::vector<Descriptor> descriptors;
+    std::vector<double> values;                             // 与 descriptors 一一对应，死区过滤后的对外读数
+    std::vector<double> raw;                                // 与 descriptors 一一对应，提供者写入的原始读数
+    std::vector<Deadband> deadbands;                        // 与 descriptors 一一对应
+    std::vector<uint64_t> publishedNs;                      // 与 descriptors 一一对应，上次发布的时间
+    std::vector<Subscription> subscriptions;                // 下标即 SubscriptionId，退订的槽位复用
+    std::vector<uint32_t> intervals;                        // 与 descriptors 一一对应，各订阅的最短间隔
+    std::vector<uint64_t> lastSampleNs;                     // 与 descriptors 一一对应，0 表示尚未读取
+    std::vector<uint8_t> sensorDue;                         // 与 descriptors 一一对应，每次 Sample() 重算
+    std::vector<uint8_t> hardwareDue;                       // 与 hardware 一一对应
+    std::vector<char> pool;                                 // 以 '\0' 结尾的名称依次存放
+    std::unordered_map<std::string, uint32_t> interned;     // 名称 -> pool 偏移，只在注册时使用
+    uint64_t generation = 0;
+    uint64_t valueGeneration = 0;
+};
@@ -1,16 +1,19 @@
 #pragma once
 
-#include <string>
-#include <vector>
-#include <utility>
-#include "../gpu/GpuInfo.h"
+class GpuService;
+class SensorRegistry;
 
-// 本机C++包装器类，用于调用托管的LibreHardwareMonitorBridge
+// 传感器采集入口：持有进程内唯一的传感器注册表，并按平台挂接提供者
+// Linux 为 hwmon 与 RAPL；Windows 在定义 TCMT_WITH_LIBRE 时使用 Libre 兼容提供者；GPU 读数来自 GpuService
 class TemperatureWrapper {
 public:
-    static void Initialize();
+    // gpuService 由调用方持有，须在 Cleanup() 之前一直有效；为 nullptr 时不提供 GPU 读数
+    static void Initialize(GpuService* gpuService = nullptr);
     static void Cleanup();
-    static std::vector<std::pair<std::string, double>> GetTemperatures();
+    // 采样已订阅且到期的传感器，只刷新注册表中的数值
+    static bool Sample();
+    // 未初始化时为 nullptr；消费方通过它订阅所需传感器
+    static SensorRegistry* GetRegistry();
     static bool IsInitialized();
 
 private:
@@ -33,13 +33,29 @@
 #include <locale>   // 添加locale支持以使用setlocale
 #include <new>       // 添加内存分配异常支持
 #include <stdexcept> // 添加标准异常支持
+#include <cmath>
+#include <limits>
 
 // 最后包含项目头文件
 #include "core/cpu/CpuInfo.h"
+#include "core/cpu/SchedulerStats.h"
+#include "core/cpu/ThrottleDetector.h"
+#include "core/os/PressureInfo.h"
+#include "core/memory/NumaInfo.h"
+#include "core/disk/DiskIoStats.h"
+#include "core/disk/DiskHealthTracker.h"
+#include "core/disk/DiskTopology.h"
+#include "core/disk/SmartCollector.h"
+#include "core/disk/SpaceForecaster.h"
+#include "core/disk/VolumeInfo.h"
 #include "core/gpu/GpuInfo.h"
+#include "core/gpu/GpuService.h"
 #include "core/memory/MemoryInfo.h"
 #include "core/network/NetworkAdapter.h"
+#include "core/network/NetworkCounters.h"
+#include "core/network/SocketStats.h"
 #include "core/os/OSInfo.h"
+#include "core/utils/CounterMath.h"
 #include "core/utils/Logger.h"
 #include "core/utils/TimeUtils.h"
 #include "core/utils/WinUtils.h"
@@ -47,6 +63,7 @@
 #include "core/disk/DiskInfo.h"
 #include "core/DataStruct/DataStruct.h"
 #include "core/DataStruct/SharedMemoryManager.h"  // Include the new shared memory manager
+#include "core/sensors/SensorRegistry.h"
 #include "core/temperature/TemperatureWrapper.h"  // 使用TemperatureWrapper而不是直接调用LibreHardwareMonitorBridge
 
 #pragma comment(lib, "kernel32.lib")
@@ -471,6 +488,64 @@ std::string FormatDiskUsage(uint64_t used, uint64_t total) {
     return ss.str();
 }
 
+// 预测结果转换为共享内存结构
+static DiskForecastData ToForecastData(const SpaceForecaster::Forecast& forecast) {
+    DiskForecastData data{};
+    data.valid = forecast.valid;
+    data.fillRateBytesPerSec = forecast.fillRateBytesPerSec;
+    data.secondsToFull = forecast.secondsToFull;
+    return data;
+}
+
+// 把网卡清单中的地址、网关与DNS展开为共享内存地址池条目（只收录前4个网卡）
+static void BuildNetworkAddresses(const std::vector<NetworkAdapter::AdapterInfo>& adapters, std::vector<NetworkAddressData>& out) {
+    out.clear();
+    for (size_t i = 0; i < adapters.size() && i < 4; ++i) {
+        const std::vector<NetworkAdapter::Address>* lists[3] = { &adapters[i].addresses, &adapters[i].gateways, &adapters[i].dnsServers };
+        for (uint8_t kind = 0; kind < 3; ++kind) {
+            for (const auto& address : *lists[kind]) {
+                NetworkAddressData data{};
+                wcsncpy_s(data.address, sizeof(data.address) / sizeof(wchar_t), address.address.c_str(), _TRUNCATE);
+                data.adapterIndex = static_cast<uint8_t>(i);
+                data.kind = kind;
+                data.family = address.family == AF_INET6 ? 6 : 4;
+                data.prefixLength = address.prefixLength;
+                out.push_back(data);
+            }
+        }
+    }
+}
+
+// 按注册表生成共享内存中的传感器描述，以及兼容旧温度区段的名称列表（CPU/GPU 代表读数排在最前）
+static void BuildSensorInfos(const SensorRegistry& registry, std::vector<SensorInfoData>& out,
+    std::vector<std::pair<SensorId, TemperatureData>>& legacyTemperatures) {
+    out.clear();
+    legacyTemperatures.clear();
+    auto addLegacy = [&legacyTemperatures](SensorId id, const std::string& name) {
+        TemperatureData data{};
+        wcsncpy_s(data.sensorName, sizeof(data.sensorName) / sizeof(wchar_t), WinUtils::Utf8ToWstring(name).c_str(), _TRUNCATE);
+        legacyTemperatures.emplace_back(id, data);
+    };
+    SensorId cpu = registry.FindPrimary(HardwareCategory::Cpu, SensorKind::Temperature);
+    SensorId gpu = registry.FindPrimary(HardwareCategory::Gpu, SensorKind::Temperature);
+    if (cpu != SensorRegistry::kInvalidSensor) addLegacy(cpu, "CPU");
+    if (gpu != SensorRegistry::kInvalidSensor) addLegacy(gpu, "GPU");
+    for (SensorId id = 0; id < registry.Count(); ++id) {
+        const SensorRegistry::Descriptor& descriptor = registry.Describe(id);
+        SensorInfoData data{};
+        data.kind = static_cast<uint8_t>(descriptor.kind);
+        data.unit = static_cast<uint8_t>(descriptor.unit);
+        data.category = static_cast<uint8_t>(registry.CategoryOf(id));
+        data.primary = descriptor.primary ? 1 : 0;
+        wcsncpy_s(data.name, sizeof(data.name) / sizeof(wchar_t), WinUtils::Utf8ToWstring(registry.NameOf(id)).c_str(), _TRUNCATE);
+        wcsncpy_s(data.hardware, sizeof(data.hardware) / sizeof(wchar_t), WinUtils::Utf8ToWstring(registry.HardwareNameOf(id)).c_str(), _TRUNCATE);
+        out.push_back(data);
+        if (descriptor.kind == SensorKind::Temperature && id != cpu && id != gpu) {
+            addLegacy(id, registry.NameOf(id));
+        }
+    }
+}
+
 static void PrintSectionHeader(const std::string& title) {
     SafeConsoleOutput("\n=== " + title + " ===\n", 14); // 黄色
 }
@@ -500,91 +575,6 @@ bool IsRunAsAdmin() {
     return isAdmin == TRUE;
 }
 
-// 线程安全的GPU信息缓存类
-class ThreadSafeGpuCache {
-private:
-    mutable std::mutex mtx_;
-    bool initialized_ = false;
-    std::string cachedGpuName_ = "未检测到GPU";
-    std::string cachedGpuBrand_ = "未知";
-    uint64_t cachedGpuMemory_ = 0;
-    uint32_t cachedGpuCoreFreq_ = 0;
-    bool cachedGpuIsVirtual_ = false;
-
-public:
-    void Initialize(WmiManager& wmiManager) {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (initialized_) return;
-        
-        try {
-            Logger::Info("正在初始化GPU信息");
-            
-            GpuInfo gpuInfo(wmiManager);
-            const auto& gpus = gpuInfo.GetGpuData();
-            
-            // 记录所有检测到的GPU
-            for (const auto& gpu : gpus) {
-                std::string gpuName = WinUtils::WstringToString(gpu.name);
-                Logger::Info("检测到GPU: " + gpuName + 
-                           " (虚拟: " + (gpu.isVirtual ? "是" : "否") + 
-                           ", NVIDIA: " + (gpuName.find("NVIDIA") != std::string::npos ? "是" : "否") + 
-                           ", 集成: " + (gpuName.find("Intel") != std::string::npos ||
-                                       gpuName.find("AMD") != std::string::npos ? "是" : "否") + ")");
-            }
-            
-            // 优先选择非虚拟GPU
-            const GpuInfo::GpuData* selectedGpu = nullptr;
-            for (const auto& gpu : gpus) {
-                if (!gpu.isVirtual) {
-                    selectedGpu = &gpu;
-                    break;
-                }
-            }
-            
-            // 如果没有非虚拟GPU，选择第一个GPU
-            if (!selectedGpu && !gpus.empty()) {
-                selectedGpu = &gpus[0];
-            }
-            
-            if (selectedGpu) {
-                cachedGpuName_ = WinUtils::WstringToString(selectedGpu->name);
-                cachedGpuBrand_ = GetGpuBrand(selectedGpu->name);
-                cachedGpuMemory_ = selectedGpu->dedicatedMemory;
-                cachedGpuCoreFreq_ = static_cast<uint32_t>(selectedGpu->coreClock);
-                cachedGpuIsVirtual_ = selectedGpu->isVirtual;
-                
-                Logger::Info("选择主GPU: " + cachedGpuName_ + 
-                           " (虚拟: " + (cachedGpuIsVirtual_ ? "是" : "否") + ")");
-            } else {
-                Logger::Warn("未检测到任何GPU");
-            }
-            
-            initialized_ = true;
-            Logger::Info("GPU信息初始化完成，后续循环将使用缓存信息");
-        }
-        catch (const std::exception& e) {
-            Logger::Error("GPU信息初始化失败: " + std::string(e.what()));
-            // 保持默认值
-            initialized_ = true; // 标记为已初始化以避免重复尝试
-        }
-    }
-    
-    void GetCachedInfo(std::string& name, std::string& brand, uint64_t& memory, 
-                       uint32_t& coreFreq, bool& isVirtual) const {
-        std::lock_guard<std::mutex> lock(mtx_);
-        name = cachedGpuName_;
-        brand = cachedGpuBrand_;
-        memory = cachedGpuMemory_;
-        coreFreq = cachedGpuCoreFreq_;
-        isVirtual = cachedGpuIsVirtual_;
-    }
-    
-    bool IsInitialized() const {
-        std::lock_guard<std::mutex> lock(mtx_);
-        return initialized_;
-    }
-}; // 添加缺少的分号
-
 // 主函数 - 控制台模式
 int main(int argc, char* argv[]) {
     // 设置结构化异常处理
@@ -717,9 +707,21 @@ int main(int argc, char* argv[]) {
             SafeExit(1);
         }
 
+        // GPU服务：统一负责GPU枚举与动态刷新，温度、GPU信息与共享内存发布共用同一份数据
+        std::unique_ptr<GpuService> gpuService;
+        try {
+            gpuService = std::make_unique<GpuService>(*wmiManager);
+            if (!gpuService->GetTelemetry().IsAvailable()) {
+                Logger::Info("未加载 NVML 或未发现 NVIDIA GPU，GPU 遥测将为空");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("GPU服务创建失败: " + std::string(e.what()));
+        }
+
         // 初始化硬件监控桥接
         try {
-            TemperatureWrapper::Initialize();
+            TemperatureWrapper::Initialize(gpuService.get());
             Logger::Debug("硬件监控桥接初始化成功");
         }
         catch (const std::exception& e) {
@@ -743,6 +745,8 @@ int main(int argc, char* argv[]) {
         static uint32_t cachedEfficiencyCores = 0;
         static bool cachedHyperThreading = false;
         static bool cachedVirtualization = false;
+        static bool cachedHypervisorPresent = false;
+        static std::string cachedHypervisorName;
         
         // 创建CPU对象一次，重复使用（避免重复初始化性能计数器）- 增强异常处理
         std::unique_ptr<CpuInfo> cpuInfo;
@@ -766,10 +770,178 @@ int main(int argc, char* argv[]) {
             Logger::Fatal("CPU信息对象创建失败 - 未知异常");
             SafeExit(1);
         }
+
+        // 调度器/中断统计对象常驻，速率依赖相邻两次采样的计数器差值
+        std::unique_ptr<SchedulerStats> schedulerStats;
+        try {
+            schedulerStats = std::make_unique<SchedulerStats>();
+            if (!schedulerStats->IsAvailable()) {
+                Logger::Warn("调度器统计不可用，相关数据将保持为0");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("调度器统计对象创建失败: " + std::string(e.what()));
+        }
         
-        // 线程安全的GPU缓存
-        ThreadSafeGpuCache gpuCache;
-        
+        // 内存信息对象常驻，避免每个周期重建并保留缺页/交换速率的基线
+        std::unique_ptr<MemoryInfo> memoryInfo;
+        try {
+            memoryInfo = std::make_unique<MemoryInfo>();
+        }
+        catch (const std::exception& e) {
+            Logger::Error("内存信息对象创建失败: " + std::string(e.what()));
+        }
+
+        // 压力阻塞信息对象常驻，阻塞率依赖相邻两次采样的累计值差值
+        std::unique_ptr<PressureInfo> pressureInfo;
+        try {
+            pressureInfo = std::make_unique<PressureInfo>();
+            if (!pressureInfo->IsAvailable()) {
+                Logger::Warn("压力阻塞信息不可用，相关数据将保持为0");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("压力阻塞信息对象创建失败: " + std::string(e.what()));
+        }
+        bool memoryPressureWarned = false;
+
+        // NUMA 节点统计对象常驻，节点列表与核心归属只在启动时发现一次
+        std::unique_ptr<NumaInfo> numaInfo;
+        try {
+            numaInfo = std::make_unique<NumaInfo>();
+            if (!numaInfo->IsAvailable()) {
+                Logger::Info("未发现 NUMA 节点信息，节点统计将为空");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("NUMA信息对象创建失败: " + std::string(e.what()));
+        }
+
+        // 块设备 I/O 统计对象常驻，设备句柄/文件只打开一次
+        std::unique_ptr<DiskIoStats> diskIoStats;
+        try {
+            diskIoStats = std::make_unique<DiskIoStats>();
+            if (!diskIoStats->IsAvailable()) {
+                Logger::Warn("块设备I/O统计不可用，相关数据将为空");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("块设备I/O统计对象创建失败: " + std::string(e.what()));
+        }
+
+        // SMART/NVMe 健康信息常驻缓存，按10分钟周期刷新（查询会唤醒休眠的机械盘）
+        std::unique_ptr<SmartCollector> smartCollector;
+        try {
+            smartCollector = std::make_unique<SmartCollector>();
+        }
+        catch (const std::exception& e) {
+            Logger::Error("SMART采集对象创建失败: " + std::string(e.what()));
+        }
+
+        // SMART 趋势历史（按序列号保存在程序目录 disk_health 下），用于故障风险评分与磨损耗尽预测
+        std::unique_ptr<DiskHealthTracker> diskHealthTracker;
+        try {
+            diskHealthTracker = std::make_unique<DiskHealthTracker>(WinUtils::GetExecutableDirectory() + "\\disk_health");
+        }
+        catch (const std::exception& e) {
+            Logger::Error("磁盘健康趋势对象创建失败: " + std::string(e.what()));
+        }
+
+        // 物理磁盘拓扑缓存：只在设备到达/移除时重建，稳定运行时每个周期不再执行 WMI 查询
+        std::unique_ptr<DiskTopology> diskTopology;
+        try {
+            if (wmiManager) {
+                diskTopology = std::make_unique<DiskTopology>(*wmiManager);
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("磁盘拓扑缓存创建失败: " + std::string(e.what()));
+        }
+
+        // 已挂载文件系统（含无盘符卷与挂载文件夹），挂载表变化时才重新枚举
+        std::unique_ptr<VolumeInfo> volumeInfo;
+        try {
+            volumeInfo = std::make_unique<VolumeInfo>();
+            if (!volumeInfo->IsAvailable()) {
+                Logger::Warn("卷枚举不可用，挂载点数据将为空");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("卷信息对象创建失败: " + std::string(e.what()));
+        }
+
+        // 按挂载点保存用量平滑状态，预测填满时间
+        SpaceForecaster spaceForecaster;
+
+        // 网卡清单常驻，只在收到网络变更通知时重新执行 WMI 查询
+        std::unique_ptr<NetworkAdapter> networkAdapter;
+        try {
+            if (wmiManager) {
+                networkAdapter = std::make_unique<NetworkAdapter>(*wmiManager);
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("网卡清单对象创建失败: " + std::string(e.what()));
+        }
+        // 地址池只在网卡清单重新枚举后重建
+        std::vector<NetworkAddressData> networkAddresses;
+        uint64_t networkAddressGeneration = 0;
+
+        // 传感器描述只在注册表变化时重建，每个周期只复制读数
+        std::vector<SensorInfoData> sensorInfos;
+        std::vector<std::pair<SensorId, TemperatureData>> legacyTemperatures;
+        uint64_t sensorGeneration = 0;
+        SensorId cpuTemperatureSensor = SensorRegistry::kInvalidSensor;
+        SensorId gpuTemperatureSensor = SensorRegistry::kInvalidSensor;
+        SensorId cpuPowerSensor = SensorRegistry::kInvalidSensor;
+        // 共享内存的两个消费方各自订阅：CPU/GPU 与旧温度区段随主循环刷新，完整传感器区段的其余读数降低频率
+        // 降频检测需要每个周期的 CPU 温度与封装功耗
+        constexpr uint32_t kTemperatureSectionIntervalMs = 1000;
+        constexpr uint32_t kSensorSectionIntervalMs = 2000;
+        constexpr uint32_t kThrottleIntervalMs = 1000;
+        SubscriptionId temperatureSubscription = SensorRegistry::kInvalidSubscription;
+        SubscriptionId sensorSubscription = SensorRegistry::kInvalidSubscription;
+        SubscriptionId throttleSubscription = SensorRegistry::kInvalidSubscription;
+
+        // 降频检测常驻，thermal_throttle 计数需要相邻两次采样的差值
+        std::unique_ptr<ThrottleDetector> throttleDetector;
+        try {
+            throttleDetector = std::make_unique<ThrottleDetector>();
+            if (!throttleDetector->IsAvailable()) {
+                Logger::Info("CPU 降频信号不可用，只检测 GPU 降频");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("降频检测对象创建失败: " + std::string(e.what()));
+        }
+        // 事件区副本只在出现新事件时重建
+        std::vector<ThrottleEventData> throttleEvents;
+        uint64_t throttleEventSequence = 0;
+
+        // 网卡流量计数常驻，每个周期只读取已选定接口的计数
+        std::unique_ptr<NetworkCounters> networkCounters;
+        try {
+            networkCounters = std::make_unique<NetworkCounters>();
+            if (!networkCounters->IsAvailable()) {
+                Logger::Warn("网卡流量计数不可用，相关数据将为空");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("网卡流量计数对象创建失败: " + std::string(e.what()));
+        }
+
+        // 套接字统计常驻，协议计数速率依赖相邻两次采样
+        std::unique_ptr<SocketStats> socketStats;
+        try {
+            socketStats = std::make_unique<SocketStats>();
+            if (!socketStats->IsAvailable()) {
+                Logger::Warn("套接字统计不可用，相关数据将为空");
+            }
+        }
+        catch (const std::exception& e) {
+            Logger::Error("套接字统计对象创建失败: " + std::string(e.what()));
+        }
+
         while (!g_shouldExit.load()) {
             try {
                 auto loopStart = std::chrono::high_resolution_clock::now();
@@ -838,6 +1010,8 @@ int main(int argc, char* argv[]) {
                             cachedEfficiencyCores = cpuInfo->GetSmallCores();
                             cachedHyperThreading = cpuInfo->IsHyperThreadingEnabled();
                             cachedVirtualization = cpuInfo->IsVirtualizationEnabled();
+                            cachedHypervisorPresent = cpuInfo->IsHypervisorPresent();
+                            cachedHypervisorName = cpuInfo->GetHypervisorName();
                         }
                         
                         systemInfoCached = true;
@@ -861,6 +1035,8 @@ int main(int argc, char* argv[]) {
                 sysInfo.efficiencyCores = cachedEfficiencyCores;
                 sysInfo.hyperThreading = cachedHyperThreading;
                 sysInfo.virtualization = cachedVirtualization;
+                sysInfo.hypervisorPresent = cachedHypervisorPresent;
+                sysInfo.hypervisorName = cachedHypervisorName;
 
                 // 动态CPU信息（每次循环都需要获取）
                 try {
@@ -876,37 +1052,160 @@ int main(int argc, char* argv[]) {
                     // 保持默认值
                 }
 
-                // 内存信息（每次循环都获取以确保数据实时性）
+                // 调度器与中断活动 + 每核心数据
                 try {
-                    MemoryInfo mem;
-                    sysInfo.totalMemory = mem.GetTotalPhysical();
-                    sysInfo.usedMemory = mem.GetTotalPhysical() - mem.GetAvailablePhysical();
-                    sysInfo.availableMemory = mem.GetAvailablePhysical();
+                    if (schedulerStats && schedulerStats->Update()) {
+                        const auto& sched = schedulerStats->GetSnapshot();
+                        sysInfo.scheduler.contextSwitchesPerSec = sched.contextSwitchesPerSec;
+                        sysInfo.scheduler.interruptsPerSec = sched.interruptsPerSec;
+                        sysInfo.scheduler.processesCreatedPerSec = sched.processesCreatedPerSec;
+                        sysInfo.scheduler.runnableTasks = sched.runnableTasks;
+                        sysInfo.scheduler.blockedTasks = sched.blockedTasks;
+                        sysInfo.scheduler.loadAverage1 = sched.loadAverage1;
+                        sysInfo.scheduler.loadAverage5 = sched.loadAverage5;
+                        sysInfo.scheduler.loadAverage15 = sched.loadAverage15;
+                        sysInfo.scheduler.stealPercent = sched.stealPercent;
+                        sysInfo.scheduler.guestPercent = sched.guestPercent;
+                        sysInfo.scheduler.stealAdjustedUsage = sched.stealAdjustedUsage;
+                        sysInfo.cores.resize(sched.cores.size());
+                        for (size_t i = 0; i < sched.cores.size(); ++i) {
+                            sysInfo.cores[i].usage = sched.cores[i].usage;
+                            sysInfo.cores[i].interruptsPerSec = sched.cores[i].interruptsPerSec;
+                            sysInfo.cores[i].stealPercent = sched.cores[i].stealPercent;
+                            sysInfo.cores[i].guestPercent = sched.cores[i].guestPercent;
+                            sysInfo.cores[i].stealAdjustedUsage = sched.cores[i].stealAdjustedUsage;
+                        }
+                    }
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("获取调度器统计失败: " + std::string(e.what()));
+                }
+
+                // 内存信息（常驻对象每次循环刷新，速率类指标依赖相邻两次采样）
+                try {
+                    if (memoryInfo && memoryInfo->Update()) {
+                        const auto& mem = memoryInfo->GetDetails();
+                        sysInfo.totalMemory = mem.totalPhysical;
+                        sysInfo.usedMemory = mem.totalPhysical - mem.availablePhysical;
+                        sysInfo.availableMemory = mem.availablePhysical;
+                        sysInfo.memoryDetail.commitCharge = mem.commitCharge;
+                        sysInfo.memoryDetail.commitLimit = mem.commitLimit;
+                        sysInfo.memoryDetail.cached = mem.cached;
+                        sysInfo.memoryDetail.standby = mem.standby;
+                        sysInfo.memoryDetail.dirty = mem.dirty;
+                        sysInfo.memoryDetail.writeback = mem.writeback;
+                        sysInfo.memoryDetail.swapTotal = mem.swapTotal;
+                        sysInfo.memoryDetail.swapUsed = mem.swapUsed;
+                        sysInfo.memoryDetail.swapInPagesPerSec = mem.swapInPagesPerSec;
+                        sysInfo.memoryDetail.swapOutPagesPerSec = mem.swapOutPagesPerSec;
+                        sysInfo.memoryDetail.minorFaultsPerSec = mem.minorFaultsPerSec;
+                        sysInfo.memoryDetail.majorFaultsPerSec = mem.majorFaultsPerSec;
+                        sysInfo.memoryDetail.hugePagesTotal = mem.hugePagesTotal;
+                        sysInfo.memoryDetail.hugePagesFree = mem.hugePagesFree;
+                        sysInfo.memoryDetail.hugePageSize = mem.hugePageSize;
+                    }
                 }
                 catch (const std::exception& e) {
                     Logger::Error("获取内存信息失败: " + std::string(e.what()));
                     // 保持默认值
                 }
 
-                // GPU信息 - 使用线程安全的缓存机制
-                if (!gpuCache.IsInitialized()) {
-                    try {
-                        gpuCache.Initialize(*wmiManager);
+                // NUMA 节点统计（节点 CPU 使用率复用调度器统计的每核心数据）
+                try {
+                    if (numaInfo && numaInfo->Update()) {
+                        if (schedulerStats) {
+                            numaInfo->ApplyCoreUsage(schedulerStats->GetSnapshot().cores);
+                        }
+                        const auto& nodes = numaInfo->GetNodes();
+                        sysInfo.numaNodes.resize(nodes.size());
+                        for (size_t i = 0; i < nodes.size(); ++i) {
+                            auto& dst = sysInfo.numaNodes[i];
+                            dst.nodeId = nodes[i].nodeId;
+                            dst.cpuCount = static_cast<uint32_t>(nodes[i].cpus.size());
+                            dst.totalMemory = nodes[i].totalMemory;
+                            dst.freeMemory = nodes[i].freeMemory;
+                            dst.usedMemory = nodes[i].usedMemory;
+                            dst.numaHit = nodes[i].numaHit;
+                            dst.numaMiss = nodes[i].numaMiss;
+                            dst.numaForeign = nodes[i].numaForeign;
+                            dst.numaHitPerSec = nodes[i].numaHitPerSec;
+                            dst.numaMissPerSec = nodes[i].numaMissPerSec;
+                            dst.numaForeignPerSec = nodes[i].numaForeignPerSec;
+                            dst.otherNodePerSec = nodes[i].otherNodePerSec;
+                            dst.cpuUsage = nodes[i].cpuUsage;
+                        }
                     }
-                    catch (const std::exception& e) {
-                        Logger::Error("GPU缓存初始化失败: " + std::string(e.what()));
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("获取NUMA节点统计失败: " + std::string(e.what()));
+                }
+
+                // 压力阻塞信息（与 CPU/内存使用率同周期采集）
+                try {
+                    if (pressureInfo && pressureInfo->Update()) {
+                        const auto& psi = pressureInfo->GetSnapshot();
+                        auto copyResource = [](PressureResourceData& dst, const PressureInfo::Resource& src) {
+                            dst.someAvg10 = src.someAvg10;
+                            dst.someAvg60 = src.someAvg60;
+                            dst.fullAvg10 = src.fullAvg10;
+                            dst.fullAvg60 = src.fullAvg60;
+                            dst.someStallPercent = src.someStallPercent;
+                            dst.fullStallPercent = src.fullStallPercent;
+                            dst.someTotalUs = src.someTotalUs;
+                            dst.fullTotalUs = src.fullTotalUs;
+                        };
+                        copyResource(sysInfo.pressure.cpu, psi.cpu);
+                        copyResource(sysInfo.pressure.memory, psi.memory);
+                        copyResource(sysInfo.pressure.io, psi.io);
+                        uint32_t flags = 0;
+                        if (psi.cpu.available) flags |= PRESSURE_FLAG_CPU;
+                        if (psi.memory.available) flags |= PRESSURE_FLAG_MEMORY;
+                        if (psi.io.available) flags |= PRESSURE_FLAG_IO;
+                        if (psi.cpu.estimated || psi.memory.estimated || psi.io.estimated) flags |= PRESSURE_FLAG_ESTIMATED;
+                        if (psi.memoryPressureWarning) flags |= PRESSURE_FLAG_MEMORY_WARNING;
+                        sysInfo.pressure.flags = flags;
+
+                        // 预警状态变化时各记录一次，避免每个周期刷屏
+                        if (psi.memoryPressureWarning != memoryPressureWarned) {
+                            memoryPressureWarned = psi.memoryPressureWarning;
+                            if (memoryPressureWarned) {
+                                Logger::Warn("内存压力预警: 阻塞占比 avg10=" + std::to_string(psi.memory.someAvg10) + "%");
+                            } else {
+                                Logger::Info("内存压力已回落");
+                            }
+                        }
                     }
                 }
+                catch (const std::exception& e) {
+                    Logger::Error("获取压力阻塞信息失败: " + std::string(e.what()));
+                }
+
+                // GPU信息 - 静态信息由GPU服务启动时枚举一次，动态数据按服务自身周期刷新
+                try {
+                    if (gpuService) gpuService->Refresh();
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("GPU动态数据刷新失败: " + std::string(e.what()));
+                }
                 
-                // 获取缓存的GPU信息
+                // 获取主GPU信息
                 try {
-                    std::string cachedGpuName, cachedGpuBrand;
-                    uint64_t cachedGpuMemory;
-                    uint32_t cachedGpuCoreFreq;
-                    bool cachedGpuIsVirtual;
+                    std::string cachedGpuName = "未检测到GPU", cachedGpuBrand = "未知";
+                    uint64_t cachedGpuMemory = 0;
+                    uint32_t cachedGpuCoreFreq = 0;
+                    bool cachedGpuIsVirtual = false;
                     
-                    gpuCache.GetCachedInfo(cachedGpuName, cachedGpuBrand, cachedGpuMemory, 
-                                          cachedGpuCoreFreq, cachedGpuIsVirtual);
+                    int primaryIndex = gpuService ? gpuService->GetPrimaryIndex() : -1;
+                    if (primaryIndex >= 0) {
+                        const auto& primaryGpu = gpuService->GetGpus()[primaryIndex];
+                        const auto& primaryDynamic = gpuService->GetDynamic()[primaryIndex];
+                        cachedGpuName = WinUtils::WstringToString(primaryGpu.name);
+                        cachedGpuBrand = GetGpuBrand(primaryGpu.name);
+                        cachedGpuMemory = primaryGpu.dedicatedMemory;
+                        // 有实时频率时使用实时值，否则使用枚举时读取的频率
+                        cachedGpuCoreFreq = static_cast<uint32_t>(primaryDynamic.valid ? primaryDynamic.coreClockMHz : primaryGpu.coreClock);
+                        cachedGpuIsVirtual = primaryGpu.isVirtual;
+                    }
                     
                     sysInfo.gpuName = cachedGpuName;
                     sysInfo.gpuBrand = cachedGpuBrand;
@@ -996,6 +1295,49 @@ int main(int argc, char* argv[]) {
                     sysInfo.gpuIsVirtual = false;
                 }
 
+                // NVIDIA GPU 实时遥测（覆盖全部 GPU，数据由GPU服务按其周期刷新）
+                try {
+                    if (gpuService) {
+                        for (const auto& device : gpuService->GetTelemetry().GetDevices()) {
+                            GpuTelemetryData data{};
+                            wcsncpy_s(data.name, sizeof(data.name) / sizeof(wchar_t), WinUtils::Utf8ToWstring(device.name).c_str(), _TRUNCATE);
+                            data.memoryTotal = device.memoryTotal;
+                            data.memoryUsed = device.memoryUsed;
+                            data.powerWatts = device.powerWatts;
+                            data.powerLimitWatts = device.powerLimitWatts;
+                            data.pcieTxBytesPerSec = device.pcieTxBytesPerSec;
+                            data.pcieRxBytesPerSec = device.pcieRxBytesPerSec;
+                            data.throttleReasons = device.throttleReasons;
+                            data.gpuUtilization = device.gpuUtilization;
+                            data.memoryUtilization = device.memoryUtilization;
+                            data.graphicsClockMHz = device.graphicsClockMHz;
+                            data.smClockMHz = device.smClockMHz;
+                            data.memoryClockMHz = device.memoryClockMHz;
+                            data.temperature = device.temperature;
+                            data.fanPercent = device.fanPercent;
+                            data.valid = device.valid;
+                            sysInfo.gpuTelemetry.push_back(data);
+                        }
+                        for (const auto& ranked : gpuService->GetTelemetry().GetTopProcesses()) {
+                            GpuProcessData data{};
+                            data.pid = ranked.process->pid;
+                            data.gpuIndex = ranked.deviceIndex;
+                            data.usedMemory = ranked.process->usedMemory;
+                            data.smUtilization = ranked.process->smUtilization;
+                            data.memoryUtilization = ranked.process->memoryUtilization;
+                            data.encoderUtilization = ranked.process->encoderUtilization;
+                            data.decoderUtilization = ranked.process->decoderUtilization;
+                            wcsncpy_s(data.name, sizeof(data.name) / sizeof(wchar_t), WinUtils::Utf8ToWstring(ranked.process->name).c_str(), _TRUNCATE);
+                            sysInfo.gpuProcesses.push_back(data);
+                        }
+                    }
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("获取GPU遥测失败: " + std::string(e.what()));
+                    sysInfo.gpuTelemetry.clear();
+                    sysInfo.gpuProcesses.clear();
+                }
+
                 // 初始化网络适配器信息（避免无效数据导致崩溃）
                 sysInfo.networkAdapterName = "未检测到网络适配器";
                 sysInfo.networkAdapterMac = "00-00-00-00-00-00";
@@ -1006,8 +1348,20 @@ int main(int argc, char* argv[]) {
                 // 填充所有网络适配器信息
                 try {
                     sysInfo.adapters.clear();
-                    NetworkAdapter netAdapter(*wmiManager);
-                    const auto& adapters = netAdapter.GetAdapters();
+                    sysInfo.adapterCounters.clear();
+                    // 网卡增删或地址变化时同步重新选定计数接口
+                    if (networkAdapter && networkAdapter->Refresh() && networkCounters) {
+                        networkCounters->Rescan();
+                    }
+                    static const std::vector<NetworkAdapter::AdapterInfo> noAdapters;
+                    const auto& adapters = networkAdapter ? networkAdapter->GetAdapters() : noAdapters;
+                    if (networkAdapter && networkAdapter->GetGeneration() != networkAddressGeneration) {
+                        BuildNetworkAddresses(adapters, networkAddresses);
+                        networkAddressGeneration = networkAdapter->GetGeneration();
+                    }
+                    sysInfo.networkAddresses = &networkAddresses;
+                    sysInfo.networkAddressGeneration = networkAddressGeneration;
+                    bool countersUpdated = networkCounters && networkCounters->Update();
                     if (!adapters.empty()) {
                         for (const auto& adapter : adapters) {
                             NetworkAdapterData data;
@@ -1018,6 +1372,30 @@ int main(int argc, char* argv[]) {
                             wcsncpy_s(data.adapterType, adapter.adapterType.c_str(), _TRUNCATE); // 添加网卡类型
                             data.speed = adapter.speed;
                             sysInfo.adapters.push_back(data);
+
+                            // 按 MAC 关联流量计数，利用率按适配器上报的 speed 计算
+                            NetworkCounterData counters{};
+                            const NetworkCounters::Interface* iface = countersUpdated
+                                ? networkCounters->FindByMac(WinUtils::WstringToUtf8(adapter.mac)) : nullptr;
+                            if (iface) {
+                                counters.rxBytesPerSec = iface->rxBytesPerSec;
+                                counters.txBytesPerSec = iface->txBytesPerSec;
+                                counters.rxPacketsPerSec = iface->rxPacketsPerSec;
+                                counters.txPacketsPerSec = iface->txPacketsPerSec;
+                                counters.rxErrorsPerSec = iface->rxErrorsPerSec;
+                                counters.txErrorsPerSec = iface->txErrorsPerSec;
+                                counters.rxDropsPerSec = iface->rxDropsPerSec;
+                                counters.txDropsPerSec = iface->txDropsPerSec;
+                                counters.rxBytesTotal = iface->rxBytes;
+                                counters.txBytesTotal = iface->txBytes;
+                                counters.rxErrors = iface->rxErrors;
+                                counters.txErrors = iface->txErrors;
+                                counters.rxDrops = iface->rxDrops;
+                                counters.txDrops = iface->txDrops;
+                                counters.utilizationPercent = NetworkCounters::UtilizationPercent(*iface, adapter.speed);
+                                counters.valid = true;
+                            }
+                            sysInfo.adapterCounters.push_back(counters);
                         }
                         // 兼容旧字段，取第一个适配器
                         sysInfo.networkAdapterName = WinUtils::WstringToString(adapters[0].name);
@@ -1035,6 +1413,7 @@ int main(int argc, char* argv[]) {
                 } catch (const std::bad_alloc& e) {
                     Logger::Error("获取网络适配器信息失败 - 内存不足: " + std::string(e.what()));
                     sysInfo.adapters.clear();
+                    sysInfo.adapterCounters.clear();
                     sysInfo.networkAdapterName = "内存不足";
                     sysInfo.networkAdapterMac = "00-00-00-00-00-00";
                     sysInfo.networkAdapterIp = "N/A"; 
@@ -1043,6 +1422,7 @@ int main(int argc, char* argv[]) {
                 } catch (const std::exception& e) {
                     Logger::Error("获取网络适配器信息失败: " + std::string(e.what()));
                     sysInfo.adapters.clear();
+                    sysInfo.adapterCounters.clear();
                     sysInfo.networkAdapterName = "未检测到网络适配器";
                     sysInfo.networkAdapterMac = "00-00-00-00-00-00";
                     sysInfo.networkAdapterIp = "N/A"; // 添加默认IP地址
@@ -1051,6 +1431,7 @@ int main(int argc, char* argv[]) {
                 } catch (...) {
                     Logger::Error("获取网络适配器信息失败 - 未知异常");
                     sysInfo.adapters.clear();
+                    sysInfo.adapterCounters.clear();
                     sysInfo.networkAdapterName = "未知异常";
                     sysInfo.networkAdapterMac = "00-00-00-00-00-00";
                     sysInfo.networkAdapterIp = "N/A";
@@ -1058,30 +1439,99 @@ int main(int argc, char* argv[]) {
                     sysInfo.networkAdapterSpeed = 0;
                 }
 
-                // 添加温度数据采集（每次循环都获取以确保数据实时性）
+                // 套接字与连接统计
+                try {
+                    if (socketStats && socketStats->Update()) {
+                        const auto& summary = socketStats->GetSummary();
+                        SocketStatsData& dst = sysInfo.sockets;
+                        std::copy(std::begin(summary.tcpStates), std::end(summary.tcpStates), dst.tcpStates);
+                        dst.tcpSockets = summary.tcpSockets;
+                        dst.udpSockets = summary.udpSockets;
+                        dst.listenQueueFull = summary.listenQueueFull;
+                        dst.retransSegsPerSec = summary.retransSegsPerSec;
+                        dst.retransPercent = summary.retransPercent;
+                        dst.listenOverflowsPerSec = summary.listenOverflowsPerSec;
+                        dst.listenDropsPerSec = summary.listenDropsPerSec;
+                        dst.activeOpensPerSec = summary.activeOpensPerSec;
+                        dst.passiveOpensPerSec = summary.passiveOpensPerSec;
+                        dst.attemptFailsPerSec = summary.attemptFailsPerSec;
+                        dst.estabResetsPerSec = summary.estabResetsPerSec;
+                        dst.tcpInErrorsPerSec = summary.tcpInErrorsPerSec;
+                        dst.tcpOutResetsPerSec = summary.tcpOutResetsPerSec;
+                        dst.udpInDatagramsPerSec = summary.udpInDatagramsPerSec;
+                        dst.udpOutDatagramsPerSec = summary.udpOutDatagramsPerSec;
+                        dst.udpNoPortsPerSec = summary.udpNoPortsPerSec;
+                        dst.udpInErrorsPerSec = summary.udpInErrorsPerSec;
+                        dst.udpReceiveBufferErrorsPerSec = summary.udpReceiveBufferErrorsPerSec;
+                        dst.socketsValid = summary.socketsValid;
+                        dst.protocolValid = summary.protocolValid;
+
+                        for (const auto& process : socketStats->GetTopProcesses()) {
+                            SocketProcessData data{};
+                            data.pid = process.pid;
+                            data.tcpConnections = process.tcpConnections;
+                            data.udpSockets = process.udpSockets;
+                            wcsncpy_s(data.name, sizeof(data.name) / sizeof(wchar_t), WinUtils::Utf8ToWstring(process.name).c_str(), _TRUNCATE);
+                            sysInfo.socketProcesses.push_back(data);
+                        }
+                    }
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("获取套接字统计失败: " + std::string(e.what()));
+                    sysInfo.socketProcesses.clear();
+                }
+
+                // 传感器采样（每次循环都获取以确保数据实时性）：只刷新注册表中的读数，CPU/GPU 代表读数在注册时确定
                 try {
-                    auto temperatures = TemperatureWrapper::GetTemperatures();
                     sysInfo.temperatures.clear();
                     sysInfo.cpuTemperature = 0;
                     sysInfo.gpuTemperature = 0;
-                    for (const auto& temp : temperatures) {
-                        std::string nameLower = temp.first;
-                        std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-                        if (nameLower.find("gpu") != std::string::npos || nameLower.find("graphics") != std::string::npos) {
-                            sysInfo.gpuTemperature = temp.second;
-                            sysInfo.temperatures.push_back({"GPU", temp.second});
-                        } else if (nameLower.find("cpu") != std::string::npos || nameLower.find("package") != std::string::npos) {
-                            sysInfo.cpuTemperature = temp.second;
-                            sysInfo.temperatures.push_back({"CPU", temp.second});
-                        } else {
-                            sysInfo.temperatures.push_back(temp);
+                    SensorRegistry* registry = TemperatureWrapper::GetRegistry();
+                    if (registry) {
+                        if (registry->GetGeneration() != sensorGeneration) {
+                            BuildSensorInfos(*registry, sensorInfos, legacyTemperatures);
+                            cpuTemperatureSensor = registry->FindPrimary(HardwareCategory::Cpu, SensorKind::Temperature);
+                            gpuTemperatureSensor = registry->FindPrimary(HardwareCategory::Gpu, SensorKind::Temperature);
+                            cpuPowerSensor = registry->FindPrimary(HardwareCategory::Cpu, SensorKind::Power);
+                            sensorGeneration = registry->GetGeneration();
+
+                            registry->Unsubscribe(temperatureSubscription);
+                            registry->Unsubscribe(sensorSubscription);
+                            registry->Unsubscribe(throttleSubscription);
+                            throttleSubscription = registry->Subscribe({ cpuTemperatureSensor, cpuPowerSensor }, kThrottleIntervalMs);
+                            std::vector<SensorId> temperatureSensors;
+                            for (const auto& legacy : legacyTemperatures) temperatureSensors.push_back(legacy.first);
+                            temperatureSubscription = registry->Subscribe(temperatureSensors, kTemperatureSectionIntervalMs);
+                            // 共享内存只发布前 128 个传感器
+                            std::vector<SensorId> allSensors;
+                            for (SensorId id = 0; id < registry->Count() && id < 128; ++id) allSensors.push_back(id);
+                            sensorSubscription = registry->Subscribe(allSensors, kSensorSectionIntervalMs);
+                        }
+                        TemperatureWrapper::Sample();
+                        sysInfo.sensors = &sensorInfos;
+                        sysInfo.sensorGeneration = sensorGeneration;
+                        sysInfo.sensorValueGeneration = registry->GetValueGeneration();
+                        sysInfo.sensorValues.assign(registry->Values(), registry->Values() + registry->Count());
+
+                        if (cpuTemperatureSensor != SensorRegistry::kInvalidSensor && !std::isnan(registry->Value(cpuTemperatureSensor))) {
+                            sysInfo.cpuTemperature = registry->Value(cpuTemperatureSensor);
+                        }
+                        if (gpuTemperatureSensor != SensorRegistry::kInvalidSensor && !std::isnan(registry->Value(gpuTemperatureSensor))) {
+                            sysInfo.gpuTemperature = registry->Value(gpuTemperatureSensor);
+                        }
+                        // 兼容旧的温度区段（最多10个）
+                        for (const auto& legacy : legacyTemperatures) {
+                            double value = registry->Value(legacy.first);
+                            if (std::isnan(value)) continue;
+                            sysInfo.temperatures.push_back(legacy.second);
+                            sysInfo.temperatures.back().temperature = value;
                         }
                     }
                     if (isFirstRun) {
-                        Logger::Debug("收集到 " + std::to_string(temperatures.size()) + " 个温度读数");
+                        Logger::Debug("收集到 " + std::to_string(sysInfo.temperatures.size()) + " 个温度读数");
                         // 添加详细的温度传感器信息输出
                         for (const auto& temp : sysInfo.temperatures) {
-                            Logger::Debug("温度传感器: " + temp.first + " = " + std::to_string(temp.second) + "°C");
+                            Logger::Debug("温度传感器: " + WinUtils::WstringToUtf8(temp.sensorName) + " = " + std::to_string(temp.temperature) + "°C");
                         }
                         Logger::Debug("CPU温度: " + std::to_string(sysInfo.cpuTemperature) + ", GPU温度: " + std::to_string(sysInfo.gpuTemperature));
                     }
@@ -1107,6 +1557,45 @@ int main(int argc, char* argv[]) {
                     sysInfo.gpuTemperature = 0;
                 }
 
+                // 降频检测：依赖本周期的传感器读数与GPU遥测；共享内存事件区只在序号变化时重写
+                try {
+                    if (throttleDetector) {
+                        const SensorRegistry* registry = TemperatureWrapper::GetRegistry();
+                        const double unavailable = std::numeric_limits<double>::quiet_NaN();
+                        ThrottleDetector::CpuReadings readings{ unavailable, unavailable };
+                        if (registry && cpuTemperatureSensor != SensorRegistry::kInvalidSensor) readings.packageTemperature = registry->Value(cpuTemperatureSensor);
+                        if (registry && cpuPowerSensor != SensorRegistry::kInvalidSensor) readings.packagePowerWatts = registry->Value(cpuPowerSensor);
+                        throttleDetector->Update(readings, gpuService ? &gpuService->GetTelemetry().GetDevices() : nullptr);
+
+                        sysInfo.cpuThrottleReasons = throttleDetector->GetCpuReasons();
+                        if (throttleDetector->GetSequence() != throttleEventSequence) {
+                            throttleEventSequence = throttleDetector->GetSequence();
+                            throttleEvents.clear();
+                            for (const auto& event : throttleDetector->GetRing()) {
+                                ThrottleEventData data{};
+                                data.sequence = event.sequence;
+                                data.timestampMs = event.timestampMs;
+                                data.durationMs = event.durationMs;
+                                data.reasons = event.reasons;
+                                data.source = static_cast<uint8_t>(event.source);
+                                data.type = static_cast<uint8_t>(event.type);
+                                data.device = event.device;
+                                data.temperature = event.temperature;
+                                data.clockMHz = event.clockMHz;
+                                data.minClockMHz = event.minClockMHz;
+                                data.powerWatts = event.powerWatts;
+                                data.powerLimitWatts = event.powerLimitWatts;
+                                throttleEvents.push_back(data);
+                            }
+                        }
+                        sysInfo.throttleEventSequence = throttleEventSequence;
+                        sysInfo.throttleEvents = &throttleEvents;
+                    }
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("降频检测失败: " + std::string(e.what()));
+                }
+
                 // 添加磁盘信息采集（每次循环都获取以确保数据实时性）
                 try {
                     DiskInfo diskInfo;
@@ -1124,9 +1613,20 @@ int main(int argc, char* argv[]) {
                             }
                         }
                     }
-                    // 采集物理磁盘并建立逻辑盘映射
-                    if (wmiManager) {
-                        DiskInfo::CollectPhysicalDisks(*wmiManager, sysInfo.disks, sysInfo);
+                    // 磁盘拓扑有变更（热插拔）时重新打开 I/O 统计句柄，并立即采集新磁盘的 SMART
+                    bool topologyChanged = diskTopology && diskTopology->Refresh() && diskTopology->GetGeneration() > 1;
+                    if (topologyChanged && diskIoStats) {
+                        diskIoStats->Rescan();
+                    }
+                    if (topologyChanged && volumeInfo) {
+                        volumeInfo->Invalidate();
+                    }
+                    // 由拓扑缓存生成物理磁盘及逻辑盘映射，附加缓存的 SMART 数据（到期才真正访问设备）
+                    if (smartCollector && smartCollector->Refresh(topologyChanged)) {
+                        Logger::Debug("SMART数据已刷新，设备数: " + std::to_string(smartCollector->GetReports().size()));
+                    }
+                    if (diskTopology) {
+                        DiskInfo::CollectPhysicalDisks(*diskTopology, sysInfo, smartCollector.get(), diskHealthTracker.get());
                     }
                 }
                 catch (const std::bad_alloc& e) {
@@ -1145,6 +1645,78 @@ int main(int argc, char* argv[]) {
                     sysInfo.physicalDisks.clear();
                 }
 
+                // 块设备 I/O 速率
+                try {
+                    if (diskIoStats && diskIoStats->Update()) {
+                        const auto& devices = diskIoStats->GetDevices();
+                        sysInfo.diskIo.resize(devices.size());
+                        for (size_t i = 0; i < devices.size(); ++i) {
+                            const auto& src = devices[i];
+                            auto& dst = sysInfo.diskIo[i];
+                            wcsncpy_s(dst.name, sizeof(dst.name)/sizeof(wchar_t), WinUtils::StringToWstring(src.name).c_str(), _TRUNCATE);
+                            dst.readBytesPerSec = src.readBytesPerSec;
+                            dst.writeBytesPerSec = src.writeBytesPerSec;
+                            dst.readIops = src.readIops;
+                            dst.writeIops = src.writeIops;
+                            dst.avgReadAwaitMs = src.avgReadAwaitMs;
+                            dst.avgWriteAwaitMs = src.avgWriteAwaitMs;
+                            dst.avgAwaitMs = src.avgAwaitMs;
+                            dst.utilizationPercent = src.utilizationPercent;
+                            dst.avgQueueLength = src.avgQueueLength;
+                            dst.queueDepth = src.queueDepth;
+                        }
+                    }
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("获取块设备I/O统计失败: " + std::string(e.what()));
+                }
+
+                // 已挂载文件系统容量与 inode，以及按挂载点的填满时间预测
+                try {
+                    uint64_t now = CounterMath::MonotonicNowNs();
+                    if (volumeInfo && volumeInfo->Update()) {
+                        const auto& volumes = volumeInfo->GetVolumes();
+                        sysInfo.volumes.clear();
+                        for (const auto& src : volumes) {
+                            if (!src.valid) continue;
+                            VolumeData dst{};
+                            wcsncpy_s(dst.mountPoint, sizeof(dst.mountPoint)/sizeof(wchar_t), WinUtils::StringToWstring(src.mountPoint).c_str(), _TRUNCATE);
+                            wcsncpy_s(dst.device, sizeof(dst.device)/sizeof(wchar_t), WinUtils::StringToWstring(src.device).c_str(), _TRUNCATE);
+                            wcsncpy_s(dst.fileSystem, sizeof(dst.fileSystem)/sizeof(wchar_t), WinUtils::StringToWstring(src.fileSystem).c_str(), _TRUNCATE);
+                            wcsncpy_s(dst.label, sizeof(dst.label)/sizeof(wchar_t), WinUtils::StringToWstring(src.label).c_str(), _TRUNCATE);
+                            dst.totalBytes = src.totalBytes;
+                            dst.usedBytes = src.usedBytes;
+                            dst.freeBytes = src.freeBytes;
+                            dst.totalInodes = src.totalInodes;
+                            dst.usedInodes = src.usedInodes;
+                            dst.freeInodes = src.freeInodes;
+                            dst.readOnly = src.readOnly;
+                            // 以查询时间为样本时间，两次查询之间的重复样本会被忽略
+                            spaceForecaster.Observe(src.mountPoint, src.usedBytes, src.freeBytes, src.sampledNs);
+                            dst.forecast = ToForecastData(spaceForecaster.Get(src.mountPoint));
+                            sysInfo.volumes.push_back(dst);
+                        }
+                    }
+                    // 旧的盘符列表与卷共用同一份状态（键为 "C:\\"）；每个键只由一个来源提供样本：
+                    // 卷枚举中已有该盘符时沿用卷的样本（带查询时间），否则才用盘符列表的本周期数据
+                    for (auto& disk : sysInfo.disks) {
+                        std::string key = std::string(1, disk.letter) + ":\\";
+                        bool fromVolume = false;
+                        if (volumeInfo) {
+                            for (const auto& volume : volumeInfo->GetVolumes()) {
+                                if (volume.mountPoint == key) { fromVolume = true; break; }
+                            }
+                        }
+                        if (!fromVolume) spaceForecaster.Observe(key, disk.usedSpace, disk.freeSpace, now);
+                        disk.forecast = ToForecastData(spaceForecaster.Get(key));
+                    }
+                    spaceForecaster.Sweep(now);
+                }
+                catch (const std::exception& e) {
+                    Logger::Error("获取卷信息失败: " + std::string(e.what()));
+                    sysInfo.volumes.clear();
+                }
+
                 // 写入共享内存前验证数据 - 增强数据验证
                 try {
                     // CPU使用率验证